@@ -0,0 +1,878 @@
+#include "ContentEncoding.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+	constexpr uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	constexpr uint8_t lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	constexpr uint16_t distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	constexpr uint8_t distanceExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	constexpr uint8_t codeLengthOrder[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	constexpr size_t windowSize = 32768;
+	constexpr size_t windowMask = windowSize - 1;
+
+	const std::array<uint32_t, 256>& CrcTable()
+	{
+		static const std::array<uint32_t, 256> table = [] {
+			std::array<uint32_t, 256> built{};
+			for (uint32_t n = 0; n < 256; n++) {
+				uint32_t c = n;
+				for (int k = 0; k < 8; k++) {
+					c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+				}
+				built[n] = c;
+			}
+			return built;
+		}();
+		return table;
+	}
+
+	uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size)
+	{
+		const auto& table = CrcTable();
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++) {
+			crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+	void Adler32(uint32_t& a, uint32_t& b, const uint8_t* data, size_t size)
+	{
+		// 5552 bytes is the most that can be summed before b could overflow
+		while (size > 0) {
+			size_t run = std::min<size_t>(size, 5552);
+			for (size_t i = 0; i < run; i++) {
+				a += data[i];
+				b += a;
+			}
+			a %= 65521;
+			b %= 65521;
+			data += run;
+			size -= run;
+		}
+	}
+
+	std::string_view Trim(std::string_view text)
+	{
+		while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+			text.remove_prefix(1);
+		}
+		while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+			text.remove_suffix(1);
+		}
+		return text;
+	}
+
+	bool EqualsNoCase(std::string_view a, std::string_view b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+			[](char x, char y) { return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y)); });
+	}
+
+	// Writes deflate's LSB-first bit stream
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(std::string& out) : out(out) {}
+
+		void Put(uint32_t value, int count)
+		{
+			buffer |= static_cast<uint64_t>(value) << pending;
+			pending += count;
+			while (pending >= 8) {
+				out.push_back(static_cast<char>(buffer & 0xff));
+				buffer >>= 8;
+				pending -= 8;
+			}
+		}
+
+		void Flush()
+		{
+			if (pending > 0) {
+				out.push_back(static_cast<char>(buffer & 0xff));
+			}
+			buffer = 0;
+			pending = 0;
+		}
+
+	private:
+		std::string& out;
+		uint64_t buffer = 0;
+		int pending = 0;
+	};
+
+	// Fixed literal/length codes (RFC 1951 3.2.6), bit-reversed ready for BitWriter
+	struct FixedCode {
+		uint16_t code;
+		uint8_t length;
+	};
+
+	uint16_t Reverse(uint32_t code, int length)
+	{
+		uint32_t reversed = 0;
+		for (int i = 0; i < length; i++) {
+			reversed = (reversed << 1) | ((code >> i) & 1);
+		}
+		return static_cast<uint16_t>(reversed);
+	}
+
+	const std::array<FixedCode, 288>& FixedLiteralCodes()
+	{
+		static const std::array<FixedCode, 288> codes = [] {
+			std::array<FixedCode, 288> built{};
+			for (uint32_t symbol = 0; symbol < 288; symbol++) {
+				uint32_t code;
+				int length;
+				if (symbol < 144) { code = 0x30 + symbol; length = 8; }
+				else if (symbol < 256) { code = 0x190 + symbol - 144; length = 9; }
+				else if (symbol < 280) { code = symbol - 256; length = 7; }
+				else { code = 0xc0 + symbol - 280; length = 8; }
+				built[symbol] = FixedCode{ Reverse(code, length), static_cast<uint8_t>(length) };
+			}
+			return built;
+		}();
+		return codes;
+	}
+
+	// Length 3..258 to its length code index
+	const std::array<uint8_t, 259>& LengthCodes()
+	{
+		static const std::array<uint8_t, 259> codes = [] {
+			std::array<uint8_t, 259> built{};
+			for (int code = 0; code < 29; code++) {
+				int last = code + 1 < 29 ? lengthBase[code + 1] : 259;
+				for (int length = lengthBase[code]; length < last && length <= 258; length++) {
+					built[length] = static_cast<uint8_t>(code);
+				}
+			}
+			return built;
+		}();
+		return codes;
+	}
+
+	int DistanceCode(size_t distance)
+	{
+		int code = 29;
+		while (distanceBase[code] > distance) {
+			code--;
+		}
+		return code;
+	}
+
+	// Greedy LZ77 over hash chains, one final block with the fixed codes. The
+	// HTML in a FlareSolverr reply is repetitive enough that matches do most of
+	// the work, dynamic tables would buy another 15 to 20% at twice the code.
+	void Deflate(std::string_view body, std::string& out)
+	{
+		constexpr int hashBits = 15;
+		constexpr int maxChain = 32;
+		constexpr size_t minMatch = 3;
+		constexpr size_t maxMatch = 258;
+
+		const auto* data = reinterpret_cast<const uint8_t*>(body.data());
+		const size_t size = body.size();
+		const auto& literals = FixedLiteralCodes();
+		const auto& lengthCodes = LengthCodes();
+
+		std::vector<int32_t> head(size_t(1) << hashBits, -1);
+		std::vector<int32_t> previous(windowSize, -1);
+		auto hash = [data](size_t i) {
+			uint32_t key = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16);
+			return (key * 2654435761u) >> (32 - hashBits);
+		};
+		auto insert = [&](size_t i) {
+			uint32_t h = hash(i);
+			previous[i & windowMask] = head[h];
+			head[h] = static_cast<int32_t>(i);
+		};
+
+		BitWriter writer(out);
+		writer.Put(1, 1); // final block
+		writer.Put(1, 2); // fixed codes
+
+		size_t i = 0;
+		while (i < size) {
+			size_t best = 0;
+			size_t bestDistance = 0;
+			if (i + minMatch <= size) {
+				size_t limit = std::min(maxMatch, size - i);
+				int32_t candidate = head[hash(i)];
+				for (int chain = 0; candidate >= 0 && i - candidate <= windowSize && chain < maxChain; chain++) {
+					const uint8_t* match = data + candidate;
+					if (match[best] == data[i + best]) {
+						size_t length = 0;
+						while (length < limit && match[length] == data[i + length]) {
+							length++;
+						}
+						if (length > best) {
+							best = length;
+							bestDistance = i - candidate;
+							if (length == limit) {
+								break;
+							}
+						}
+					}
+					candidate = previous[candidate & windowMask];
+				}
+				insert(i);
+			}
+
+			if (best >= minMatch) {
+				int code = lengthCodes[best];
+				const FixedCode& lengthCode = literals[257 + code];
+				writer.Put(lengthCode.code, lengthCode.length);
+				writer.Put(static_cast<uint32_t>(best - lengthBase[code]), lengthExtra[code]);
+				int distance = DistanceCode(bestDistance);
+				writer.Put(Reverse(distance, 5), 5);
+				writer.Put(static_cast<uint32_t>(bestDistance - distanceBase[distance]), distanceExtra[distance]);
+				for (size_t j = 1; j < best; j++) {
+					if (i + j + minMatch <= size) {
+						insert(i + j);
+					}
+				}
+				i += best;
+			}
+			else {
+				const FixedCode& literal = literals[data[i]];
+				writer.Put(literal.code, literal.length);
+				i++;
+			}
+		}
+		writer.Put(literals[256].code, literals[256].length);
+		writer.Flush();
+	}
+
+	void PutLittleEndian(std::string& out, uint32_t value)
+	{
+		for (int i = 0; i < 4; i++) {
+			out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+		}
+	}
+}
+
+std::string_view ContentEncodingName(ContentEncoding encoding)
+{
+	switch (encoding) {
+	case ContentEncoding::Gzip:
+		return "gzip";
+	case ContentEncoding::Deflate:
+		return "deflate";
+	default:
+		return std::string_view();
+	}
+}
+
+ContentEncoding ParseContentEncoding(std::string_view header)
+{
+	header = Trim(header);
+	if (EqualsNoCase(header, "gzip") || EqualsNoCase(header, "x-gzip")) {
+		return ContentEncoding::Gzip;
+	}
+	if (EqualsNoCase(header, "deflate")) {
+		return ContentEncoding::Deflate;
+	}
+	return ContentEncoding::Identity;
+}
+
+ContentEncoding ChooseContentEncoding(std::string_view acceptEncoding)
+{
+	bool gzip = false;
+	bool deflate = false;
+	bool any = false;
+	while (!acceptEncoding.empty()) {
+		size_t comma = acceptEncoding.find(',');
+		std::string_view item = acceptEncoding.substr(0, comma);
+		acceptEncoding = comma == std::string_view::npos ? std::string_view() : acceptEncoding.substr(comma + 1);
+
+		// "gzip;q=0.8"
+		size_t semicolon = item.find(';');
+		std::string_view name = Trim(item.substr(0, semicolon));
+		bool allowed = true;
+		if (semicolon != std::string_view::npos) {
+			std::string_view parameter = Trim(item.substr(semicolon + 1));
+			if (parameter.size() > 2 && (parameter[0] == 'q' || parameter[0] == 'Q') && parameter[1] == '=') {
+				allowed = std::strtod(std::string(parameter.substr(2)).c_str(), nullptr) > 0.0;
+			}
+		}
+		if (EqualsNoCase(name, "gzip") || EqualsNoCase(name, "x-gzip")) {
+			gzip = allowed;
+		}
+		else if (EqualsNoCase(name, "deflate")) {
+			deflate = allowed;
+		}
+		else if (name == "*") {
+			any = allowed;
+		}
+	}
+	if (gzip || any) {
+		return ContentEncoding::Gzip;
+	}
+	return deflate ? ContentEncoding::Deflate : ContentEncoding::Identity;
+}
+
+ContentEncoding SniffContentEncoding(std::string_view body)
+{
+	if (body.size() < 2) {
+		return ContentEncoding::Identity;
+	}
+	auto first = static_cast<uint8_t>(body[0]);
+	auto second = static_cast<uint8_t>(body[1]);
+	if (first == 0x1f && second == 0x8b) {
+		return ContentEncoding::Gzip;
+	}
+	// JSON and HTML never start with 0x78 ('x') followed by a byte that makes the pair a multiple of 31
+	if ((first & 0x0f) == 8 && (first >> 4) <= 7 && (first * 256 + second) % 31 == 0) {
+		return ContentEncoding::Deflate;
+	}
+	return ContentEncoding::Identity;
+}
+
+std::string EncodeContent(std::string_view body, ContentEncoding encoding)
+{
+	std::string out;
+	const auto* data = reinterpret_cast<const uint8_t*>(body.data());
+	switch (encoding) {
+	case ContentEncoding::Gzip:
+		out.reserve(body.size() / 3 + 32);
+		// No name or timestamp, OS unknown
+		out.append("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+		Deflate(body, out);
+		PutLittleEndian(out, Crc32(0, data, body.size()));
+		PutLittleEndian(out, static_cast<uint32_t>(body.size()));
+		return out;
+	case ContentEncoding::Deflate: {
+		out.reserve(body.size() / 3 + 16);
+		out.append("\x78\x01", 2);
+		Deflate(body, out);
+		uint32_t a = 1;
+		uint32_t b = 0;
+		Adler32(a, b, data, body.size());
+		uint32_t adler = (b << 16) | a;
+		for (int shift = 24; shift >= 0; shift -= 8) {
+			out.push_back(static_cast<char>((adler >> shift) & 0xff));
+		}
+		return out;
+	}
+	default:
+		return std::string(body);
+	}
+}
+
+ContentDecoder::ContentDecoder(ContentEncoding encoding)
+	: encoding(encoding)
+{
+	if (encoding != ContentEncoding::Identity) {
+		window.resize(windowSize);
+	}
+}
+
+ContentDecoder::Status ContentDecoder::Feed(std::string_view data, std::string& output)
+{
+	if (status != Status::NeedMore) {
+		return status;
+	}
+	if (encoding == ContentEncoding::Identity) {
+		output.append(data);
+		return status;
+	}
+
+	input.append(data);
+	summedFrom = output.size();
+	bool progress = true;
+	while (progress && status == Status::NeedMore) {
+		Mark mark = Save();
+		switch (stage) {
+		case Stage::Header:
+			progress = ReadHeader();
+			break;
+		case Stage::BlockHeader:
+			progress = ReadBlockHeader();
+			break;
+		case Stage::Stored:
+			// Stored bytes and symbols are committed one at a time, no rollback
+			progress = CopyStored(output);
+			mark = Save();
+			break;
+		case Stage::Codes:
+			progress = InflateCodes(output);
+			mark = Save();
+			break;
+		case Stage::Trailer:
+			progress = ReadTrailer(output);
+			break;
+		case Stage::Finished:
+			status = Status::Done;
+			break;
+		}
+		if (!progress && status == Status::NeedMore) {
+			Restore(mark);
+		}
+	}
+	UpdateChecksums(output);
+
+	// Only the bytes of an unfinished step stay behind
+	input.erase(0, position);
+	position = 0;
+	return status;
+}
+
+ContentDecoder::Status ContentDecoder::Fail(std::string message)
+{
+	status = Status::Error;
+	error = std::move(message);
+	return status;
+}
+
+void ContentDecoder::Restore(const Mark& mark)
+{
+	position = mark.position;
+	bits = mark.bits;
+	bitCount = mark.bitCount;
+}
+
+bool ContentDecoder::Need(int count)
+{
+	while (bitCount < count) {
+		if (position >= input.size()) {
+			return false;
+		}
+		bits |= static_cast<uint64_t>(static_cast<uint8_t>(input[position++])) << bitCount;
+		bitCount += 8;
+	}
+	return true;
+}
+
+uint32_t ContentDecoder::Take(int count)
+{
+	auto value = static_cast<uint32_t>(bits & ((uint64_t(1) << count) - 1));
+	bits >>= count;
+	bitCount -= count;
+	return value;
+}
+
+void ContentDecoder::AlignToByte()
+{
+	Take(bitCount % 8);
+}
+
+int ContentDecoder::Decode(const Huffman& table)
+{
+	// Canonical codes, one bit at a time (the approach of zlib's puff)
+	int code = 0;
+	int first = 0;
+	int index = 0;
+	for (int length = 1; length < 16; length++) {
+		if (!Need(1)) {
+			return -1;
+		}
+		code |= static_cast<int>(Take(1));
+		int count = table.count[length];
+		if (code - count < first) {
+			return table.symbol[index + (code - first)];
+		}
+		index += count;
+		first += count;
+		first <<= 1;
+		code <<= 1;
+	}
+	return -2;
+}
+
+bool ContentDecoder::Build(Huffman& table, const uint8_t* lengths, int count)
+{
+	std::fill(std::begin(table.count), std::end(table.count), uint16_t(0));
+	for (int symbol = 0; symbol < count; symbol++) {
+		table.count[lengths[symbol]]++;
+	}
+	if (table.count[0] == count) {
+		// No codes at all, valid for a distance table of a block without matches
+		table.symbol.clear();
+		return true;
+	}
+	int left = 1;
+	for (int length = 1; length < 16; length++) {
+		left <<= 1;
+		left -= table.count[length];
+		if (left < 0) {
+			return false; // over-subscribed
+		}
+	}
+
+	uint16_t offsets[16] = {};
+	for (int length = 1; length < 15; length++) {
+		offsets[length + 1] = offsets[length] + table.count[length];
+	}
+	table.symbol.assign(count, 0);
+	for (int symbol = 0; symbol < count; symbol++) {
+		if (lengths[symbol] != 0) {
+			table.symbol[offsets[lengths[symbol]]++] = static_cast<uint16_t>(symbol);
+		}
+	}
+	return true;
+}
+
+bool ContentDecoder::ReadHeader()
+{
+	if (encoding == ContentEncoding::Deflate) {
+		if (!Need(16)) {
+			return false;
+		}
+		uint32_t cmf = bits & 0xff;
+		uint32_t flags = (bits >> 8) & 0xff;
+		if ((cmf & 0x0f) == 8 && (cmf >> 4) <= 7 && (cmf * 256 + flags) % 31 == 0) {
+			if (flags & 0x20) {
+				Fail("deflate stream needs a preset dictionary");
+				return false;
+			}
+			Take(16);
+			zlib = true;
+		}
+		// Otherwise raw deflate, the bits stay for the first block header
+		stage = Stage::BlockHeader;
+		return true;
+	}
+
+	if (!Need(32)) {
+		return false;
+	}
+	uint32_t magic = Take(16);
+	uint32_t method = Take(8);
+	uint32_t flags = Take(8);
+	if (magic != 0x8b1f || method != 8) {
+		Fail("not a gzip stream");
+		return false;
+	}
+	// Modification time, extra flags and OS
+	for (int i = 0; i < 6; i++) {
+		if (!Need(8)) {
+			return false;
+		}
+		Take(8);
+	}
+	if (flags & 0x04) {
+		if (!Need(16)) {
+			return false;
+		}
+		uint32_t extraLength = Take(16);
+		for (uint32_t i = 0; i < extraLength; i++) {
+			if (!Need(8)) {
+				return false;
+			}
+			Take(8);
+		}
+	}
+	// File name, then comment, both zero-terminated
+	for (uint32_t flag : { 0x08u, 0x10u }) {
+		if (flags & flag) {
+			do {
+				if (!Need(8)) {
+					return false;
+				}
+			} while (Take(8) != 0);
+		}
+	}
+	if (flags & 0x02) {
+		if (!Need(16)) {
+			return false;
+		}
+		Take(16);
+	}
+	gzip = true;
+	stage = Stage::BlockHeader;
+	return true;
+}
+
+bool ContentDecoder::ReadBlockHeader()
+{
+	if (!Need(3)) {
+		return false;
+	}
+	finalBlock = Take(1) != 0;
+	switch (Take(2)) {
+	case 0: {
+		AlignToByte();
+		if (!Need(32)) {
+			return false;
+		}
+		uint32_t length = Take(16);
+		uint32_t complement = Take(16);
+		if (length != (~complement & 0xffff)) {
+			Fail("stored block length does not match its complement");
+			return false;
+		}
+		storedLeft = length;
+		stage = Stage::Stored;
+		return true;
+	}
+	case 1: {
+		static const std::pair<Huffman, Huffman> fixed = [] {
+			std::pair<Huffman, Huffman> built;
+			uint8_t lengths[288];
+			std::fill(lengths, lengths + 144, uint8_t(8));
+			std::fill(lengths + 144, lengths + 256, uint8_t(9));
+			std::fill(lengths + 256, lengths + 280, uint8_t(7));
+			std::fill(lengths + 280, lengths + 288, uint8_t(8));
+			Build(built.first, lengths, 288);
+			std::fill(lengths, lengths + 30, uint8_t(5));
+			Build(built.second, lengths, 30);
+			return built;
+		}();
+		lengthCodes = fixed.first;
+		distanceCodes = fixed.second;
+		stage = Stage::Codes;
+		return true;
+	}
+	case 2:
+		return ReadDynamicTables();
+	default:
+		Fail("invalid deflate block type");
+		return false;
+	}
+}
+
+bool ContentDecoder::ReadDynamicTables()
+{
+	if (!Need(14)) {
+		return false;
+	}
+	int lengthCount = static_cast<int>(Take(5)) + 257;
+	int distanceCount = static_cast<int>(Take(5)) + 1;
+	int codeCount = static_cast<int>(Take(4)) + 4;
+	if (lengthCount > 286 || distanceCount > 30) {
+		Fail("too many length or distance codes");
+		return false;
+	}
+
+	uint8_t lengths[286 + 30] = {};
+	for (int i = 0; i < codeCount; i++) {
+		if (!Need(3)) {
+			return false;
+		}
+		lengths[codeLengthOrder[i]] = static_cast<uint8_t>(Take(3));
+	}
+	Huffman codeLengths;
+	if (!Build(codeLengths, lengths, 19)) {
+		Fail("invalid code length codes");
+		return false;
+	}
+
+	std::fill(std::begin(lengths), std::end(lengths), uint8_t(0));
+	int index = 0;
+	while (index < lengthCount + distanceCount) {
+		int symbol = Decode(codeLengths);
+		if (symbol == -1) {
+			return false;
+		}
+		if (symbol < 0) {
+			Fail("invalid code length code");
+			return false;
+		}
+		if (symbol < 16) {
+			lengths[index++] = static_cast<uint8_t>(symbol);
+			continue;
+		}
+
+		uint8_t repeated = 0;
+		int repeat;
+		if (symbol == 16) {
+			if (index == 0) {
+				Fail("repeat with no previous length");
+				return false;
+			}
+			repeated = lengths[index - 1];
+			if (!Need(2)) {
+				return false;
+			}
+			repeat = 3 + static_cast<int>(Take(2));
+		}
+		else if (symbol == 17) {
+			if (!Need(3)) {
+				return false;
+			}
+			repeat = 3 + static_cast<int>(Take(3));
+		}
+		else {
+			if (!Need(7)) {
+				return false;
+			}
+			repeat = 11 + static_cast<int>(Take(7));
+		}
+		if (index + repeat > lengthCount + distanceCount) {
+			Fail("code lengths run past the table");
+			return false;
+		}
+		std::fill(lengths + index, lengths + index + repeat, repeated);
+		index += repeat;
+	}
+
+	if (lengths[256] == 0) {
+		Fail("block has no end code");
+		return false;
+	}
+	if (!Build(lengthCodes, lengths, lengthCount) || !Build(distanceCodes, lengths + lengthCount, distanceCount)) {
+		Fail("invalid literal/length or distance code lengths");
+		return false;
+	}
+	stage = Stage::Codes;
+	return true;
+}
+
+bool ContentDecoder::CopyStored(std::string& output)
+{
+	while (storedLeft > 0) {
+		if (bitCount >= 8) {
+			Emit(static_cast<uint8_t>(Take(8)), output);
+		}
+		else if (position < input.size()) {
+			Emit(static_cast<uint8_t>(input[position++]), output);
+		}
+		else {
+			return false;
+		}
+		storedLeft--;
+		if (status != Status::NeedMore) {
+			return false;
+		}
+	}
+	stage = finalBlock ? Stage::Trailer : Stage::BlockHeader;
+	return true;
+}
+
+bool ContentDecoder::InflateCodes(std::string& output)
+{
+	for (;;) {
+		Mark mark = Save();
+		int symbol = Decode(lengthCodes);
+		if (symbol == -1) {
+			Restore(mark);
+			return false;
+		}
+		if (symbol < 0) {
+			Fail("invalid literal/length code");
+			return false;
+		}
+		if (symbol < 256) {
+			Emit(static_cast<uint8_t>(symbol), output);
+			if (status != Status::NeedMore) {
+				return false;
+			}
+			continue;
+		}
+		if (symbol == 256) {
+			stage = finalBlock ? Stage::Trailer : Stage::BlockHeader;
+			return true;
+		}
+
+		symbol -= 257;
+		if (symbol >= 29) {
+			Fail("invalid length code");
+			return false;
+		}
+		if (!Need(lengthExtra[symbol])) {
+			Restore(mark);
+			return false;
+		}
+		size_t length = lengthBase[symbol] + Take(lengthExtra[symbol]);
+
+		int code = Decode(distanceCodes);
+		if (code == -1) {
+			Restore(mark);
+			return false;
+		}
+		if (code < 0 || code >= 30) {
+			Fail("invalid distance code");
+			return false;
+		}
+		if (!Need(distanceExtra[code])) {
+			Restore(mark);
+			return false;
+		}
+		size_t distance = distanceBase[code] + Take(distanceExtra[code]);
+		if (distance > written) {
+			Fail("distance reaches before the start of the data");
+			return false;
+		}
+		for (size_t i = 0; i < length; i++) {
+			Emit(window[(written - distance) & windowMask], output);
+		}
+		if (status != Status::NeedMore) {
+			return false;
+		}
+	}
+}
+
+bool ContentDecoder::ReadTrailer(std::string& output)
+{
+	AlignToByte();
+	UpdateChecksums(output);
+	if (gzip) {
+		if (!Need(32)) {
+			return false;
+		}
+		uint32_t expectedCrc = Take(32);
+		if (!Need(32)) {
+			return false;
+		}
+		uint32_t expectedSize = Take(32);
+		if (expectedCrc != crc || expectedSize != static_cast<uint32_t>(written)) {
+			Fail("gzip checksum mismatch");
+			return false;
+		}
+	}
+	else if (zlib) {
+		uint32_t expected = 0;
+		for (int i = 0; i < 4; i++) {
+			if (!Need(8)) {
+				return false;
+			}
+			expected = (expected << 8) | Take(8);
+		}
+		if (expected != ((adlerB << 16) | adlerA)) {
+			Fail("deflate checksum mismatch");
+			return false;
+		}
+	}
+	stage = Stage::Finished;
+	return true;
+}
+
+void ContentDecoder::Emit(uint8_t byte, std::string& output)
+{
+	if (written >= maxOutputBytes) {
+		Fail("decoded body is larger than " + std::to_string(maxOutputBytes) + " bytes");
+		return;
+	}
+	output.push_back(static_cast<char>(byte));
+	window[written & windowMask] = byte;
+	written++;
+}
+
+void ContentDecoder::UpdateChecksums(const std::string& output)
+{
+	const auto* data = reinterpret_cast<const uint8_t*>(output.data()) + summedFrom;
+	size_t size = output.size() - summedFrom;
+	if (gzip) {
+		crc = Crc32(crc, data, size);
+	}
+	else if (zlib) {
+		Adler32(adlerA, adlerB, data, size);
+	}
+	summedFrom = output.size();
+}
+
+bool DecodeContent(std::string_view body, ContentEncoding encoding, std::string& output)
+{
+	output.clear();
+	ContentDecoder decoder(encoding);
+	ContentDecoder::Status status = decoder.Feed(body, output);
+	if (status == ContentDecoder::Status::Done || (status == ContentDecoder::Status::NeedMore && encoding == ContentEncoding::Identity)) {
+		return true;
+	}
+	output = status == ContentDecoder::Status::Error ? decoder.ErrorText() : "compressed body is cut off";
+	return false;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// HTTP content codings for bodies between the plugin, the daemon and the
+// caching proxy. Self-contained deflate (RFC 1951) with the gzip (RFC 1952) and
+// zlib (RFC 1950, what HTTP calls "deflate") wrappers, no zlib dependency.
+enum class ContentEncoding {
+	Identity,
+	Gzip,
+	Deflate,
+};
+
+// Value for Accept-Encoding on requests we can decode
+constexpr std::string_view acceptEncodingHeader = "gzip, deflate";
+
+// Name for Content-Encoding, empty for Identity
+std::string_view ContentEncodingName(ContentEncoding encoding);
+// From a Content-Encoding value, Identity for anything we cannot decode
+ContentEncoding ParseContentEncoding(std::string_view header);
+// Best coding an Accept-Encoding value allows, gzip over deflate, q=0 honoured
+ContentEncoding ChooseContentEncoding(std::string_view acceptEncoding);
+// Recognizes gzip and zlib by their headers, for transports that hide Content-Encoding
+ContentEncoding SniffContentEncoding(std::string_view body);
+
+// One-shot compression, LZ77 with the fixed Huffman codes
+std::string EncodeContent(std::string_view body, ContentEncoding encoding);
+
+// Decodes a body while it arrives: each Feed appends whatever the new bytes
+// complete to output, so only a symbol's worth of compressed input (or a block
+// header) is ever held back. Deflate also accepts the raw deflate some servers
+// send under that name.
+class ContentDecoder
+{
+public:
+	enum class Status {
+		NeedMore,
+		Done,
+		Error,
+	};
+
+	explicit ContentDecoder(ContentEncoding encoding);
+
+	Status Feed(std::string_view input, std::string& output);
+	Status State() const { return status; }
+	const std::string& ErrorText() const { return error; }
+
+	// Decoded output stops with an error past this many bytes
+	size_t maxOutputBytes = 64 * 1024 * 1024;
+
+private:
+	enum class Stage {
+		Header,
+		BlockHeader,
+		Stored,
+		Codes,
+		Trailer,
+		Finished,
+	};
+
+	struct Huffman {
+		uint16_t count[16] = {};
+		std::vector<uint16_t> symbol;
+	};
+
+	// Each step either completes or rolls back to where it began and waits for more input
+	struct Mark {
+		size_t position;
+		uint64_t bits;
+		int bitCount;
+	};
+
+	Status Fail(std::string message);
+	Mark Save() const { return Mark{ position, bits, bitCount }; }
+	void Restore(const Mark& mark);
+	bool Need(int count);
+	uint32_t Take(int count);
+	void AlignToByte();
+	// -1 when more input is needed, -2 on an invalid code
+	int Decode(const Huffman& table);
+	static bool Build(Huffman& table, const uint8_t* lengths, int count);
+
+	bool ReadHeader();
+	bool ReadBlockHeader();
+	bool ReadDynamicTables();
+	bool CopyStored(std::string& output);
+	bool InflateCodes(std::string& output);
+	bool ReadTrailer(std::string& output);
+	void Emit(uint8_t byte, std::string& output);
+	// Checksums cover output from summedFrom on, caught up before the trailer is checked
+	void UpdateChecksums(const std::string& output);
+
+	ContentEncoding encoding;
+	Stage stage = Stage::Header;
+	Status status = Status::NeedMore;
+	std::string error;
+
+	std::string input;
+	size_t position = 0;
+	uint64_t bits = 0;
+	int bitCount = 0;
+
+	bool gzip = false;
+	bool zlib = false;
+	bool finalBlock = false;
+	uint32_t storedLeft = 0;
+	Huffman lengthCodes;
+	Huffman distanceCodes;
+
+	std::vector<uint8_t> window;
+	size_t written = 0;
+	size_t summedFrom = 0;
+	uint32_t crc = 0;
+	uint32_t adlerA = 1;
+	uint32_t adlerB = 0;
+};
+
+// Whole-body convenience over ContentDecoder, false with the reason in output on failure
+bool DecodeContent(std::string_view body, ContentEncoding encoding, std::string& output);
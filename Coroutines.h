@@ -0,0 +1,88 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "StatsProvider.h"
+#include "WorkerPool.h"
+
+// Fire-and-forget coroutine: runs eagerly until its first suspension and frees
+// its frame when it finishes. Bodies are expected to catch their own exceptions.
+struct DetachedTask {
+	struct promise_type {
+		DetachedTask get_return_object() noexcept { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() noexcept {}
+		void unhandled_exception() noexcept { std::terminate(); }
+	};
+};
+
+struct FetchResponse {
+	std::shared_ptr<StatsProvider> provider; // null when no provider is configured
+	int code = 0;
+	std::string body;
+};
+
+// co_await FetchAsync(...) runs a HedgedFetch and resumes with the winning answer
+class FetchAsync
+{
+public:
+	FetchAsync(std::vector<std::shared_ptr<StatsProvider>> chain, ProviderHost& host, ProviderRequest request, bool hedge)
+		: chain(std::move(chain)), host(host), request(std::move(request)), hedge(hedge) {}
+
+	bool await_ready() const noexcept { return false; }
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		HedgedFetch(chain, host, request, hedge, [this, handle](std::shared_ptr<StatsProvider> provider, int code, std::string body) {
+			response = FetchResponse{ std::move(provider), code, std::move(body) };
+			handle.resume();
+			});
+	}
+	FetchResponse await_resume() { return std::move(response); }
+
+private:
+	std::vector<std::shared_ptr<StatsProvider>> chain;
+	ProviderHost& host;
+	ProviderRequest request;
+	bool hedge;
+	FetchResponse response;
+};
+
+// co_await Delay(host, seconds) resumes on the host's timer (the game thread in the plugin)
+class Delay
+{
+public:
+	Delay(ProviderHost& host, float seconds) : host(host), seconds(seconds) {}
+
+	bool await_ready() const noexcept { return seconds <= 0.0f; }
+	void await_suspend(std::coroutine_handle<> handle)
+	{
+		host.SetTimeout([handle]() { handle.resume(); }, seconds);
+	}
+	void await_resume() noexcept {}
+
+private:
+	ProviderHost& host;
+	float seconds;
+};
+
+// co_await ResumeOnPool(pool) continues on a worker, or inline if the pool is shutting down
+class ResumeOnPool
+{
+public:
+	explicit ResumeOnPool(WorkerPool& pool) : pool(pool) {}
+
+	bool await_ready() const noexcept { return false; }
+	bool await_suspend(std::coroutine_handle<> handle)
+	{
+		return pool.Submit([handle]() { handle.resume(); });
+	}
+	void await_resume() noexcept {}
+
+private:
+	WorkerPool& pool;
+};
@@ -0,0 +1,178 @@
+#include "EndpointBalancer.h"
+
+#include <algorithm>
+
+EndpointBalancer::EndpointBalancer(size_t endpointCount, size_t perEndpointLimit)
+	: endpoints(endpointCount), limit(std::max<size_t>(perEndpointLimit, 1))
+{
+}
+
+void EndpointBalancer::Acquire(Dispatch dispatch)
+{
+	size_t endpoint;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		endpoint = PickLocked(true);
+		if (endpoint == endpoints.size()) {
+			waiting.push_back(std::move(dispatch));
+			return;
+		}
+		endpoints[endpoint].outstanding++;
+	}
+	dispatch(endpoint);
+}
+
+void EndpointBalancer::Release(size_t endpoint)
+{
+	Dispatch next;
+	size_t nextEndpoint;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (endpoint < endpoints.size() && endpoints[endpoint].outstanding > 0) {
+			endpoints[endpoint].outstanding--;
+		}
+		if (waiting.empty()) {
+			return;
+		}
+		nextEndpoint = PickLocked(true);
+		if (nextEndpoint == endpoints.size()) {
+			return;
+		}
+		endpoints[nextEndpoint].outstanding++;
+		next = std::move(waiting.front());
+		waiting.pop_front();
+	}
+	next(nextEndpoint);
+}
+
+bool EndpointBalancer::ReportProbe(size_t endpoint, bool ok, std::chrono::milliseconds latency)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return ReportLocked(endpoint, ok, 1, latency);
+}
+
+bool EndpointBalancer::ReportRequest(size_t endpoint, bool ok)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return ReportLocked(endpoint, ok, failuresToEject, std::nullopt);
+}
+
+bool EndpointBalancer::ReportLocked(size_t endpoint, bool ok, size_t failuresAllowed, std::optional<std::chrono::milliseconds> latency)
+{
+	if (endpoint >= endpoints.size()) {
+		return false;
+	}
+	EndpointStatus& status = endpoints[endpoint];
+	bool wasHealthy = status.healthy;
+	status.checked = true;
+	if (ok) {
+		status.consecutiveFailures = 0;
+		status.healthy = true;
+		if (latency) {
+			double sample = static_cast<double>(latency->count());
+			status.latencyMs = status.latencyMs > 0 ? status.latencyMs * 0.7 + sample * 0.3 : sample;
+		}
+	}
+	else if (++status.consecutiveFailures >= failuresAllowed) {
+		status.healthy = false;
+	}
+	return status.healthy != wasHealthy;
+}
+
+size_t EndpointBalancer::First()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return PickLocked(false);
+}
+
+size_t EndpointBalancer::Outstanding(size_t endpoint) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return endpoint < endpoints.size() ? endpoints[endpoint].outstanding : 0;
+}
+
+size_t EndpointBalancer::Waiting() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return waiting.size();
+}
+
+std::vector<EndpointBalancer::EndpointStatus> EndpointBalancer::Status() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return endpoints;
+}
+
+size_t EndpointBalancer::PickLocked(bool advance)
+{
+	size_t count = endpoints.size();
+	bool anyHealthy = std::any_of(endpoints.begin(), endpoints.end(), [](const EndpointStatus& status) { return status.healthy; });
+	size_t best = count;
+	// Start the scan after the last pick so equal endpoints alternate
+	for (size_t i = 0; i < count; i++) {
+		size_t candidate = (nextTie + i) % count;
+		const EndpointStatus& status = endpoints[candidate];
+		if (status.outstanding >= limit || (anyHealthy && !status.healthy)) {
+			continue;
+		}
+		if (best == count || Better(candidate, best)) {
+			best = candidate;
+		}
+	}
+	if (best != count && advance) {
+		nextTie = best + 1;
+	}
+	return best;
+}
+
+bool EndpointBalancer::Better(size_t candidate, size_t best) const
+{
+	const EndpointStatus& a = endpoints[candidate];
+	const EndpointStatus& b = endpoints[best];
+	if (a.outstanding != b.outstanding) {
+		return a.outstanding < b.outstanding;
+	}
+	// Unmeasured endpoints count as fast so they get tried
+	return a.latencyMs < b.latencyMs;
+}
+
+std::vector<std::string> ParseEndpointList(const std::string& text, uint16_t defaultPort)
+{
+	std::vector<std::string> endpoints;
+	std::string port = std::to_string(defaultPort);
+	size_t start = 0;
+	while (start < text.size()) {
+		size_t end = text.find_first_of(",; \t", start);
+		if (end == std::string::npos) {
+			end = text.size();
+		}
+		std::string entry = text.substr(start, end - start);
+		start = end + 1;
+
+		if (entry.rfind("http://", 0) == 0) {
+			entry.erase(0, 7);
+		}
+		while (!entry.empty() && entry.back() == '/') {
+			entry.pop_back();
+		}
+		if (entry.empty()) {
+			continue;
+		}
+
+		size_t colons = std::count(entry.begin(), entry.end(), ':');
+		if (entry.front() == '[') {
+			// [v6] or [v6]:port
+			if (entry.back() == ']') {
+				entry += ":" + port;
+			}
+		}
+		else if (colons > 1) {
+			entry = "[" + entry + "]:" + port; // bare IPv6, cannot carry a port
+		}
+		else if (colons == 0) {
+			entry += ":" + port;
+		}
+		endpoints.push_back(std::move(entry));
+	}
+	return endpoints;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Spreads requests over several instances of the same service. Each request
+// goes to the healthy endpoint with the fewest requests outstanding (ties go to
+// the faster one, then take turns), no endpoint gets more than
+// perEndpointLimit at once, and requests past every limit wait in order for
+// the next free slot. Endpoints out of rotation are only used again once a
+// report says they are back, or when none is healthy.
+class EndpointBalancer
+{
+public:
+	using Dispatch = std::function<void(size_t endpoint)>;
+
+	struct EndpointStatus {
+		bool checked = false; // any report yet
+		bool healthy = true;
+		double latencyMs = 0; // smoothed probe round trip, 0 before the first
+		size_t consecutiveFailures = 0;
+		size_t outstanding = 0;
+	};
+
+	EndpointBalancer(size_t endpointCount, size_t perEndpointLimit);
+
+	// Runs dispatch right away on the caller's thread, or later on the thread
+	// of the Release that frees a slot. Every dispatch must be paired with one
+	// Release of the endpoint it was given.
+	void Acquire(Dispatch dispatch);
+	void Release(size_t endpoint);
+
+	// Outcome of a health probe, latency is its round trip. A failed probe takes
+	// the endpoint out of rotation at once. Returns true when the endpoint went
+	// in or out of rotation.
+	bool ReportProbe(size_t endpoint, bool ok, std::chrono::milliseconds latency);
+	// Outcome of a real request, which takes as long as the page it loads so
+	// only counts for health: failuresToEject in a row take the endpoint out
+	bool ReportRequest(size_t endpoint, bool ok);
+
+	// Where the next request would go, endpointCount when all are full
+	size_t First();
+
+	size_t Outstanding(size_t endpoint) const;
+	size_t Waiting() const;
+	std::vector<EndpointStatus> Status() const;
+
+	static constexpr size_t failuresToEject = 2;
+
+private:
+	bool ReportLocked(size_t endpoint, bool ok, size_t failuresAllowed, std::optional<std::chrono::milliseconds> latency);
+	// Index of the endpoint to use next, endpointCount when all are full
+	size_t PickLocked(bool advance);
+	bool Better(size_t candidate, size_t best) const;
+
+	mutable std::mutex mutex;
+	std::vector<EndpointStatus> endpoints;
+	size_t limit;
+	size_t nextTie = 0;
+	std::deque<Dispatch> waiting;
+};
+
+// "host", "host:port", "[v6]:port" or a bare IPv6 address, separated by commas,
+// semicolons or spaces, each returned as host:port with defaultPort filled in
+// and IPv6 hosts in brackets, ready for "http://" + endpoint
+std::vector<std::string> ParseEndpointList(const std::string& text, uint16_t defaultPort);
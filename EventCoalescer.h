@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+
+// Collapses bursts of hook-driven work into one run per kind of work. The
+// first Request for a key arms a timer; every further Request before it fires
+// joins the same run and pushes it back to quiet after the latest one, but
+// never past maxDelay after the first. Work requesting its own key starts a new
+// burst. Single-threaded: Request, Cancel and the scheduled callbacks must all
+// run on the same thread (the game thread in the plugin).
+template <typename Key>
+class EventCoalescer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+	// Runs callback once after about seconds, on the thread Request is called on
+	using Schedule = std::function<void(std::function<void()> callback, float seconds)>;
+
+	struct Counts {
+		uint64_t requests = 0;
+		uint64_t runs = 0;
+	};
+
+	explicit EventCoalescer(Schedule schedule) : schedule(std::move(schedule)) {}
+
+	void Define(Key key, std::chrono::milliseconds quiet, std::chrono::milliseconds maxDelay, std::function<void()> work)
+	{
+		Slot& slot = slots[key];
+		slot.quiet = quiet;
+		slot.maxDelay = std::max(maxDelay, quiet);
+		slot.work = std::move(work);
+	}
+
+	void Request(Key key)
+	{
+		Slot& slot = slots.at(key);
+		slot.counts.requests++;
+		Clock::time_point now = Clock::now();
+		if (slot.pending) {
+			slot.due = std::min(now + slot.quiet, slot.first + slot.maxDelay);
+			return;
+		}
+		slot.pending = true;
+		slot.first = now;
+		slot.due = now + slot.quiet;
+		Arm(key, slot.generation, slot.quiet);
+	}
+
+	// Drops a pending run, a timer already armed for it returns without running
+	void Cancel(Key key)
+	{
+		Slot& slot = slots.at(key);
+		slot.pending = false;
+		slot.generation++;
+	}
+
+	void CancelAll()
+	{
+		for (auto& [key, slot] : slots) {
+			slot.pending = false;
+			slot.generation++;
+		}
+	}
+
+	Counts GetCounts(Key key) const { return slots.at(key).counts; }
+
+private:
+	struct Slot {
+		std::chrono::milliseconds quiet{ 0 };
+		std::chrono::milliseconds maxDelay{ 0 };
+		std::function<void()> work;
+		bool pending = false;
+		Clock::time_point first;
+		Clock::time_point due;
+		uint64_t generation = 0; // bumped whenever a run happens or is cancelled
+		Counts counts;
+	};
+
+	void Arm(Key key, uint64_t generation, Clock::duration delay)
+	{
+		float seconds = std::chrono::duration<float>(delay).count();
+		schedule([this, key, generation]() { Fire(key, generation); }, seconds);
+	}
+
+	void Fire(Key key, uint64_t generation)
+	{
+		Slot& slot = slots.at(key);
+		if (!slot.pending || slot.generation != generation) {
+			return;
+		}
+		// Timers cannot be moved, so one that fires early for a burst that kept going re-arms itself
+		Clock::time_point now = Clock::now();
+		if (now < slot.due) {
+			Arm(key, generation, slot.due - now);
+			return;
+		}
+		slot.pending = false;
+		slot.generation++;
+		slot.counts.runs++;
+		slot.work();
+	}
+
+	Schedule schedule;
+	std::map<Key, Slot> slots;
+};
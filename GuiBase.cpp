@@ -48,7 +48,7 @@ void PluginWindowBase::OnClose()
 
 void PluginWindowBase::Render()
 {
-	if (!ImGui::Begin(menuTitle_.c_str(), &isWindowOpen_, ImGuiWindowFlags_None))
+	if (!ImGui::Begin(menuTitle_.c_str(), &isWindowOpen_, windowFlags_))
 	{
 		// Early out if the window is collapsed, as an optimization.
 		ImGui::End();
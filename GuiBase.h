@@ -16,6 +16,7 @@ public:
 
 	bool isWindowOpen_ = false;
 	std::string menuTitle_ = "SmurfTracker";
+	int windowFlags_ = 0; // ImGuiWindowFlags for Begin
 
 	std::string GetMenuName() override;
 	std::string GetMenuTitle() override;
@@ -0,0 +1,234 @@
+#include "HttpMessage.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+namespace {
+	constexpr size_t maxHeaderBytes = maxHttpHeadBytes;
+
+	std::string Lower(std::string text)
+	{
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return text;
+	}
+
+	std::string Trim(const std::string& text)
+	{
+		size_t begin = text.find_first_not_of(" \t");
+		size_t end = text.find_last_not_of(" \t\r");
+		return begin == std::string::npos ? "" : text.substr(begin, end - begin + 1);
+	}
+
+	// Appends whatever arrives next, false when the peer closed or the read failed
+	bool ReceiveMore(SocketHandle socket, std::string& buffer)
+	{
+		char chunk[16 * 1024];
+		int received = RecvSome(socket, chunk, sizeof(chunk));
+		if (received <= 0) {
+			return false;
+		}
+		buffer.append(chunk, static_cast<size_t>(received));
+		return true;
+	}
+
+	// Blocks until buffer holds at least size bytes
+	bool ReceiveAtLeast(SocketHandle socket, std::string& buffer, size_t size)
+	{
+		while (buffer.size() < size) {
+			if (!ReceiveMore(socket, buffer)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Blocks until buffer holds a CRLF at or after from, returns its position
+	size_t ReceiveLine(SocketHandle socket, std::string& buffer, size_t from)
+	{
+		size_t end;
+		while ((end = buffer.find("\r\n", from)) == std::string::npos) {
+			if (buffer.size() - from > maxHeaderBytes || !ReceiveMore(socket, buffer)) {
+				return std::string::npos;
+			}
+		}
+		return end;
+	}
+}
+
+std::string HttpMessage::Header(const std::string& name) const
+{
+	auto it = headers.find(name);
+	return it != headers.end() ? it->second : std::string();
+}
+
+ReadStatus ReadHttpHead(SocketHandle socket, std::string& buffer, HttpMessage& message)
+{
+	while (!TakeHttpHead(buffer, message)) {
+		if (buffer.size() > maxHeaderBytes) {
+			return ReadStatus::TooLarge;
+		}
+		if (!ReceiveMore(socket, buffer)) {
+			return buffer.empty() ? ReadStatus::Closed : ReadStatus::Error;
+		}
+	}
+	return ReadStatus::Ok;
+}
+
+bool TakeHttpHead(std::string& buffer, HttpMessage& message)
+{
+	size_t headerEnd = buffer.find("\r\n\r\n");
+	if (headerEnd == std::string::npos) {
+		return false;
+	}
+
+	size_t lineStart = 0;
+	size_t lineEnd = buffer.find("\r\n");
+	message.startLine = buffer.substr(0, lineEnd);
+	while (lineEnd < headerEnd) {
+		lineStart = lineEnd + 2;
+		lineEnd = buffer.find("\r\n", lineStart);
+		std::string line = buffer.substr(lineStart, lineEnd - lineStart);
+		size_t colon = line.find(':');
+		if (colon != std::string::npos) {
+			message.headers[Lower(Trim(line.substr(0, colon)))] = Trim(line.substr(colon + 1));
+		}
+	}
+	buffer.erase(0, headerEnd + 4);
+	return true;
+}
+
+ReadStatus ReadHttpChunk(SocketHandle socket, std::string& buffer, std::string& chunk, size_t maxChunkBytes)
+{
+	chunk.clear();
+	size_t lineEnd = ReceiveLine(socket, buffer, 0);
+	if (lineEnd == std::string::npos) {
+		return ReadStatus::Error;
+	}
+	size_t chunkSize = 0;
+	try {
+		chunkSize = std::stoul(buffer.substr(0, lineEnd), nullptr, 16); // extensions after ';' are ignored
+	}
+	catch (const std::exception&) {
+		return ReadStatus::Error;
+	}
+	size_t pos = lineEnd + 2;
+
+	if (chunkSize == 0) {
+		// Skip trailers up to the empty line
+		while (true) {
+			lineEnd = ReceiveLine(socket, buffer, pos);
+			if (lineEnd == std::string::npos) {
+				return ReadStatus::Error;
+			}
+			bool last = lineEnd == pos;
+			pos = lineEnd + 2;
+			if (last) {
+				buffer.erase(0, pos);
+				return ReadStatus::Ok;
+			}
+		}
+	}
+	if (chunkSize > maxChunkBytes) {
+		return ReadStatus::TooLarge;
+	}
+	if (!ReceiveAtLeast(socket, buffer, pos + chunkSize + 2)) {
+		return ReadStatus::Error;
+	}
+	chunk.assign(buffer, pos, chunkSize);
+	buffer.erase(0, pos + chunkSize + 2);
+	return ReadStatus::Ok;
+}
+
+ReadStatus ReadHttpSome(SocketHandle socket, std::string& buffer, std::string& data)
+{
+	if (buffer.empty() && !ReceiveMore(socket, buffer)) {
+		return ReadStatus::Closed;
+	}
+	data = std::move(buffer);
+	buffer.clear();
+	return ReadStatus::Ok;
+}
+
+bool IsChunked(const HttpMessage& message)
+{
+	return Lower(message.Header("transfer-encoding")).find("chunked") != std::string::npos;
+}
+
+std::string EncodeHttpChunk(std::string_view data)
+{
+	char size[20];
+	std::snprintf(size, sizeof(size), "%zx\r\n", data.size());
+	std::string chunk(size);
+	chunk.append(data);
+	chunk += "\r\n";
+	return chunk;
+}
+
+ReadStatus ReadHttpMessage(SocketHandle socket, std::string& buffer, HttpMessage& message, size_t maxBodyBytes, bool readToClose)
+{
+	ReadStatus status = ReadHttpHead(socket, buffer, message);
+	if (status != ReadStatus::Ok) {
+		return status;
+	}
+
+	if (IsChunked(message)) {
+		std::string chunk;
+		do {
+			status = ReadHttpChunk(socket, buffer, chunk, maxBodyBytes - message.body.size());
+			if (status != ReadStatus::Ok) {
+				return status;
+			}
+			message.body += chunk;
+		} while (!chunk.empty());
+		return ReadStatus::Ok;
+	}
+
+	std::string contentLength = message.Header("content-length");
+	if (!contentLength.empty()) {
+		size_t length = 0;
+		try {
+			length = std::stoul(contentLength);
+		}
+		catch (const std::exception&) {
+			return ReadStatus::Error;
+		}
+		if (length > maxBodyBytes) {
+			return ReadStatus::TooLarge;
+		}
+		if (!ReceiveAtLeast(socket, buffer, length)) {
+			return ReadStatus::Error;
+		}
+		message.body = buffer.substr(0, length);
+		buffer.erase(0, length);
+		return ReadStatus::Ok;
+	}
+
+	if (readToClose) {
+		while (ReceiveMore(socket, buffer)) {
+			if (buffer.size() > maxBodyBytes) {
+				return ReadStatus::TooLarge;
+			}
+		}
+		message.body = std::move(buffer);
+		buffer.clear();
+	}
+	return ReadStatus::Ok;
+}
+
+std::string StatusText(int status)
+{
+	switch (status) {
+	case 200: return "OK";
+	case 204: return "No Content";
+	case 400: return "Bad Request";
+	case 404: return "Not Found";
+	case 405: return "Method Not Allowed";
+	case 413: return "Payload Too Large";
+	case 500: return "Internal Server Error";
+	case 502: return "Bad Gateway";
+	case 503: return "Service Unavailable";
+	case 504: return "Gateway Timeout";
+	default: return "Unknown";
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "SocketCompat.h"
+
+// One HTTP/1.1 request or response as read off a socket
+struct HttpMessage {
+	std::string startLine; // "POST /lobby HTTP/1.1" or "HTTP/1.1 200 OK"
+	std::map<std::string, std::string> headers; // names lower-cased
+	std::string body;
+
+	// Empty when absent, name in lower case
+	std::string Header(const std::string& name) const;
+};
+
+enum class ReadStatus {
+	Ok,
+	Closed,   // peer closed before a message started
+	Error,    // malformed, timed out or cut off
+	TooLarge, // headers or body over the limit
+};
+
+// Reads one message. buffer carries bytes received past the previous message
+// on a keep-alive connection. Bodies are taken from Content-Length or chunked
+// encoding; with neither, readToClose reads until the peer closes (responses)
+// and otherwise the body is empty (requests).
+ReadStatus ReadHttpMessage(SocketHandle socket, std::string& buffer, HttpMessage& message, size_t maxBodyBytes, bool readToClose);
+
+// The pieces ReadHttpMessage is made of, for bodies consumed while they arrive.
+// ReadHttpHead fills startLine and headers only.
+ReadStatus ReadHttpHead(SocketHandle socket, std::string& buffer, HttpMessage& message);
+// Without a socket: parses and removes a head once buffer holds all of it, false until then
+bool TakeHttpHead(std::string& buffer, HttpMessage& message);
+// Next chunk of a chunked body into chunk. An empty chunk with Ok means the body is complete.
+ReadStatus ReadHttpChunk(SocketHandle socket, std::string& buffer, std::string& chunk, size_t maxChunkBytes);
+// Whatever arrives next of a body without framing, Closed once the peer is done
+ReadStatus ReadHttpSome(SocketHandle socket, std::string& buffer, std::string& data);
+bool IsChunked(const HttpMessage& message);
+constexpr size_t maxHttpHeadBytes = 16 * 1024;
+
+// Frames data as one chunk of a chunked body, empty data gives the final chunk
+std::string EncodeHttpChunk(std::string_view data);
+
+std::string StatusText(int status);
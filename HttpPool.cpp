@@ -0,0 +1,726 @@
+#include "HttpPool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+	constexpr std::string_view scheme = "http://";
+	// A chunk size line is a few hex digits, anything longer is not HTTP
+	constexpr size_t maxChunkLineBytes = 1024;
+	constexpr int pollIntervalMs = 250;
+
+	bool HasHeader(const std::map<std::string, std::string>& headers, std::string_view name)
+	{
+		return std::any_of(headers.begin(), headers.end(), [name](const auto& header) {
+			return std::equal(header.first.begin(), header.first.end(), name.begin(), name.end(),
+				[](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); });
+			});
+	}
+
+	std::string Lower(std::string text)
+	{
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return text;
+	}
+}
+
+HttpPool::ResponseReader::Result HttpPool::ResponseReader::Feed(const char* data, size_t size)
+{
+	started = true;
+	buffer.append(data, size);
+	return Parse();
+}
+
+HttpPool::ResponseReader::Result HttpPool::ResponseReader::Finish()
+{
+	if (stage == Stage::UntilClose) {
+		stage = Stage::Done;
+		return Parse();
+	}
+	if (stage == Stage::Done) {
+		return Result::Done;
+	}
+	return Fail(started ? "connection closed in the middle of the response" : "connection closed without a response");
+}
+
+HttpPool::ResponseReader::Result HttpPool::ResponseReader::Parse()
+{
+	for (;;) {
+		switch (stage) {
+		case Stage::Head: {
+			HttpMessage head;
+			if (!TakeHttpHead(buffer, head)) {
+				return buffer.size() > maxHttpHeadBytes ? Fail("response head is too large") : Result::NeedMore;
+			}
+			// "HTTP/1.1 200 OK"
+			size_t codeStart = head.startLine.find(' ');
+			status = codeStart != std::string::npos ? std::atoi(head.startLine.c_str() + codeStart + 1) : 0;
+			if (status < 100) {
+				return Fail("invalid status line: " + head.startLine);
+			}
+			if (status < 200) {
+				continue; // 100 Continue and friends, the real head follows
+			}
+			std::string connection = Lower(head.Header("connection"));
+			keepAlive = head.startLine.compare(0, 8, "HTTP/1.1") == 0
+				? connection.find("close") == std::string::npos
+				: connection.find("keep-alive") != std::string::npos;
+
+			ContentEncoding encoding = ParseContentEncoding(head.Header("content-encoding"));
+			compressed = encoding != ContentEncoding::Identity;
+			decoder = std::make_unique<ContentDecoder>(encoding);
+			decoder->maxOutputBytes = maxBodyBytes;
+
+			std::string contentLength = head.Header("content-length");
+			if (status == 204 || status == 304) {
+				stage = Stage::Done;
+			}
+			else if (IsChunked(head)) {
+				stage = Stage::ChunkSize;
+			}
+			else if (!contentLength.empty()) {
+				remaining = std::strtoull(contentLength.c_str(), nullptr, 10);
+				stage = remaining > 0 ? Stage::Sized : Stage::Done;
+			}
+			else {
+				stage = Stage::UntilClose;
+				keepAlive = false;
+			}
+			continue;
+		}
+		case Stage::Sized:
+		case Stage::ChunkData: {
+			size_t take = std::min(remaining, buffer.size());
+			if (Body(std::string_view(buffer).substr(0, take)) == Result::Error) {
+				return Result::Error;
+			}
+			buffer.erase(0, take);
+			remaining -= take;
+			if (remaining > 0) {
+				return Result::NeedMore;
+			}
+			stage = stage == Stage::Sized ? Stage::Done : Stage::ChunkEnd;
+			continue;
+		}
+		case Stage::ChunkSize: {
+			size_t lineEnd = buffer.find("\r\n");
+			if (lineEnd == std::string::npos) {
+				return buffer.size() > maxChunkLineBytes ? Fail("invalid chunk size line") : Result::NeedMore;
+			}
+			char* end = nullptr;
+			remaining = std::strtoull(buffer.c_str(), &end, 16); // extensions after ';' are ignored
+			if (end == buffer.c_str()) {
+				return Fail("invalid chunk size line");
+			}
+			buffer.erase(0, lineEnd + 2);
+			stage = remaining > 0 ? Stage::ChunkData : Stage::Trailers;
+			continue;
+		}
+		case Stage::ChunkEnd:
+			if (buffer.size() < 2) {
+				return Result::NeedMore;
+			}
+			if (buffer.compare(0, 2, "\r\n") != 0) {
+				return Fail("chunk is longer than its size");
+			}
+			buffer.erase(0, 2);
+			stage = Stage::ChunkSize;
+			continue;
+		case Stage::Trailers: {
+			size_t lineEnd = buffer.find("\r\n");
+			if (lineEnd == std::string::npos) {
+				return buffer.size() > maxHttpHeadBytes ? Fail("trailers are too large") : Result::NeedMore;
+			}
+			buffer.erase(0, lineEnd + 2);
+			if (lineEnd == 0) {
+				stage = Stage::Done;
+			}
+			continue;
+		}
+		case Stage::UntilClose:
+			if (Body(buffer) == Result::Error) {
+				return Result::Error;
+			}
+			buffer.clear();
+			return Result::NeedMore;
+		case Stage::Done:
+			if (compressed && decoder->State() != ContentDecoder::Status::Done) {
+				return Fail("compressed body is cut off");
+			}
+			// Anything after the response was not asked for, do not trust the connection
+			if (!buffer.empty()) {
+				keepAlive = false;
+			}
+			return Result::Done;
+		}
+	}
+}
+
+HttpPool::ResponseReader::Result HttpPool::ResponseReader::Body(std::string_view data)
+{
+	if (!compressed && body.size() + data.size() > maxBodyBytes) {
+		return Fail("response is larger than " + std::to_string(maxBodyBytes) + " bytes");
+	}
+	if (decoder->Feed(data, body) == ContentDecoder::Status::Error) {
+		return Fail(decoder->ErrorText());
+	}
+	return Result::NeedMore;
+}
+
+HttpPool::ResponseReader::Result HttpPool::ResponseReader::Fail(std::string message)
+{
+	error = std::move(message);
+	return Result::Error;
+}
+
+HttpPool::HttpPool(size_t perHostLimit)
+	: perHostLimit(std::max<size_t>(perHostLimit, 1))
+{
+	wakeSocket = socket(AF_INET, SOCK_DGRAM, 0);
+	if (wakeSocket != invalidSocket) {
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		socklen_t length = sizeof(address);
+		if (bind(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+			|| getsockname(wakeSocket, reinterpret_cast<sockaddr*>(&address), &length) != 0
+			|| connect(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+			// Without it new requests wait for the next poll interval, slower but still working
+			CloseSocket(wakeSocket);
+			wakeSocket = invalidSocket;
+		}
+		else {
+			SetNonBlocking(wakeSocket);
+		}
+	}
+	ioThread = std::thread([this] { Run(); });
+	resolverThread = std::thread([this] { ResolveLoop(); });
+}
+
+HttpPool::~HttpPool()
+{
+	Stop();
+}
+
+void HttpPool::Send(const HttpCall& call, std::function<void(int, std::string)> done)
+{
+	if (call.url.compare(0, scheme.size(), scheme) != 0) {
+		done(0, "Only http:// URLs go through the HTTP pool: " + call.url);
+		return;
+	}
+
+	auto request = std::make_unique<Request>();
+	size_t pathStart = call.url.find('/', scheme.size());
+	request->authority = call.url.substr(scheme.size(), pathStart - scheme.size());
+	std::string path = pathStart != std::string::npos ? call.url.substr(pathStart) : "/";
+
+	std::string& head = request->head;
+	head = call.verb + " " + path + " HTTP/1.1\r\n";
+	if (!HasHeader(call.headers, "Host")) {
+		head += "Host: " + request->authority + "\r\n";
+	}
+	for (const auto& [name, value] : call.headers) {
+		head += name + ": " + value + "\r\n";
+	}
+	// Bodies are decoded here as they arrive, so ask for them compressed
+	if (!HasHeader(call.headers, "Accept-Encoding")) {
+		head += "Accept-Encoding: " + std::string(acceptEncodingHeader) + "\r\n";
+	}
+	if (!call.body.empty() || call.verb == "POST" || call.verb == "PUT") {
+		head += "Content-Length: " + std::to_string(call.body.size()) + "\r\n";
+	}
+	head += "\r\n";
+	request->body = call.body;
+	request->done = std::move(done);
+	request->deadline = Clock::now() + (call.timeout.count() > 0 ? call.timeout : defaultTimeout);
+
+	{
+		// Woken under the lock so Stop cannot close the wake socket in between
+		std::lock_guard<std::mutex> lock(incomingMutex);
+		if (!stopping) {
+			incoming.push_back(std::move(request));
+			requests++;
+			Wake();
+		}
+	}
+	if (request) {
+		request->done(0, "HTTP pool is stopped");
+	}
+}
+
+void HttpPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(incomingMutex);
+		stopping = true;
+	}
+	{
+		std::lock_guard<std::mutex> lock(resolveMutex);
+		resolverStopping = true;
+	}
+	resolveWanted.notify_all();
+	Wake();
+	if (ioThread.joinable()) {
+		ioThread.join();
+	}
+	// Only a name lookup already under way can hold this up
+	if (resolverThread.joinable()) {
+		resolverThread.join();
+	}
+	if (wakeSocket != invalidSocket) {
+		CloseSocket(wakeSocket);
+		wakeSocket = invalidSocket;
+	}
+}
+
+HttpPool::Stats HttpPool::GetStats() const
+{
+	Stats stats;
+	stats.requests = requests.load();
+	stats.connectionsOpened = connectionsOpened.load();
+	stats.reused = reused.load();
+	stats.open = open.load();
+	return stats;
+}
+
+void HttpPool::Run()
+{
+	std::vector<PollDescriptor> descriptors;
+	for (;;) {
+		{
+			std::lock_guard<std::mutex> lock(incomingMutex);
+			if (stopping) {
+				break;
+			}
+			for (auto& request : incoming) {
+				queued[request->authority].push_back(std::move(request));
+			}
+			incoming.clear();
+		}
+		TakeResolutions();
+		Dispatch();
+
+		descriptors.clear();
+		size_t first = 0;
+		if (wakeSocket != invalidSocket) {
+			PollDescriptor wake{};
+			wake.fd = wakeSocket;
+			wake.events = POLLIN;
+			descriptors.push_back(wake);
+			first = 1;
+		}
+		for (const auto& connection : connections) {
+			PollDescriptor descriptor{};
+			descriptor.fd = connection->socket;
+			bool writing = connection->state == Connection::State::Connecting || connection->state == Connection::State::Writing;
+			descriptor.events = writing ? POLLOUT : POLLIN;
+			descriptors.push_back(descriptor);
+		}
+		// A freed connection or a retry may let a queued request go right away
+		int timeout = redispatch ? 0 : pollIntervalMs;
+		redispatch = false;
+		if (descriptors.empty()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+		}
+		else {
+			PollSockets(descriptors.data(), descriptors.size(), timeout);
+		}
+
+		if (first == 1 && descriptors[0].revents != 0) {
+			char drain[64];
+			while (RecvSome(wakeSocket, drain, sizeof(drain)) > 0) {
+			}
+		}
+		// Connections only come and go in Dispatch and below, indices still match
+		for (size_t i = first; i < descriptors.size(); i++) {
+			Connection& connection = *connections[i - first];
+			if (descriptors[i].revents == 0) {
+				continue;
+			}
+			switch (connection.state) {
+			case Connection::State::Connecting:
+			case Connection::State::Writing:
+				OnWritable(connection);
+				break;
+			case Connection::State::Reading:
+				OnReadable(connection);
+				break;
+			case Connection::State::Idle:
+				// The server closed it, or sent something nobody asked for
+				Close(connection);
+				break;
+			case Connection::State::Closed:
+				break;
+			}
+		}
+		ExpireDeadlines(Clock::now());
+		connections.erase(std::remove_if(connections.begin(), connections.end(),
+			[](const auto& connection) { return connection->state == Connection::State::Closed; }), connections.end());
+	}
+	FailAll("HTTP pool is stopped");
+}
+
+void HttpPool::SetPerHostLimit(size_t limit)
+{
+	perHostLimit = std::max<size_t>(limit, 1);
+	Wake(); // a raised limit lets queued requests go at once
+}
+
+void HttpPool::Dispatch()
+{
+	size_t limit = perHostLimit;
+	for (auto it = queued.begin(); it != queued.end();) {
+		const std::string& authority = it->first;
+		std::deque<std::unique_ptr<Request>>& waiting = it->second;
+		while (!waiting.empty()) {
+			Connection* idle = nullptr;
+			size_t busy = 0;
+			for (const auto& connection : connections) {
+				if (connection->authority != authority || connection->state == Connection::State::Closed) {
+					continue;
+				}
+				if (connection->state != Connection::State::Idle) {
+					busy++;
+				}
+				else if (!idle) {
+					idle = connection.get();
+				}
+			}
+			// Counts requests rather than sockets, idle ones left over from a higher limit do not add to it
+			if (busy >= limit) {
+				break;
+			}
+			const Resolution* resolution = idle ? nullptr : FreshResolution(authority);
+			if (!idle && !resolution) {
+				break; // TakeResolutions dispatches again once the name is resolved
+			}
+			std::unique_ptr<Request> request = std::move(waiting.front());
+			waiting.pop_front();
+			if (idle) {
+				Assign(*idle, std::move(request));
+			}
+			else {
+				Open(authority, resolution->addresses, std::move(request));
+			}
+		}
+		it = waiting.empty() ? queued.erase(it) : std::next(it);
+	}
+}
+
+void HttpPool::ResolveLoop()
+{
+	for (;;) {
+		std::string authority;
+		{
+			std::unique_lock<std::mutex> lock(resolveMutex);
+			resolveWanted.wait(lock, [this] { return resolverStopping || !toResolve.empty(); });
+			if (resolverStopping) {
+				return;
+			}
+			authority = std::move(toResolve.front());
+			toResolve.pop_front();
+		}
+
+		std::string host;
+		std::string port;
+		SplitHostPort(authority, "80", host, port);
+		addrinfo hints{};
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		addrinfo* found = nullptr;
+		Resolution resolution;
+		if (getaddrinfo(host.c_str(), port.c_str(), &hints, &found) == 0) {
+			for (addrinfo* info = found; info != nullptr; info = info->ai_next) {
+				Address address;
+				std::memcpy(&address.storage, info->ai_addr, info->ai_addrlen);
+				address.length = static_cast<socklen_t>(info->ai_addrlen);
+				address.family = info->ai_family;
+				resolution.addresses.push_back(address);
+			}
+			freeaddrinfo(found);
+		}
+		resolution.resolvedAt = Clock::now();
+
+		{
+			std::lock_guard<std::mutex> lock(resolveMutex);
+			resolvedIncoming.emplace_back(std::move(authority), std::move(resolution));
+		}
+		std::lock_guard<std::mutex> lock(incomingMutex);
+		if (!stopping) {
+			Wake();
+		}
+	}
+}
+
+void HttpPool::TakeResolutions()
+{
+	std::vector<std::pair<std::string, Resolution>> arrived;
+	{
+		std::lock_guard<std::mutex> lock(resolveMutex);
+		arrived.swap(resolvedIncoming);
+	}
+	for (auto& [authority, resolution] : arrived) {
+		resolving.erase(authority);
+		if (!resolution.addresses.empty()) {
+			resolved[authority] = std::move(resolution);
+			continue;
+		}
+		// Nothing to connect to, the next request for the host asks again
+		resolved.erase(authority);
+		auto it = queued.find(authority);
+		if (it == queued.end()) {
+			continue;
+		}
+		std::deque<std::unique_ptr<Request>> waiting = std::move(it->second);
+		queued.erase(it);
+		std::string host;
+		std::string port;
+		SplitHostPort(authority, "80", host, port);
+		for (auto& request : waiting) {
+			request->done(0, "Cannot resolve " + host);
+		}
+	}
+}
+
+const HttpPool::Resolution* HttpPool::FreshResolution(const std::string& authority)
+{
+	auto it = resolved.find(authority);
+	if (it != resolved.end() && Clock::now() - it->second.resolvedAt < resolveTtl) {
+		return &it->second;
+	}
+	if (resolving.insert(authority).second) {
+		{
+			std::lock_guard<std::mutex> lock(resolveMutex);
+			toResolve.push_back(authority);
+		}
+		resolveWanted.notify_one();
+	}
+	return nullptr;
+}
+
+bool HttpPool::Open(const std::string& authority, const std::vector<Address>& addresses, std::unique_ptr<Request> request)
+{
+	auto connection = std::make_unique<Connection>();
+	connection->authority = authority;
+	connection->addresses = addresses;
+	if (!ConnectNext(*connection)) {
+		request->done(0, "Cannot connect to " + authority);
+		return false;
+	}
+
+	Assign(*connection, std::move(request));
+	connections.push_back(std::move(connection));
+	connectionsOpened++;
+	open++;
+	return true;
+}
+
+bool HttpPool::ConnectNext(Connection& connection)
+{
+	while (connection.nextAddress < connection.addresses.size()) {
+		const Address& address = connection.addresses[connection.nextAddress++];
+		SocketHandle socketHandle = socket(address.family, SOCK_STREAM, IPPROTO_TCP);
+		if (socketHandle == invalidSocket) {
+			continue;
+		}
+		if (!SetNonBlocking(socketHandle)
+			|| (connect(socketHandle, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0 && !WouldBlock())) {
+			CloseSocket(socketHandle);
+			continue;
+		}
+		// Requests are small and answered whole, waiting for more to send only adds latency
+		int noDelay = 1;
+		setsockopt(socketHandle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+		connection.socket = socketHandle;
+		connection.connectStarted = Clock::now();
+		return true;
+	}
+	return false;
+}
+
+void HttpPool::Assign(Connection& connection, std::unique_ptr<Request> request)
+{
+	connection.out = request->head + request->body;
+	connection.written = 0;
+	connection.reader = ResponseReader();
+	connection.request = std::move(request);
+	if (connection.state == Connection::State::Idle) {
+		connection.state = Connection::State::Writing;
+		reused++;
+	}
+}
+
+void HttpPool::OnWritable(Connection& connection)
+{
+	if (connection.state == Connection::State::Connecting) {
+		if (SocketError(connection.socket) != 0) {
+			// The host's next address, IPv4 after a refused ::1 for instance
+			SocketHandle refused = connection.socket;
+			if (ConnectNext(connection)) {
+				CloseSocket(refused);
+				return;
+			}
+			Fail(connection, "Cannot connect to " + connection.authority);
+			return;
+		}
+		connection.state = Connection::State::Writing;
+	}
+	while (connection.written < connection.out.size()) {
+		int sent = SendSome(connection.socket, connection.out.data() + connection.written, connection.out.size() - connection.written);
+		if (sent < 0 && WouldBlock()) {
+			return;
+		}
+		if (sent <= 0) {
+			Fail(connection, "Cannot send to " + connection.authority);
+			return;
+		}
+		connection.written += static_cast<size_t>(sent);
+	}
+	connection.out.clear();
+	connection.state = Connection::State::Reading;
+}
+
+void HttpPool::OnReadable(Connection& connection)
+{
+	char chunk[16 * 1024];
+	for (;;) {
+		int received = RecvSome(connection.socket, chunk, sizeof(chunk));
+		ResponseReader::Result result;
+		if (received > 0) {
+			result = connection.reader.Feed(chunk, static_cast<size_t>(received));
+		}
+		else if (received == 0) {
+			result = connection.reader.Finish();
+		}
+		else if (WouldBlock()) {
+			return;
+		}
+		else {
+			Fail(connection, "Connection to " + connection.authority + " was reset");
+			return;
+		}
+
+		if (result == ResponseReader::Result::Error) {
+			Fail(connection, "Bad response from " + connection.authority + ": " + connection.reader.error);
+			return;
+		}
+		if (result == ResponseReader::Result::Done) {
+			Complete(connection);
+			return;
+		}
+	}
+}
+
+void HttpPool::Fail(Connection& connection, const std::string& reason)
+{
+	std::unique_ptr<Request> request = std::move(connection.request);
+	// A kept-alive connection the server dropped before answering is worth one more try
+	bool retry = request && connection.served && !connection.reader.started && !request->retried;
+	Close(connection);
+	if (!request) {
+		return;
+	}
+	if (retry) {
+		request->retried = true;
+		queued[request->authority].push_front(std::move(request));
+		return;
+	}
+	request->done(0, reason);
+}
+
+void HttpPool::Complete(Connection& connection)
+{
+	std::unique_ptr<Request> request = std::move(connection.request);
+	int status = connection.reader.status;
+	std::string body = std::move(connection.reader.body);
+	connection.served = true;
+	if (connection.reader.keepAlive) {
+		connection.state = Connection::State::Idle;
+		connection.idleSince = Clock::now();
+		redispatch = true;
+	}
+	else {
+		Close(connection);
+	}
+	request->done(status, std::move(body));
+}
+
+void HttpPool::Close(Connection& connection)
+{
+	if (connection.state == Connection::State::Closed) {
+		return;
+	}
+	CloseSocket(connection.socket);
+	connection.socket = invalidSocket;
+	connection.state = Connection::State::Closed;
+	open--;
+	redispatch = true;
+}
+
+void HttpPool::ExpireDeadlines(Clock::time_point now)
+{
+	for (const auto& connection : connections) {
+		if (connection->request && now >= connection->request->deadline) {
+			connection->request->retried = true; // out of time, no second attempt
+			Fail(*connection, "Request to " + connection->authority + " timed out");
+		}
+		else if (connection->state == Connection::State::Idle && now - connection->idleSince > idleTimeout) {
+			Close(*connection);
+		}
+		else if (connection->state == Connection::State::Connecting && now - connection->connectStarted > connectTimeout) {
+			// Silently dropped, try the next address if there is one
+			SocketHandle stalled = connection->socket;
+			if (ConnectNext(*connection)) {
+				CloseSocket(stalled);
+			}
+		}
+	}
+	for (auto& [authority, waiting] : queued) {
+		for (auto it = waiting.begin(); it != waiting.end();) {
+			if (now >= (*it)->deadline) {
+				std::unique_ptr<Request> request = std::move(*it);
+				it = waiting.erase(it);
+				request->done(0, "Timed out waiting for a connection to " + authority);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+}
+
+void HttpPool::FailAll(const std::string& reason)
+{
+	for (const auto& connection : connections) {
+		if (connection->request) {
+			connection->request->retried = true;
+		}
+		Fail(*connection, reason);
+	}
+	connections.clear();
+
+	std::deque<std::unique_ptr<Request>> left;
+	{
+		std::lock_guard<std::mutex> lock(incomingMutex);
+		left.swap(incoming);
+	}
+	for (auto& [authority, waiting] : queued) {
+		for (auto& request : waiting) {
+			left.push_back(std::move(request));
+		}
+	}
+	queued.clear();
+	for (auto& request : left) {
+		request->done(0, reason);
+	}
+}
+
+void HttpPool::Wake()
+{
+	if (wakeSocket != invalidSocket) {
+		char byte = 0;
+		SendSome(wakeSocket, &byte, 1);
+	}
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ContentEncoding.h"
+#include "HttpMessage.h"
+#include "SocketCompat.h"
+#include "StatsProvider.h"
+
+// The plugin's own HTTP/1.1 client for plain http:// endpoints (FlareSolverr,
+// the caching proxy). One I/O thread drives every connection through poll,
+// keeps them open between requests and caps how many go to each host, the
+// rest wait in a queue per host. A request that finds its kept-alive
+// connection closed by the server is retried once on a new one. Host names are
+// resolved on a thread of their own and remembered for a minute, a new
+// connection tries every address in turn. Callbacks run on the I/O thread and
+// must not block it.
+class HttpPool
+{
+public:
+	explicit HttpPool(size_t perHostLimit = 8);
+	~HttpPool();
+
+	HttpPool(const HttpPool&) = delete;
+	HttpPool& operator=(const HttpPool&) = delete;
+
+	// done(0, reason) when the server cannot be reached, the call times out or the pool stops
+	void Send(const HttpCall& call, std::function<void(int, std::string)> done);
+	// Fails whatever is queued or in flight and joins the I/O thread
+	void Stop();
+	// Requests at once per host, the rest queue. Connections a lowered limit
+	// leaves over close after idleTimeout
+	void SetPerHostLimit(size_t limit);
+
+	struct Stats {
+		uint64_t requests = 0;
+		uint64_t connectionsOpened = 0;
+		uint64_t reused = 0; // requests sent on a connection that had served one before
+		size_t open = 0;
+	};
+	Stats GetStats() const;
+
+	// Used when a call has no timeout of its own, FlareSolverr may take a minute
+	static constexpr std::chrono::milliseconds defaultTimeout{ 90000 };
+	static constexpr std::chrono::seconds idleTimeout{ 30 };
+	static constexpr std::chrono::seconds resolveTtl{ 60 };
+	// An address that neither connects nor refuses within this gives way to the next one
+	static constexpr std::chrono::seconds connectTimeout{ 5 };
+	static constexpr size_t maxBodyBytes = 64 * 1024 * 1024;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	struct Request {
+		std::string authority; // host:port, the pool key
+		std::string head;      // request line and headers, Host filled in
+		std::string body;
+		std::function<void(int, std::string)> done;
+		Clock::time_point deadline;
+		bool retried = false;
+	};
+
+	// One of the addresses a host name resolved to
+	struct Address {
+		sockaddr_storage storage{};
+		socklen_t length = 0;
+		int family = 0;
+	};
+
+	struct Resolution {
+		std::vector<Address> addresses; // in getaddrinfo's order, empty when the name did not resolve
+		Clock::time_point resolvedAt;
+	};
+
+	// Incremental response parser, bodies are inflated while they arrive
+	class ResponseReader
+	{
+	public:
+		enum class Result {
+			NeedMore,
+			Done,
+			Error,
+		};
+
+		Result Feed(const char* data, size_t size);
+		// The server closed the connection
+		Result Finish();
+
+		int status = 0;
+		bool keepAlive = false;
+		std::string body;
+		std::string error;
+		bool started = false; // any byte of the response arrived
+
+	private:
+		enum class Stage {
+			Head,
+			Sized,
+			ChunkSize,
+			ChunkData,
+			ChunkEnd,
+			Trailers,
+			UntilClose,
+			Done,
+		};
+
+		Result Parse();
+		Result Body(std::string_view data);
+		Result Fail(std::string message);
+
+		Stage stage = Stage::Head;
+		std::string buffer;
+		size_t remaining = 0;
+		std::unique_ptr<ContentDecoder> decoder;
+		bool compressed = false;
+	};
+
+	struct Connection {
+		enum class State {
+			Connecting,
+			Writing,
+			Reading,
+			Idle,
+			Closed,
+		};
+
+		SocketHandle socket = invalidSocket;
+		std::string authority;
+		std::vector<Address> addresses; // tried in order until one connects
+		size_t nextAddress = 0;
+		Clock::time_point connectStarted;
+		State state = State::Connecting;
+		std::unique_ptr<Request> request;
+		std::string out;
+		size_t written = 0;
+		ResponseReader reader;
+		bool served = false; // has completed a request before this one
+		Clock::time_point idleSince;
+	};
+
+	void Run();
+	void ResolveLoop();
+	// Hands finished resolutions to the I/O thread, failing the requests of names that did not resolve
+	void TakeResolutions();
+	// A fresh resolution of authority, or null after asking the resolver for one
+	const Resolution* FreshResolution(const std::string& authority);
+	void Dispatch();
+	bool Open(const std::string& authority, const std::vector<Address>& addresses, std::unique_ptr<Request> request);
+	// Starts connecting to the connection's next address, false once none is left
+	bool ConnectNext(Connection& connection);
+	void Assign(Connection& connection, std::unique_ptr<Request> request);
+	void OnWritable(Connection& connection);
+	void OnReadable(Connection& connection);
+	// Closes the connection and answers its request, or queues it again for one retry
+	void Fail(Connection& connection, const std::string& reason);
+	void Complete(Connection& connection);
+	void Close(Connection& connection);
+	void ExpireDeadlines(Clock::time_point now);
+	void FailAll(const std::string& reason);
+	void Wake();
+
+	std::atomic<size_t> perHostLimit;
+	std::thread ioThread;
+	std::thread resolverThread;
+	SocketLibrary sockets;
+	SocketHandle wakeSocket = invalidSocket; // UDP socket connected to itself, a byte interrupts poll
+
+	std::mutex incomingMutex;
+	std::deque<std::unique_ptr<Request>> incoming;
+	bool stopping = false;
+
+	// getaddrinfo blocks, so names are resolved on resolverThread
+	std::mutex resolveMutex;
+	std::condition_variable resolveWanted;
+	std::deque<std::string> toResolve; // authorities
+	std::vector<std::pair<std::string, Resolution>> resolvedIncoming;
+	bool resolverStopping = false;
+
+	// I/O thread only
+	std::map<std::string, std::deque<std::unique_ptr<Request>>> queued; // by authority
+	std::map<std::string, Resolution> resolved;
+	std::set<std::string> resolving;
+	std::vector<std::unique_ptr<Connection>> connections;
+	bool redispatch = false; // a connection freed up or a request was queued again
+
+	std::atomic<uint64_t> requests = 0;
+	std::atomic<uint64_t> connectionsOpened = 0;
+	std::atomic<uint64_t> reused = 0;
+	std::atomic<size_t> open = 0;
+};
@@ -0,0 +1,178 @@
+#include "ImGuiOverlay.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace
+{
+	const ImU32 textColor = IM_COL32(255, 255, 255, 255);
+	const ImU32 backgroundColor = IM_COL32(0, 0, 0, 160);
+
+	float TextWidth(ImFont* font, float fontSize, const std::string& text)
+	{
+		return font->CalcTextSizeA(fontSize, FLT_MAX, 0.0f, text.data(), text.data() + text.size()).x;
+	}
+}
+
+ImGuiOverlay::ImGuiOverlay() = default;
+ImGuiOverlay::~ImGuiOverlay() = default;
+
+void ImGuiOverlay::SetModel(const OverlayModel& next)
+{
+	model = &next;
+	dirty = true;
+}
+
+ImVec2 ImGuiOverlay::Draw(ImDrawList* list, ImVec2 origin)
+{
+	if (model == nullptr) {
+		return ImVec2(0, 0);
+	}
+	ImFont* font = ImGui::GetFont();
+	float fontSize = ImGui::GetFontSize();
+	if (!cacheEnabled) {
+		stats.builds++;
+		size = Build(*list, origin, font, fontSize);
+		return size;
+	}
+
+	if (dirty || font != builtFont || fontSize != builtFontSize) {
+		Rebuild(font, fontSize);
+	}
+	if (!replayable) {
+		stats.builds++;
+		return Build(*list, origin, font, fontSize);
+	}
+	stats.replays++;
+	Replay(*list, origin);
+	return size;
+}
+
+void ImGuiOverlay::DrawWindow()
+{
+	ImVec2 tableSize = Draw(ImGui::GetWindowDrawList(), ImGui::GetCursorScreenPos());
+	ImGui::Dummy(tableSize);
+
+	// Right edge, centred vertically, from last frame's window size
+	ImVec2 display = ImGui::GetIO().DisplaySize;
+	ImGui::SetWindowPos(ImVec2(display.x - ImGui::GetWindowWidth() - display.y * 0.02f, (display.y - ImGui::GetWindowHeight()) * 0.5f));
+}
+
+ImVec2 ImGuiOverlay::Build(ImDrawList& list, ImVec2 origin, ImFont* font, float fontSize)
+{
+	float padding = fontSize * 0.5f;
+	float rowHeight = fontSize + 4.0f;
+	float gap = fontSize;
+	size_t stride = model->Stride();
+	size_t rowCount = model->RowCount();
+
+	// Column widths over every team so the cells line up, column 0 holds the names
+	std::vector<float> widths(stride, 0.0f);
+	for (size_t column = 1; column < stride; column++) {
+		widths[column] = TextWidth(font, fontSize, model->columns[column - 1]);
+	}
+	for (const OverlayTeam& team : model->teams) {
+		widths[0] = std::max(widths[0], TextWidth(font, fontSize, team.title));
+	}
+	for (size_t row = 0; row < rowCount; row++) {
+		for (size_t column = 0; column < stride; column++) {
+			widths[column] = std::max(widths[column], TextWidth(font, fontSize, model->Cell(row, column)));
+		}
+	}
+	float tableWidth = widths[0];
+	for (size_t column = 1; column < stride; column++) {
+		tableWidth += gap + widths[column];
+	}
+	tableWidth = std::max(tableWidth, TextWidth(font, fontSize, model->header));
+
+	ImVec2 tableSize(tableWidth + padding * 2,
+		padding * 2 + rowHeight + model->teams.size() * (rowHeight + padding) + rowCount * rowHeight);
+	list.AddRectFilled(origin, ImVec2(origin.x + tableSize.x, origin.y + tableSize.y), backgroundColor, padding);
+
+	auto drawText = [&](float x, float y, ImU32 color, const std::string& text) {
+		list.AddText(font, fontSize, ImVec2(x, y), color, text.data(), text.data() + text.size());
+		};
+	// Names left aligned, numbers read best right aligned in their column
+	auto drawRow = [&](const std::string* texts, float y, ImU32 color) {
+		float x = origin.x + padding;
+		drawText(x, y, color, texts[0]);
+		x += widths[0];
+		for (size_t column = 1; column < stride; column++) {
+			x += gap;
+			if (!texts[column].empty()) {
+				drawText(x + widths[column] - TextWidth(font, fontSize, texts[column]), y, color, texts[column]);
+			}
+			x += widths[column];
+		}
+		};
+
+	std::vector<std::string> titles(stride);
+	std::copy(model->columns.begin(), model->columns.end(), titles.begin() + 1);
+	float y = origin.y + padding;
+	drawText(origin.x + padding, y, textColor, model->header);
+	y += rowHeight;
+	for (const OverlayTeam& team : model->teams) {
+		y += padding;
+		titles[0] = team.title;
+		drawRow(titles.data(), y, team.color);
+		y += rowHeight;
+		for (size_t row = team.firstRow; row < team.firstRow + team.rowCount && row < rowCount; row++) {
+			drawRow(&model->cells[row * stride], y, textColor);
+			y += rowHeight;
+		}
+	}
+	return tableSize;
+}
+
+void ImGuiOverlay::Rebuild(ImFont* font, float fontSize)
+{
+	if (!scratch) {
+		scratch = std::make_unique<ImDrawList>(ImGui::GetDrawListSharedData());
+	}
+	// Nothing is clipped while recording, the table is placed and clipped when it is replayed
+	scratch->Clear();
+	scratch->PushClipRect(ImVec2(-FLT_MAX, -FLT_MAX), ImVec2(FLT_MAX, FLT_MAX));
+	scratch->PushTextureID(font->ContainerAtlas->TexID);
+	size = Build(*scratch, ImVec2(0, 0), font, fontSize);
+
+	// Flatten the commands, a split past 64K vertices leaves indices relative to each command's VtxOffset
+	vertices = scratch->VtxBuffer;
+	indices.resize(0);
+	indices.reserve(scratch->IdxBuffer.Size);
+	replayable = sizeof(ImDrawIdx) > 2 || vertices.Size < (1 << 16);
+	for (const ImDrawCmd& command : scratch->CmdBuffer) {
+		for (unsigned int i = 0; i < command.ElemCount; i++) {
+			indices.push_back(static_cast<ImDrawIdx>(scratch->IdxBuffer[command.IdxOffset + i] + command.VtxOffset));
+		}
+	}
+
+	dirty = false;
+	builtFont = font;
+	builtFontSize = fontSize;
+	stats.builds++;
+	stats.vertices = vertices.Size;
+	stats.indices = indices.Size;
+}
+
+void ImGuiOverlay::Replay(ImDrawList& list, ImVec2 origin) const
+{
+	if (vertices.empty()) {
+		return;
+	}
+	// PrimReserve starts a new command first when the list's 16-bit indices would overflow
+	list.PrimReserve(indices.Size, vertices.Size);
+	unsigned int base = list._VtxCurrentIdx;
+	// Text was snapped to whole pixels when it was built, keep it there
+	float x = static_cast<float>(static_cast<int>(origin.x));
+	float y = static_cast<float>(static_cast<int>(origin.y));
+	for (const ImDrawVert& vertex : vertices) {
+		ImDrawVert& out = *list._VtxWritePtr++;
+		out = vertex;
+		out.pos.x += x;
+		out.pos.y += y;
+	}
+	for (ImDrawIdx index : indices) {
+		*list._IdxWritePtr++ = static_cast<ImDrawIdx>(base + index);
+	}
+	list._VtxCurrentIdx += vertices.Size;
+}
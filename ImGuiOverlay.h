@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IMGUI/imgui.h"
+
+// What the ImGui overlay shows: every row's text in one buffer, kept up to
+// date cell by cell as the roster changes (OverlayTable)
+struct OverlayTeam {
+	std::string title;
+	ImU32 color = IM_COL32_WHITE;
+	size_t firstRow = 0;
+	size_t rowCount = 0;
+};
+
+struct OverlayModel {
+	std::string header;
+	std::vector<std::string> columns; // titles of the cells after the name
+	std::vector<OverlayTeam> teams;   // rows [firstRow, firstRow + rowCount) in display order
+	std::vector<std::string> cells;   // row-major, the name followed by one cell per column
+
+	size_t Stride() const { return columns.size() + 1; }
+	size_t RowCount() const { return cells.size() / Stride(); }
+	const std::string& Cell(size_t row, size_t column) const { return cells[row * Stride() + column]; }
+	std::string& Cell(size_t row, size_t column) { return cells[row * Stride() + column]; }
+};
+
+// Borderless, input-free window the overlay is drawn in
+constexpr ImGuiWindowFlags overlayWindowFlags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoInputs
+	| ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing
+	| ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoBackground;
+
+// Draws an OverlayModel as a table into an ImDrawList. The text is laid out and
+// tessellated once into a private draw list and its vertices are kept, every
+// later frame only copies them into the window's list at its position. A
+// changed model, font or font size rebuilds them. Not thread-safe, use it from the
+// thread that owns the ImGui context.
+class ImGuiOverlay
+{
+public:
+	ImGuiOverlay();
+	~ImGuiOverlay();
+
+	ImGuiOverlay(const ImGuiOverlay&) = delete;
+	ImGuiOverlay& operator=(const ImGuiOverlay&) = delete;
+
+	// The model is not copied and must outlive the overlay, Invalidate after changing it
+	void SetModel(const OverlayModel& next);
+	void Invalidate() { dirty = true; }
+
+	// Draws at origin with the current ImGui font and returns the table size
+	ImVec2 Draw(ImDrawList* list, ImVec2 origin);
+	// Draws into the current window, sized for the table and kept at the right screen edge
+	void DrawWindow();
+
+	// Off lays the table out and tessellates it on every Draw, to compare against
+	bool cacheEnabled = true;
+
+	struct Stats {
+		uint64_t builds = 0;  // times the table was laid out and tessellated
+		uint64_t replays = 0; // draws served from the cached vertices
+		size_t vertices = 0;  // of the last build
+		size_t indices = 0;
+	};
+	Stats GetStats() const { return stats; }
+
+private:
+	// Lays out and tessellates the model into list, origin at the table's top left
+	ImVec2 Build(ImDrawList& list, ImVec2 origin, ImFont* font, float fontSize);
+	void Rebuild(ImFont* font, float fontSize);
+	void Replay(ImDrawList& list, ImVec2 origin) const;
+
+	const OverlayModel* model = nullptr;
+	bool dirty = true;
+	ImFont* builtFont = nullptr;
+	float builtFontSize = 0;
+	ImVec2 size{ 0, 0 };
+
+	std::unique_ptr<ImDrawList> scratch; // created with the context's shared data on first use
+	ImVector<ImDrawVert> vertices;       // relative to the table's top left
+	ImVector<ImDrawIdx> indices;         // relative to the first vertex
+	bool replayable = false;             // false when the indices would not fit ImDrawIdx
+	Stats stats;
+};
@@ -0,0 +1,356 @@
+#include "LobbyProtocol.h"
+
+#include "json.hpp"
+
+namespace {
+	nlohmann::json ResultToJson(const LookupResult& result)
+	{
+		return {
+			{ "name", result.playerName },
+			{ "tag", result.tag },
+			{ "ok", result.ok },
+			{ "wins", result.wins },
+			{ "stale", result.stale },
+			{ "httpCode", result.httpCode },
+			{ "failure", FailureName(result.failure) },
+			{ "error", result.error },
+		};
+	}
+
+	LookupResult ResultFromJson(const nlohmann::json& item)
+	{
+		LookupResult result;
+		result.playerName = item.value("name", "");
+		result.tag = item.value("tag", uint64_t{ 0 });
+		result.ok = item.value("ok", false);
+		result.wins = item.value("wins", "");
+		result.stale = item.value("stale", false);
+		result.httpCode = item.value("httpCode", 0);
+		result.failure = FailureFromName(item.value("failure", ""));
+		result.error = item.value("error", "");
+		return result;
+	}
+
+	// Field order of a result array, see LobbyProtocol.h
+	enum ResultField : size_t {
+		TagField,
+		NameField,
+		OkField,
+		WinsField,
+		StaleField,
+		HttpCodeField,
+		FailureField,
+		ErrorField,
+	};
+
+	nlohmann::json ResultToArray(const LookupResult& result)
+	{
+		return nlohmann::json::array({ result.tag, result.playerName, result.ok, result.wins, result.stale,
+			result.httpCode, static_cast<int>(result.failure), result.error });
+	}
+
+	// Fills LookupResults straight from MessagePack parse events, no DOM in
+	// between. Results are arrays at resultDepth: 1 for a single stream frame,
+	// 2 inside a batch. Fields past the known ones are skipped, so later
+	// versions can append some.
+	class ResultSax
+	{
+	public:
+		ResultSax(size_t resultDepth, std::vector<LookupResult>& results) : resultDepth(resultDepth), results(results) {}
+
+		bool null() { return Next(); }
+		bool boolean(bool value)
+		{
+			if (InResult() && field == OkField) current().ok = value;
+			if (InResult() && field == StaleField) current().stale = value;
+			return Next();
+		}
+		bool number_integer(nlohmann::json::number_integer_t value) { return Integer(static_cast<uint64_t>(value)); }
+		bool number_unsigned(nlohmann::json::number_unsigned_t value) { return Integer(value); }
+		bool number_float(nlohmann::json::number_float_t, const nlohmann::json::string_t&) { return Next(); }
+		bool string(nlohmann::json::string_t& value)
+		{
+			if (InResult() && field == NameField) current().playerName = std::move(value);
+			if (InResult() && field == WinsField) current().wins = std::move(value);
+			if (InResult() && field == ErrorField) current().error = std::move(value);
+			return Next();
+		}
+		bool binary(nlohmann::json::binary_t&) { return Next(); }
+
+		bool start_object(size_t) { return Unexpected("object"); }
+		bool key(nlohmann::json::string_t&) { return Unexpected("object"); }
+		bool end_object() { return Unexpected("object"); }
+
+		bool start_array(size_t)
+		{
+			depth++;
+			if (depth == resultDepth) {
+				results.emplace_back();
+				field = 0;
+				return true;
+			}
+			return depth < resultDepth || Unexpected("nested array");
+		}
+		bool end_array()
+		{
+			depth--;
+			return depth < resultDepth ? true : Next();
+		}
+
+		bool parse_error(size_t, const std::string&, const nlohmann::detail::exception& e)
+		{
+			error = e.what();
+			return false;
+		}
+
+		std::string error;
+
+	private:
+		bool InResult() const { return depth == resultDepth; }
+		LookupResult& current() { return results.back(); }
+
+		// Signed values arrive two's complement, which the narrowing casts undo
+		bool Integer(uint64_t value)
+		{
+			if (InResult() && field == TagField) current().tag = value;
+			if (InResult() && field == HttpCodeField) current().httpCode = static_cast<int>(value);
+			if (InResult() && field == FailureField) {
+				current().failure = value <= static_cast<uint64_t>(LookupFailure::UpstreamError)
+					? static_cast<LookupFailure>(value) : LookupFailure::UpstreamError;
+			}
+			return Next();
+		}
+
+		// A value outside a result array is not a result
+		bool Next()
+		{
+			if (depth != resultDepth) {
+				return Unexpected("value outside a result");
+			}
+			field++;
+			return true;
+		}
+
+		bool Unexpected(const char* what)
+		{
+			error = std::string("unexpected ") + what;
+			return false;
+		}
+
+		size_t resultDepth;
+		size_t depth = 0;
+		size_t field = 0;
+		std::vector<LookupResult>& results;
+	};
+
+	bool DecodeResultArrays(std::string_view data, size_t resultDepth, std::vector<LookupResult>& results, std::string& error)
+	{
+		ResultSax sax(resultDepth, results);
+		if (!nlohmann::json::sax_parse(data.begin(), data.end(), &sax, nlohmann::json::input_format_t::msgpack)) {
+			error = "Invalid MessagePack lobby data: " + sax.error;
+			return false;
+		}
+		return true;
+	}
+}
+
+std::string EncodeLobbyRequest(const LobbyRequest& request, WireFormat format)
+{
+	nlohmann::json data;
+	data["timeoutMs"] = request.timeout.count();
+	nlohmann::json& players = data["players"] = nlohmann::json::array();
+	for (const ProviderRequest& player : request.players) {
+		players.push_back({ { "name", player.playerName }, { "platform", player.platform }, { "tag", player.tag } });
+	}
+	if (format == WireFormat::Msgpack) {
+		std::vector<uint8_t> packed = nlohmann::json::to_msgpack(data);
+		return std::string(packed.begin(), packed.end());
+	}
+	return data.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+bool DecodeLobbyRequest(const std::string& body, LobbyRequest& request, std::string& error, WireFormat format)
+{
+	try {
+		auto data = format == WireFormat::Msgpack ? nlohmann::json::from_msgpack(body) : nlohmann::json::parse(body);
+		request.timeout = std::chrono::milliseconds(data.value("timeoutMs", int64_t{ 0 }));
+		for (const auto& item : data.at("players")) {
+			ProviderRequest player;
+			player.playerName = item.at("name").get<std::string>();
+			player.platform = item.at("platform").get<std::string>();
+			player.tag = item.value("tag", uint64_t{ 0 });
+			request.players.push_back(std::move(player));
+		}
+		return true;
+	}
+	catch (const nlohmann::json::exception& e) {
+		error = std::string("Invalid lobby request: ") + e.what();
+		return false;
+	}
+}
+
+std::string EncodeLookupResult(const LookupResult& result)
+{
+	return ResultToJson(result).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+bool DecodeLookupResult(const std::string& text, LookupResult& result, std::string& error)
+{
+	try {
+		result = ResultFromJson(nlohmann::json::parse(text));
+		return true;
+	}
+	catch (const nlohmann::json::exception& e) {
+		error = std::string("Invalid lookup result: ") + e.what();
+		return false;
+	}
+}
+
+std::string EncodeLobbyResults(const std::vector<LookupResult>& results, WireFormat format)
+{
+	if (format == WireFormat::Msgpack) {
+		nlohmann::json items = nlohmann::json::array();
+		for (const LookupResult& result : results) {
+			items.push_back(ResultToArray(result));
+		}
+		std::vector<uint8_t> packed = nlohmann::json::to_msgpack(items);
+		return std::string(packed.begin(), packed.end());
+	}
+
+	nlohmann::json data;
+	nlohmann::json& items = data["results"] = nlohmann::json::array();
+	for (const LookupResult& result : results) {
+		items.push_back(ResultToJson(result));
+	}
+	return data.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+bool DecodeLobbyResults(std::string_view body, std::vector<LookupResult>& results, std::string& error, WireFormat format)
+{
+	if (format == WireFormat::Msgpack) {
+		return DecodeResultArrays(body, 2, results, error);
+	}
+	try {
+		auto data = nlohmann::json::parse(body);
+		for (const auto& item : data.at("results")) {
+			results.push_back(ResultFromJson(item));
+		}
+		return true;
+	}
+	catch (const nlohmann::json::exception& e) {
+		error = std::string("Invalid lobby response: ") + e.what();
+		return false;
+	}
+}
+
+std::string EncodeLobbyEvent(const LookupResult& result, WireFormat format)
+{
+	if (format == WireFormat::Msgpack) {
+		std::vector<uint8_t> packed = nlohmann::json::to_msgpack(ResultToArray(result));
+		uint32_t length = static_cast<uint32_t>(packed.size());
+		std::string frame = { static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+			static_cast<char>(length >> 8), static_cast<char>(length) };
+		frame.append(packed.begin(), packed.end());
+		return frame;
+	}
+	return "data: " + EncodeLookupResult(result) + "\n\n";
+}
+
+std::string EncodeLobbyDone(WireFormat format)
+{
+	if (format == WireFormat::Msgpack) {
+		return std::string(4, '\0');
+	}
+	return "event: done\ndata: {}\n\n";
+}
+
+void LobbyEventParser::Feed(std::string_view data)
+{
+	pending.append(data);
+	size_t lineStart = 0;
+	size_t lineEnd;
+	while ((lineEnd = pending.find('\n', lineStart)) != std::string::npos) {
+		std::string_view line(pending.data() + lineStart, lineEnd - lineStart);
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		lineStart = lineEnd + 1;
+
+		if (line.empty()) {
+			DispatchEvent();
+			continue;
+		}
+		if (line.front() == ':') {
+			continue; // comment, used as keep-alive
+		}
+		size_t colon = line.find(':');
+		std::string_view field = line.substr(0, colon);
+		std::string_view value = colon != std::string_view::npos ? line.substr(colon + 1) : std::string_view();
+		if (!value.empty() && value.front() == ' ') {
+			value.remove_prefix(1);
+		}
+		if (field == "event") {
+			eventName = value;
+		}
+		else if (field == "data") {
+			if (!eventData.empty()) {
+				eventData += '\n';
+			}
+			eventData += value;
+		}
+	}
+	pending.erase(0, lineStart);
+}
+
+void LobbyEventParser::DispatchEvent()
+{
+	if (eventName == "done") {
+		done = true;
+	}
+	else if (!eventData.empty()) {
+		LookupResult result;
+		if (DecodeLookupResult(eventData, result, error)) {
+			onResult(result);
+		}
+	}
+	eventName.clear();
+	eventData.clear();
+}
+
+void LobbyFrameParser::Feed(std::string_view data)
+{
+	if (broken) {
+		return;
+	}
+	pending.append(data);
+	size_t offset = 0;
+	while (!done && pending.size() - offset >= 4) {
+		const auto* header = reinterpret_cast<const unsigned char*>(pending.data() + offset);
+		size_t length = (size_t{ header[0] } << 24) | (size_t{ header[1] } << 16) | (size_t{ header[2] } << 8) | header[3];
+		if (length == 0) {
+			done = true;
+			offset += 4;
+			break;
+		}
+		if (length > maxFrameBytes) {
+			// Nothing after this can be framed any more, the stream counts as cut off
+			error = "MessagePack frame of " + std::to_string(length) + " bytes is over the limit";
+			broken = true;
+			break;
+		}
+		if (pending.size() - offset - 4 < length) {
+			break;
+		}
+
+		std::vector<LookupResult> results;
+		if (DecodeResultArrays(std::string_view(pending).substr(offset + 4, length), 1, results, error) && results.size() == 1) {
+			onResult(results.front());
+		}
+		offset += 4 + length;
+	}
+	if (broken) {
+		pending.clear();
+		return;
+	}
+	pending.erase(0, offset);
+}
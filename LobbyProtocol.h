@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StatsParser.h"
+#include "StatsProvider.h"
+
+// Wire format between the plugin and the lookup daemon.
+//
+// POST /lobby
+//   {"timeoutMs": 60000, "players": [{"name": "...", "platform": "Epic", "tag": 12}, ...]}
+// 200
+//   {"results": [{"name": "...", "tag": 12, "ok": true, "wins": "6,201", "stale": false,
+//                 "httpCode": 200, "failure": "", "error": ""}, ...]}
+//
+// With "Accept: text/event-stream" the answer is a chunked server-sent event
+// stream instead, one result per event as soon as it resolves (a stale value
+// may be followed by its refreshed one), and a final "done" event:
+//   data: {"name": "...", "tag": 12, "ok": true, "wins": "6,201", ...}
+//
+//   event: done
+//   data: {}
+//
+// MessagePack instead of JSON is negotiated per request, and anything that
+// does not ask for it gets JSON as above:
+//   Content-Type: application/msgpack  the request body is the same object as MessagePack
+//   Accept: application/msgpack        results as an array of result arrays
+//   Accept: application/vnd.smurftracker.lobby-stream+msgpack
+//                                      the stream as frames, a 4 byte big-endian length
+//                                      and one result array, a zero length frame ends it
+// A result array has a fixed field order, so it decodes without keys or a DOM:
+//   [tag, name, ok, wins, stale, httpCode, failure (LookupFailure value), error]
+//
+// Names travel as UTF-8 exactly as the game reports them, tags are handed back untouched.
+enum class WireFormat {
+	Json,
+	Msgpack,
+};
+
+constexpr std::string_view jsonContentType = "application/json";
+constexpr std::string_view eventStreamContentType = "text/event-stream";
+constexpr std::string_view msgpackContentType = "application/msgpack";
+constexpr std::string_view msgpackStreamContentType = "application/vnd.smurftracker.lobby-stream+msgpack";
+
+struct LobbyRequest {
+	std::vector<ProviderRequest> players; // playerName, platform and tag set
+	std::chrono::milliseconds timeout{ 0 }; // 0 lets the daemon pick
+};
+
+std::string EncodeLobbyRequest(const LobbyRequest& request, WireFormat format = WireFormat::Json);
+bool DecodeLobbyRequest(const std::string& body, LobbyRequest& request, std::string& error, WireFormat format = WireFormat::Json);
+
+// One result as a single-line JSON object
+std::string EncodeLookupResult(const LookupResult& result);
+bool DecodeLookupResult(const std::string& text, LookupResult& result, std::string& error);
+
+std::string EncodeLobbyResults(const std::vector<LookupResult>& results, WireFormat format = WireFormat::Json);
+bool DecodeLobbyResults(std::string_view body, std::vector<LookupResult>& results, std::string& error, WireFormat format = WireFormat::Json);
+
+// Stream framing, server-sent events for Json, length-prefixed frames for Msgpack
+std::string EncodeLobbyEvent(const LookupResult& result, WireFormat format = WireFormat::Json);
+std::string EncodeLobbyDone(WireFormat format = WireFormat::Json);
+
+// Splits a lobby stream into results as bytes arrive, in pieces of any size
+class LobbyStreamParser
+{
+public:
+	using ResultCallback = std::function<void(const LookupResult&)>;
+
+	explicit LobbyStreamParser(ResultCallback onResult) : onResult(std::move(onResult)) {}
+	virtual ~LobbyStreamParser() = default;
+
+	virtual void Feed(std::string_view data) = 0;
+	bool Done() const { return done; }
+	// Last event that could not be decoded
+	const std::string& Error() const { return error; }
+
+protected:
+	ResultCallback onResult;
+	std::string pending; // bytes after the last complete event
+	std::string error;
+	bool done = false;
+};
+
+// text/event-stream
+class LobbyEventParser : public LobbyStreamParser
+{
+public:
+	using LobbyStreamParser::LobbyStreamParser;
+
+	void Feed(std::string_view data) override;
+
+private:
+	void DispatchEvent();
+
+	std::string eventName;
+	std::string eventData;
+};
+
+// MessagePack frames, each decoded straight into a LookupResult
+class LobbyFrameParser : public LobbyStreamParser
+{
+public:
+	using LobbyStreamParser::LobbyStreamParser;
+
+	void Feed(std::string_view data) override;
+
+	static constexpr size_t maxFrameBytes = 64 * 1024;
+
+private:
+	bool broken = false; // a frame length was out of range
+};
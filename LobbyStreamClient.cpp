@@ -0,0 +1,85 @@
+#include "LobbyStreamClient.h"
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "HttpMessage.h"
+#include "SocketCompat.h"
+
+namespace {
+	// A chunk carries a few events, each well under a kilobyte
+	constexpr size_t maxChunkBytes = 1024 * 1024;
+	constexpr int connectTimeoutMilliseconds = 5000;
+}
+
+bool StreamLobbyFromDaemon(const std::string& address, const LobbyRequest& lobby,
+	const LobbyStreamParser::ResultCallback& onResult, std::stop_token stop, std::string& error)
+{
+	std::string host;
+	std::string port;
+	SplitHostPort(address, "8192", host, port);
+	// An unreachable daemon gives up after the connect timeout, or at once on stop
+	SocketHandle connection = ConnectTcp(host, port, error, stop, connectTimeoutMilliseconds);
+	if (connection == invalidSocket) {
+		return false;
+	}
+
+	// Unblocks the reads below when the caller gives up, runs at once if that already happened.
+	// Reset before the close, a late stop would otherwise shut down a reused handle
+	std::optional<std::stop_callback<std::function<void()>>> closeOnStop;
+	closeOnStop.emplace(stop, [connection] { ShutdownSocket(connection); });
+	// The daemon answers within the lobby timeout, this only catches a hung connection
+	SetReceiveTimeout(connection, static_cast<int>(lobby.timeout.count()) + 30000);
+
+	std::string body = EncodeLobbyRequest(lobby);
+	std::string head = "POST /lobby HTTP/1.1\r\n"
+		"Host: " + address + "\r\n"
+		"Accept: " + std::string(msgpackStreamContentType) + ", " + std::string(eventStreamContentType) + ";q=0.5\r\n"
+		"Content-Type: application/json\r\n"
+		"Content-Length: " + std::to_string(body.size()) + "\r\n"
+		"Connection: close\r\n\r\n";
+
+	bool done = false;
+	if (!SendAll(connection, head) || !SendAll(connection, body)) {
+		error = "Cannot send lobby to " + address;
+	}
+	else {
+		std::string buffer;
+		HttpMessage response;
+		if (ReadHttpHead(connection, buffer, response) != ReadStatus::Ok) {
+			error = "No response from " + address;
+		}
+		else if (response.startLine.find(" 200 ") == std::string::npos) {
+			error = "Daemon answered " + response.startLine;
+		}
+		else {
+			// Daemons from before MessagePack ignore the first choice and send events
+			std::unique_ptr<LobbyStreamParser> parser;
+			if (response.Header("content-type").find(msgpackStreamContentType) != std::string::npos) {
+				parser = std::make_unique<LobbyFrameParser>(onResult);
+			}
+			else {
+				parser = std::make_unique<LobbyEventParser>(onResult);
+			}
+			bool chunked = IsChunked(response);
+			std::string data;
+			while (!parser->Done() && !stop.stop_requested()) {
+				ReadStatus status = chunked
+					? ReadHttpChunk(connection, buffer, data, maxChunkBytes)
+					: ReadHttpSome(connection, buffer, data);
+				if (status != ReadStatus::Ok || (chunked && data.empty())) {
+					break;
+				}
+				parser->Feed(data);
+			}
+			done = parser->Done();
+			if (!done) {
+				error = stop.stop_requested() ? "Stopped" : "Stream from " + address + " ended early";
+			}
+		}
+	}
+	closeOnStop.reset(); // waits for a callback already running on the stopping thread
+	CloseSocket(connection);
+	return done;
+}
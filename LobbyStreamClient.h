@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stop_token>
+#include <string>
+
+#include "LobbyProtocol.h"
+
+// Sends a lobby to the daemon and hands out each result the moment its event
+// arrives, as MessagePack frames or as server-sent events from older daemons.
+// Uses its own socket because HttpWrapper only reports a response once it is
+// complete. Blocks the calling thread; stopping stop abandons the connect or
+// closes the connection and returns promptly (name resolution is the one step
+// that cannot be cut short). The caller keeps a SocketLibrary alive meanwhile.
+//
+// Returns true once the daemon's done event was seen. On false, error says why
+// and onResult may already have run for some of the players.
+bool StreamLobbyFromDaemon(const std::string& address, const LobbyRequest& lobby,
+	const LobbyStreamParser::ResultCallback& onResult, std::stop_token stop, std::string& error);
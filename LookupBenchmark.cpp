@@ -0,0 +1,342 @@
+#include "LookupBenchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "json.hpp"
+#include "LobbyProtocol.h"
+#include "LookupPipeline.h"
+#include "Providers.h"
+#include "TimerThread.h"
+#include "url_encode.h"
+
+namespace {
+	using Clock = std::chrono::steady_clock;
+
+	// Answers every call like stock FlareSolverr would, after a simulated delay
+	class MockEndpointHost : public ProviderHost
+	{
+	public:
+		MockEndpointHost(const PipelineBenchmarkOptions& options)
+			: options(options)
+		{
+			std::string html = "<html><body>";
+			while (html.size() < options.mockPageBytes) {
+				html += "<div class=\"filler\">lorem ipsum dolor sit amet</div>\n";
+			}
+			html += "<table><tr><td>1,234 Wins</td><td>56 MVPs</td></tr></table></body></html>";
+
+			nlohmann::json reply;
+			reply["status"] = "ok";
+			reply["solution"]["status"] = 200;
+			reply["solution"]["response"] = html;
+			page = reply.dump();
+		}
+
+		void SendHttp(const HttpCall&, std::function<void(int, std::string)> done) override
+		{
+			calls++;
+			outstanding++;
+			std::chrono::milliseconds delay(options.mockLatencyMs);
+			{
+				std::lock_guard<std::mutex> lock(rngMutex);
+				if (options.mockJitterMs > 0) {
+					delay += std::chrono::milliseconds(std::uniform_int_distribution<int>(0, options.mockJitterMs)(rng));
+				}
+			}
+			timers.After(delay, [this, done = std::move(done)]() {
+				done(200, page);
+				outstanding--;
+				});
+		}
+
+		void SetTimeout(std::function<void()> callback, float seconds) override
+		{
+			timers.After(std::chrono::milliseconds(static_cast<int>(seconds * 1000)), std::move(callback));
+		}
+
+		void Log(const std::string&) override {}
+
+		std::atomic<size_t> calls = 0;
+		std::atomic<size_t> outstanding = 0; // calls whose answer has not been handed back yet
+
+	private:
+		const PipelineBenchmarkOptions& options;
+		std::string page;
+		std::mutex rngMutex;
+		std::mt19937 rng{ 1234 };
+		TimerThread timers;
+	};
+
+	// Display names as they show up in lobbies: ASCII, spaces, punctuation, accents, CJK, emoji
+	const char* const namePieces[] = {
+		"greenhollows", "Zen", "xX_Smurf_Xx", "Jérôme", "Müller", "ルカ", "Ñandú", "Flip Reset",
+		"Rizzo", "kaydop", "Sören", "TTV dreamer", "Ωmega", "Łukasz", "Boost Thief", "노을",
+		"[RLCS] Vatira", "Señor Ceiling", "ÄÖÜ ßtreet", "小明", "Dr. Demo #1", "whiffs & giggles",
+		"Ĉapitano", "Zoë", "ΣΠΑΡΤΗ", "Привет", "Ahmed_العربي", "🔥Aerial🔥", "~ghost~", "ceiling.shot"
+	};
+	const char* const platforms[] = { "Epic", "Steam", "PS4", "XboxOne", "Switch" };
+
+	struct LobbyTracker {
+		Clock::time_point started;
+		std::atomic<size_t> remaining;
+	};
+}
+
+namespace {
+	// The encoder this plugin shipped with, kept as the baseline
+	std::string LegacyUrlEncode(const std::string& value)
+	{
+		std::ostringstream escaped;
+		escaped.fill('0');
+		escaped << std::hex;
+		for (auto i = value.begin(); i != value.end(); ++i) {
+			std::string::value_type c = (*i);
+			if (isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.' || c == '~') {
+				escaped << c;
+			}
+			else {
+				escaped << '%' << std::setw(2) << int((unsigned char)c);
+			}
+		}
+		return escaped.str();
+	}
+
+	template <typename Fn>
+	double NanosecondsPerName(size_t iterations, Fn&& encode)
+	{
+		size_t sink = 0;
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < iterations; i++) {
+			for (const char* name : namePieces) {
+				sink += encode(name).size();
+			}
+		}
+		double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		volatile size_t keep = sink; // keep the work from being optimized away
+		(void)keep;
+		return ns / (static_cast<double>(iterations) * std::size(namePieces));
+	}
+}
+
+std::string RunUrlEncodeBenchmark(size_t iterations)
+{
+	double legacy = NanosecondsPerName(iterations, [](const std::string& name) { return LegacyUrlEncode(name); });
+	double table = NanosecondsPerName(iterations, [](const std::string& name) { return urlEncode(name); });
+	double normalized = NanosecondsPerName(iterations, [](const std::string& name) { return urlEncode(normalizeUtf8(name)); });
+
+	std::ostringstream out;
+	out.precision(1);
+	out << std::fixed << std::size(namePieces) << " names x " << iterations
+		<< " | ostringstream " << legacy << " ns/name"
+		<< " | table " << table << " ns/name"
+		<< " | normalize + table " << normalized << " ns/name";
+	return out.str();
+}
+
+std::string PipelineBenchmarkReport::ToString() const
+{
+	std::ostringstream out;
+	out.precision(1);
+	out << std::fixed
+		<< lobbies << " lobbies, " << lookups << " lookups, " << endpointCalls << " endpoint calls in " << seconds << "s"
+		<< " | " << lookupsPerSecond << " lookups/s"
+		<< " | lobby complete p50 " << p50LobbyMs << "ms p99 " << p99LobbyMs << "ms"
+		<< " | " << cachedPlayers << " cached players, " << bytesPerCachedPlayer << " B/player";
+	return out.str();
+}
+
+PipelineBenchmarkReport RunPipelineBenchmark(const PipelineBenchmarkOptions& options, std::stop_token stop)
+{
+	PipelineBenchmarkReport report;
+
+	MockEndpointHost host(options);
+	WorkerPool parsePool(options.parseThreads);
+	StatsCache cache;
+	LookupPipeline pipeline(host, parsePool, cache);
+
+	ProviderConfig config;
+	for (size_t i = 0; i < std::max<size_t>(options.endpoints, 1); i++) {
+		config.endpoints.push_back("mock-" + std::to_string(i) + ":8191");
+	}
+	config.perEndpointLimit = options.perEndpointLimit;
+	auto provider = std::make_shared<FlareSolverrProvider>(host, config);
+	pipeline.SetPacing(0.0f, provider->Capacity());
+	pipeline.SetChain({ provider });
+
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+	std::vector<ProviderRequest> seen;
+	size_t nextPlayer = 0;
+
+	std::mutex doneMutex;
+	std::condition_variable_any allDone;
+	std::vector<double> lobbyMs;
+	size_t lobbiesDone = 0;
+	std::vector<std::unique_ptr<LobbyTracker>> lobbies;
+
+	auto interval = std::chrono::duration<double>(options.lobbiesPerSecond > 0 ? 1.0 / options.lobbiesPerSecond : 0.0);
+	Clock::time_point start = Clock::now();
+
+	size_t lobbiesSent = 0;
+	for (; lobbiesSent < options.lobbies; lobbiesSent++) {
+		{
+			std::unique_lock<std::mutex> lock(doneMutex);
+			allDone.wait_until(lock, stop, start + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(lobbiesSent)),
+				[] { return false; });
+		}
+		if (stop.stop_requested()) {
+			break;
+		}
+		size_t lobby = lobbiesSent;
+
+		// 1v1 through 4v4
+		size_t players = 2 * (lobby % 4 + 1);
+		auto tracker = std::make_unique<LobbyTracker>();
+		tracker->started = Clock::now();
+		tracker->remaining = players;
+		LobbyTracker* trackerPtr = tracker.get();
+		lobbies.push_back(std::move(tracker));
+
+		for (size_t i = 0; i < players; i++) {
+			ProviderRequest request;
+			if (!seen.empty() && chance(rng) < options.repeatRatio) {
+				request = seen[std::uniform_int_distribution<size_t>(0, seen.size() - 1)(rng)];
+			}
+			else {
+				request.playerName = std::string(namePieces[nextPlayer % std::size(namePieces)]) + " " + std::to_string(nextPlayer);
+				request.platform = platforms[nextPlayer % std::size(platforms)];
+				nextPlayer++;
+				seen.push_back(request);
+			}
+			report.lookups++;
+
+			pipeline.Lookup(request, [&, trackerPtr](const LookupResult&) {
+				if (trackerPtr->remaining.fetch_sub(1) != 1) {
+					return;
+				}
+				double ms = std::chrono::duration<double, std::milli>(Clock::now() - trackerPtr->started).count();
+				std::lock_guard<std::mutex> lock(doneMutex);
+				lobbyMs.push_back(ms);
+				lobbiesDone++;
+				allDone.notify_all();
+				});
+		}
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(doneMutex);
+		allDone.wait(lock, stop, [&] { return lobbiesDone == lobbiesSent; });
+	}
+	report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	if (stop.stop_requested()) {
+		// Whatever is still on its way drops out when its answer arrives or its parse finishes, wait for those
+		pipeline.CancelAll();
+		while (host.outstanding > 0 || pipeline.Pending() > 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+	}
+	parsePool.Stop();
+
+	std::lock_guard<std::mutex> lock(doneMutex);
+	report.lobbies = lobbiesDone;
+	report.endpointCalls = host.calls;
+	report.lookupsPerSecond = report.seconds > 0 ? report.lookups / report.seconds : 0;
+	if (!lobbyMs.empty()) {
+		std::sort(lobbyMs.begin(), lobbyMs.end());
+		report.p50LobbyMs = lobbyMs[lobbyMs.size() / 2];
+		report.p99LobbyMs = lobbyMs[std::min(lobbyMs.size() - 1, lobbyMs.size() * 99 / 100)];
+	}
+	report.cachedPlayers = cache.Size();
+	report.bytesPerCachedPlayer = report.cachedPlayers > 0 ? static_cast<double>(cache.ApproxBytes()) / report.cachedPlayers : 0;
+	return report;
+}
+
+namespace {
+	// A full 4v4 lobby as the daemon answers it: mostly wins, one unknown player, one stale
+	std::vector<LookupResult> SampleLobbyResults()
+	{
+		std::vector<LookupResult> results;
+		for (size_t i = 0; i < 8; i++) {
+			LookupResult result;
+			result.playerName = namePieces[(i * 7) % std::size(namePieces)];
+			result.tag = (uint64_t{ 1 } << 32) | i;
+			result.httpCode = 200;
+			result.ok = true;
+			result.wins = std::to_string(137 + i * 1931);
+			results.push_back(std::move(result));
+		}
+		results[5].ok = false;
+		results[5].httpCode = 404;
+		results[5].wins = "Not found";
+		results[5].failure = LookupFailure::NotFound;
+		results[5].error = "Profile not found on rlstats.net";
+		results[6].stale = true;
+		return results;
+	}
+
+	template <typename Fn>
+	double NanosecondsPerResult(size_t iterations, size_t resultsPerRun, Fn&& decode)
+	{
+		size_t sink = 0;
+		Clock::time_point start = Clock::now();
+		for (size_t i = 0; i < iterations; i++) {
+			sink += decode();
+		}
+		double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+		volatile size_t keep = sink;
+		(void)keep;
+		return ns / (static_cast<double>(iterations) * resultsPerRun);
+	}
+}
+
+std::string RunWireFormatBenchmark(size_t iterations)
+{
+	std::vector<LookupResult> results = SampleLobbyResults();
+	std::string jsonBatch = EncodeLobbyResults(results, WireFormat::Json);
+	std::string msgpackBatch = EncodeLobbyResults(results, WireFormat::Msgpack);
+	std::string eventStream;
+	std::string frameStream;
+	for (const LookupResult& result : results) {
+		eventStream += EncodeLobbyEvent(result, WireFormat::Json);
+		frameStream += EncodeLobbyEvent(result, WireFormat::Msgpack);
+	}
+	eventStream += EncodeLobbyDone(WireFormat::Json);
+	frameStream += EncodeLobbyDone(WireFormat::Msgpack);
+
+	auto batch = [&](const std::string& body, WireFormat format) {
+		return NanosecondsPerResult(iterations, results.size(), [&]() {
+			std::vector<LookupResult> decoded;
+			std::string error;
+			DecodeLobbyResults(body, decoded, error, format);
+			return decoded.size();
+			});
+	};
+	auto stream = [&](const std::string& body, auto parserType) {
+		return NanosecondsPerResult(iterations, results.size(), [&]() {
+			size_t count = 0;
+			decltype(parserType) parser([&count](const LookupResult& result) { count += result.wins.size(); });
+			parser.Feed(body);
+			return count;
+			});
+	};
+	double jsonBatchNs = batch(jsonBatch, WireFormat::Json);
+	double msgpackBatchNs = batch(msgpackBatch, WireFormat::Msgpack);
+	double eventNs = stream(eventStream, LobbyEventParser(nullptr));
+	double frameNs = stream(frameStream, LobbyFrameParser(nullptr));
+
+	std::ostringstream out;
+	out.precision(1);
+	out << std::fixed << results.size() << " results x " << iterations
+		<< " | batch JSON " << jsonBatch.size() << " B " << jsonBatchNs << " ns/result"
+		<< ", MessagePack " << msgpackBatch.size() << " B " << msgpackBatchNs << " ns/result"
+		<< " | stream events " << eventStream.size() << " B " << eventNs << " ns/result"
+		<< ", MessagePack frames " << frameStream.size() << " B " << frameNs << " ns/result";
+	return out.str();
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stop_token>
+#include <string>
+
+// Synthetic load for the whole lookup path: roster ingest, pipeline scheduling,
+// cache, the real flaresolverr provider and HTML extraction, answered by an
+// in-process mock endpoint instead of FlareSolverr.
+struct PipelineBenchmarkOptions {
+	size_t lobbies = 200;
+	float lobbiesPerSecond = 20.0f;
+	float repeatRatio = 0.3f; // share of players that were already seen in an earlier lobby
+	int mockLatencyMs = 40;
+	int mockJitterMs = 20;
+	size_t mockPageBytes = 200 * 1024; // stock FlareSolverr returns the full page
+	size_t endpoints = 1;         // mock FlareSolverr instances the provider balances over
+	size_t perEndpointLimit = 8;  // requests at once per instance
+	size_t parseThreads = 0; // 0 = WorkerPool default
+};
+
+struct PipelineBenchmarkReport {
+	size_t lobbies = 0;
+	size_t lookups = 0;
+	size_t endpointCalls = 0;
+	double seconds = 0;
+	double lookupsPerSecond = 0;
+	double p50LobbyMs = 0;
+	double p99LobbyMs = 0;
+	size_t cachedPlayers = 0;
+	double bytesPerCachedPlayer = 0;
+
+	std::string ToString() const;
+};
+
+// Blocks until every lobby has been fully resolved, or stop is requested; the
+// report then covers what completed and in-flight lookups are cancelled
+PipelineBenchmarkReport RunPipelineBenchmark(const PipelineBenchmarkOptions& options, std::stop_token stop = {});
+
+// Legacy ostringstream encoder against the table-driven one over real-world names, returns a summary
+std::string RunUrlEncodeBenchmark(size_t iterations);
+
+// Decoding a 4v4 lobby's results from the daemon: JSON DOM against MessagePack
+// straight into LookupResult, batch and stream, with the bytes on the wire
+std::string RunWireFormatBenchmark(size_t iterations);
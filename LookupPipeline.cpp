@@ -0,0 +1,286 @@
+#include "LookupPipeline.h"
+#include "url_encode.h"
+
+LookupPipeline::LookupPipeline(ProviderHost& host, WorkerPool& parsePool, StatsCache& cache)
+	: host(host), parsePool(parsePool), cache(cache)
+{
+}
+
+void LookupPipeline::SetChain(std::vector<std::shared_ptr<StatsProvider>> providers)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	chain = std::move(providers);
+}
+
+void LookupPipeline::SetHedging(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	hedge = enabled;
+}
+
+void LookupPipeline::SetPacing(float spacing, size_t maxConcurrent)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	spacingSeconds = spacing;
+	maxInFlight = maxConcurrent > 0 ? maxConcurrent : 1;
+}
+
+bool LookupPipeline::PendingLookup::Wanted() const
+{
+	for (const Waiter& waiter : waiters) {
+		if (!waiter.cancel.stop_requested()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void LookupPipeline::Deliver(const std::vector<Waiter>& waiters, const LookupResult& result)
+{
+	for (const Waiter& waiter : waiters) {
+		if (!waiter.cancel.stop_requested()) {
+			waiter.sink(result);
+		}
+	}
+}
+
+void LookupPipeline::Lookup(const ProviderRequest& request, LookupSink sink)
+{
+	LookupLobby({ request }, std::move(sink));
+}
+
+void LookupPipeline::LookupLobby(const std::vector<ProviderRequest>& requests, LookupSink sink)
+{
+	std::vector<LookupResult> hits;
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (const ProviderRequest& original : requests) {
+			ProviderRequest request = original;
+			request.playerName = normalizeUtf8(original.playerName);
+			std::string key = StatsCache::Key(request.platform, request.playerName);
+
+			std::optional<StatsCache::Hit> hit = cache.Get(key);
+			if (hit) {
+				LookupResult result;
+				result.playerName = original.playerName;
+				result.tag = original.tag;
+				if (hit->failure != LookupFailure::None) {
+					result.failure = hit->failure;
+					result.wins = hit->wins;
+					result.error = "Cached failure for " + original.playerName + ": " + hit->wins;
+				}
+				else {
+					result.httpCode = 200;
+					result.ok = true;
+					result.wins = hit->wins;
+					result.stale = hit->stale;
+				}
+				hits.push_back(std::move(result));
+				if (!hit->stale) {
+					continue;
+				}
+			}
+
+			auto [it, inserted] = pending.try_emplace(key);
+			LookupSink named = [sink, playerName = original.playerName, tag = original.tag](const LookupResult& result) {
+				LookupResult copy = result;
+				copy.playerName = playerName;
+				copy.tag = tag;
+				sink(copy);
+				};
+			it->second.waiters.push_back(Waiter{ std::move(named), original.cancel });
+			if (!inserted) {
+				// Same player already queued or in flight, wait for the later of both deadlines
+				ProviderRequest& shared = it->second.request;
+				if (shared.HasDeadline() && (!request.HasDeadline() || request.deadline > shared.deadline)) {
+					shared.deadline = request.deadline;
+				}
+				if (!hit) {
+					it->second.revalidation = false; // this waiter has nothing to fall back on
+				}
+				continue;
+			}
+			request.cancel = {}; // shared by every waiter, cancellation is tracked per waiter
+			it->second.request = std::move(request);
+			it->second.revalidation = hit.has_value();
+			(hit ? revalidateQueue : queue).push_back(key);
+			queued = true;
+		}
+	}
+
+	for (const LookupResult& hit : hits) {
+		sink(hit);
+	}
+	if (queued) {
+		Pump();
+	}
+}
+
+void LookupPipeline::DropQueued()
+{
+	for (const std::string& key : queue) {
+		pending.erase(key);
+	}
+	for (const std::string& key : revalidateQueue) {
+		pending.erase(key);
+	}
+	queue.clear();
+	revalidateQueue.clear();
+}
+
+void LookupPipeline::Clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	DropQueued();
+}
+
+size_t LookupPipeline::Pending() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return pending.size();
+}
+
+void LookupPipeline::CancelAll()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	DropQueued();
+	stopSource.request_stop();
+	stopSource = std::stop_source();
+}
+
+void LookupPipeline::Pump()
+{
+	struct Launch {
+		std::string key;
+		ProviderRequest request;
+	};
+	std::vector<Launch> launches;
+	std::vector<std::vector<Waiter>> expired;
+	std::vector<std::shared_ptr<StatsProvider>> providers;
+	bool hedgeRequests;
+	std::stop_token stop;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto now = std::chrono::steady_clock::now();
+		while (inFlight < maxInFlight) {
+			// Revalidations only use capacity nobody waiting on a blank entry needs
+			std::deque<std::string>& from = !queue.empty() ? queue : revalidateQueue;
+			if (from.empty()) {
+				break;
+			}
+			std::string key = std::move(from.front());
+			from.pop_front();
+
+			auto it = pending.find(key);
+			if (it == pending.end()) {
+				continue;
+			}
+			if (!it->second.Wanted()) {
+				pending.erase(it); // everyone left before it was sent
+				continue;
+			}
+			if (it->second.request.HasDeadline() && it->second.request.deadline <= now) {
+				if (!it->second.revalidation) {
+					expired.push_back(std::move(it->second.waiters));
+				}
+				pending.erase(it);
+				continue;
+			}
+
+			launches.push_back({ key, it->second.request });
+			inFlight++;
+		}
+		providers = chain;
+		hedgeRequests = hedge;
+		stop = stopSource.get_token();
+	}
+
+	LookupResult timedOut;
+	timedOut.wins = "Timeout";
+	timedOut.error = "Lookup deadline passed before it was sent";
+	for (const std::vector<Waiter>& waiters : expired) {
+		Deliver(waiters, timedOut);
+	}
+
+	for (Launch& launch : launches) {
+		RunLookup(std::move(launch.key), std::move(launch.request), providers, hedgeRequests, stop);
+	}
+}
+
+DetachedTask LookupPipeline::RunLookup(std::string key, ProviderRequest request,
+	std::vector<std::shared_ptr<StatsProvider>> providers, bool hedgeRequests, std::stop_token stop)
+{
+	FetchResponse fetched = co_await FetchAsync(std::move(providers), host, request, hedgeRequests);
+	if (stop.stop_requested()) {
+		Complete(key, LookupResult{}, true); // dropped before parsing
+		ReleaseSlot();
+		co_return;
+	}
+
+	// Decode off the HTTP thread
+	co_await ResumeOnPool(parsePool);
+	LookupResult result;
+	if (fetched.provider) {
+		result = fetched.provider->Parse(fetched.code, fetched.body);
+	}
+	else {
+		result.wins = "Error";
+		result.error = "No stats provider configured";
+	}
+	if (stop.stop_requested()) {
+		Complete(key, LookupResult{}, true);
+		ReleaseSlot();
+		co_return;
+	}
+	Complete(key, std::move(result), false);
+
+	// The slot stays taken through the spacing, so lookups arriving meanwhile wait for it
+	float spacing;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		spacing = spacingSeconds;
+	}
+	co_await Delay(host, spacing);
+	ReleaseSlot();
+	if (!stop.stop_requested()) {
+		Pump();
+	}
+}
+
+void LookupPipeline::ReleaseSlot()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	inFlight--;
+}
+
+void LookupPipeline::Complete(const std::string& key, LookupResult result, bool drop)
+{
+	std::vector<Waiter> waiters;
+	bool revalidation = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = pending.find(key);
+		if (it != pending.end()) {
+			result.playerName = it->second.request.playerName;
+			waiters = std::move(it->second.waiters);
+			revalidation = it->second.revalidation;
+			pending.erase(it);
+		}
+	}
+	if (drop) {
+		return;
+	}
+
+	// Cached even when every waiter has left, the player may well show up again
+	if (result.ok) {
+		cache.Put(key, result.wins);
+	}
+	else if (revalidation) {
+		return; // keep showing the stale value rather than an error
+	}
+	else if (result.failure != LookupFailure::None) {
+		cache.PutFailure(key, result.failure, result.wins);
+	}
+	Deliver(waiters, result);
+}
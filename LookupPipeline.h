@@ -0,0 +1,97 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Coroutines.h"
+#include "StatsCache.h"
+#include "StatsProvider.h"
+#include "WorkerPool.h"
+
+// Called once per lookup, from the calling thread on a cache hit or from a parse worker
+using LookupSink = std::function<void(const LookupResult&)>;
+
+// Roster ingest to result: cache check, paced scheduling, hedged provider call
+// and parsing on the worker pool, each lookup running as one coroutine. Names
+// are NFC-normalized on ingest, and identical lookups that are already queued
+// or in flight share one request.
+//
+// Each request's cancel token only stops delivery to that caller: queued work
+// nobody wants any more is dropped before it is sent, while a response that is
+// already on its way is still parsed into the cache. Queued lookups whose
+// deadline has passed are answered with a timeout instead of being sent.
+//
+// A cache entry past its soft TTL is delivered at once marked stale, and a
+// revalidation is queued behind all regular lookups. Its fresh value is
+// delivered as a second result. If it fails, the stale value stays.
+// Failed lookups are cached by kind and answered from the cache without a
+// request until their negative TTL runs out.
+class LookupPipeline
+{
+public:
+	LookupPipeline(ProviderHost& host, WorkerPool& parsePool, StatsCache& cache);
+
+	void SetChain(std::vector<std::shared_ptr<StatsProvider>> providers);
+	void SetHedging(bool enabled);
+	// Gap after each completed request and how many requests may run at once
+	void SetPacing(float spacingSeconds, size_t maxInFlight);
+
+	void Lookup(const ProviderRequest& request, LookupSink sink);
+
+	// Normalizes and keys a whole lobby under one lock, sink sees the names and tags as passed in
+	void LookupLobby(const std::vector<ProviderRequest>& requests, LookupSink sink);
+
+	// Drops lookups and revalidations that have not been sent yet, in-flight ones still complete
+	void Clear();
+
+	// Clear, and in-flight lookups are dropped at their next step without parsing,
+	// caching or delivering. Nothing calls back into the caller afterwards.
+	void CancelAll();
+
+	size_t Pending() const;
+
+private:
+	struct Waiter {
+		LookupSink sink;
+		std::stop_token cancel;
+	};
+
+	struct PendingLookup {
+		ProviderRequest request;
+		std::vector<Waiter> waiters;
+		bool revalidation = false; // every waiter already has a stale value
+
+		bool Wanted() const;
+	};
+
+	void Pump();
+	void DropQueued(); // expects mutex held
+	DetachedTask RunLookup(std::string key, ProviderRequest request,
+		std::vector<std::shared_ptr<StatsProvider>> providers, bool hedgeRequests, std::stop_token stop);
+	// Unless dropped, caches the result and delivers it to waiters still interested
+	void Complete(const std::string& key, LookupResult result, bool drop);
+	// Gives the in-flight slot back, after the spacing unless the lookup was dropped
+	void ReleaseSlot();
+	static void Deliver(const std::vector<Waiter>& waiters, const LookupResult& result);
+
+	ProviderHost& host;
+	WorkerPool& parsePool;
+	StatsCache& cache;
+
+	mutable std::mutex mutex;
+	std::vector<std::shared_ptr<StatsProvider>> chain;
+	bool hedge = true;
+	float spacingSeconds = 1.0f;
+	size_t maxInFlight = 1;
+	size_t inFlight = 0;
+	std::deque<std::string> queue; // keys waiting to be sent, in order
+	std::deque<std::string> revalidateQueue; // stale keys, sent only when queue is empty
+	std::unordered_map<std::string, PendingLookup> pending; // queued or in flight
+	std::stop_source stopSource; // replaced by CancelAll
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+// Unbounded multi-producer single-consumer queue (Vyukov). Push never blocks
+// and never takes a lock, so HTTP and worker threads can hand results over
+// freely; TryPop must only ever be called from one consumer thread.
+template <typename T>
+class MpscQueue
+{
+public:
+	MpscQueue()
+	{
+		Node* stub = new Node();
+		head.store(stub, std::memory_order_relaxed);
+		tail = stub;
+	}
+
+	~MpscQueue()
+	{
+		while (Node* node = tail) {
+			tail = node->next.load(std::memory_order_relaxed);
+			delete node;
+		}
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	void Push(T value)
+	{
+		Node* node = new Node();
+		node->value.emplace(std::move(value));
+		Node* prev = head.exchange(node, std::memory_order_acq_rel);
+		prev->next.store(node, std::memory_order_release);
+	}
+
+	// Returns false when the queue is empty or a producer is midway through Push
+	bool TryPop(T& out)
+	{
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (next == nullptr) {
+			return false;
+		}
+		out = std::move(*next->value);
+		next->value.reset();
+		delete tail;
+		tail = next;
+		return true;
+	}
+
+private:
+	struct Node {
+		std::atomic<Node*> next{ nullptr };
+		std::optional<T> value;
+	};
+
+	std::atomic<Node*> head; // producers
+	Node* tail;              // consumer
+};
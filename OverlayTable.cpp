@@ -0,0 +1,192 @@
+#include "OverlayTable.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "SmurfScore.h"
+
+namespace
+{
+	constexpr OverlayColumn allColumns[] = {
+		OverlayColumn::Score,
+		OverlayColumn::Mmr,
+		OverlayColumn::Wins,
+		OverlayColumn::Smurf,
+		OverlayColumn::Met,
+	};
+
+	// Whether a column's text depends on something that differs between the two
+	bool Affected(OverlayColumn column, const OverlayPlayer& before, const OverlayPlayer& after)
+	{
+		switch (column) {
+		case OverlayColumn::Score:
+			return before.score != after.score;
+		case OverlayColumn::Mmr:
+			return before.mmr != after.mmr;
+		case OverlayColumn::Wins:
+			return before.wins != after.wins || before.winsStale != after.winsStale;
+		case OverlayColumn::Smurf:
+			return before.mmr != after.mmr || before.wins != after.wins;
+		case OverlayColumn::Met:
+			return before.encounters != after.encounters;
+		}
+		return true;
+	}
+}
+
+std::vector<OverlayColumn> ParseOverlayColumns(std::string_view list)
+{
+	std::vector<OverlayColumn> columns;
+	while (!list.empty()) {
+		size_t comma = list.find(',');
+		std::string_view name = list.substr(0, comma);
+		list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+		while (!name.empty() && name.front() == ' ') name.remove_prefix(1);
+		while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+		for (OverlayColumn column : allColumns) {
+			if (name == OverlayColumnName(column) && std::find(columns.begin(), columns.end(), column) == columns.end()) {
+				columns.push_back(column);
+			}
+		}
+	}
+	return columns;
+}
+
+std::string OverlayColumnsToString(const std::vector<OverlayColumn>& columns)
+{
+	std::string list;
+	for (OverlayColumn column : columns) {
+		if (!list.empty()) {
+			list += ',';
+		}
+		list += OverlayColumnName(column);
+	}
+	return list;
+}
+
+std::string_view OverlayColumnName(OverlayColumn column)
+{
+	switch (column) {
+	case OverlayColumn::Score: return "score";
+	case OverlayColumn::Mmr: return "mmr";
+	case OverlayColumn::Wins: return "wins";
+	case OverlayColumn::Smurf: return "smurf";
+	case OverlayColumn::Met: return "met";
+	}
+	return "";
+}
+
+std::string_view OverlayColumnTitle(OverlayColumn column)
+{
+	switch (column) {
+	case OverlayColumn::Score: return "Score";
+	case OverlayColumn::Mmr: return "MMR";
+	case OverlayColumn::Wins: return "Wins";
+	case OverlayColumn::Smurf: return "Smurf";
+	case OverlayColumn::Met: return "Met";
+	}
+	return "";
+}
+
+bool ColumnsNeedWins(const std::vector<OverlayColumn>& columns)
+{
+	return std::find(columns.begin(), columns.end(), OverlayColumn::Wins) != columns.end()
+		|| std::find(columns.begin(), columns.end(), OverlayColumn::Smurf) != columns.end();
+}
+
+bool OverlayTable::Update(const std::vector<OverlayColumn>& nextColumns, const std::string& header, std::vector<OverlayTeamInput> teams)
+{
+	bool changed = header != model.header;
+	if (changed) {
+		model.header = header;
+	}
+	if (!SameLayout(nextColumns, teams)) {
+		Rebuild(nextColumns, teams);
+		return true;
+	}
+
+	size_t row = 0;
+	for (OverlayTeamInput& team : teams) {
+		for (OverlayPlayer& next : team.players) {
+			OverlayPlayer& previous = players[row];
+			if (next.name != previous.name) {
+				model.Cell(row, 0) = next.name;
+				cellsFormatted++;
+				changed = true;
+			}
+			for (size_t column = 0; column < columns.size(); column++) {
+				if (Affected(columns[column], previous, next)) {
+					model.Cell(row, column + 1) = Format(columns[column], next);
+					changed = true;
+				}
+			}
+			previous = std::move(next);
+			row++;
+		}
+	}
+	return changed;
+}
+
+bool OverlayTable::SameLayout(const std::vector<OverlayColumn>& nextColumns, const std::vector<OverlayTeamInput>& teams) const
+{
+	if (nextColumns != columns || teams.size() != model.teams.size()) {
+		return false;
+	}
+	size_t row = 0;
+	for (size_t team = 0; team < teams.size(); team++) {
+		if (teams[team].title != model.teams[team].title || teams[team].color != model.teams[team].color
+			|| teams[team].players.size() != model.teams[team].rowCount) {
+			return false;
+		}
+		for (const OverlayPlayer& player : teams[team].players) {
+			if (player.key != players[row++].key) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void OverlayTable::Rebuild(const std::vector<OverlayColumn>& nextColumns, std::vector<OverlayTeamInput>& teams)
+{
+	columns = nextColumns;
+	model.columns.clear();
+	for (OverlayColumn column : columns) {
+		model.columns.emplace_back(OverlayColumnTitle(column));
+	}
+	model.teams.clear();
+	model.cells.clear();
+	players.clear();
+	for (OverlayTeamInput& team : teams) {
+		model.teams.push_back(OverlayTeam{ team.title, team.color, players.size(), team.players.size() });
+		for (OverlayPlayer& player : team.players) {
+			model.cells.push_back(player.name);
+			for (OverlayColumn column : columns) {
+				model.cells.push_back(Format(column, player));
+			}
+			cellsFormatted++;
+			players.push_back(std::move(player));
+		}
+	}
+}
+
+std::string OverlayTable::Format(OverlayColumn column, const OverlayPlayer& player)
+{
+	cellsFormatted++;
+	switch (column) {
+	case OverlayColumn::Score:
+		return std::to_string(player.score);
+	case OverlayColumn::Mmr:
+		return player.mmr;
+	case OverlayColumn::Wins:
+		return player.winsStale ? player.wins + "*" : player.wins; // cached value, refresh pending
+	case OverlayColumn::Smurf: {
+		int smurfScore = SmurfScore(std::atoi(player.mmr.c_str()), player.wins);
+		return smurfScore < 0 ? "-" : std::to_string(smurfScore) + "%";
+	}
+	case OverlayColumn::Met:
+		return player.encounters > 1 ? std::to_string(player.encounters) + "x" : "new";
+	}
+	return "";
+}
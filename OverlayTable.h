@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ImGuiOverlay.h"
+
+// Columns the table overlay can show, chosen with SmurfTracker_columns
+enum class OverlayColumn {
+	Score,
+	Mmr,
+	Wins,
+	Smurf,
+	Met,
+};
+
+constexpr std::string_view defaultOverlayColumns = "score,mmr,wins,smurf,met";
+
+// From a comma separated list of column names, unknown names and repeats are skipped
+std::vector<OverlayColumn> ParseOverlayColumns(std::string_view list);
+std::string OverlayColumnsToString(const std::vector<OverlayColumn>& columns);
+// Name in SmurfTracker_columns
+std::string_view OverlayColumnName(OverlayColumn column);
+// Heading in the table
+std::string_view OverlayColumnTitle(OverlayColumn column);
+// Wins and the smurf indication need a stats lookup, the other columns come from the game
+bool ColumnsNeedWins(const std::vector<OverlayColumn>& columns);
+
+// What a row's cells are formatted from
+struct OverlayPlayer {
+	uint64_t key = 0; // stable per player, PlayerHandle::Pack in the plugin
+	std::string name;
+	int score = 0;
+	std::string mmr;
+	std::string wins;
+	bool winsStale = false;
+	int encounters = 0;
+};
+
+struct OverlayTeamInput {
+	std::string title;
+	ImU32 color = IM_COL32_WHITE;
+	std::vector<OverlayPlayer> players; // display order
+};
+
+// Keeps an OverlayModel's cell buffer in step with the roster. The same players
+// in the same order only get the cells whose inputs changed formatted again;
+// different columns, players or order rebuild the buffer.
+class OverlayTable
+{
+public:
+	// True when anything in the model changed
+	bool Update(const std::vector<OverlayColumn>& nextColumns, const std::string& header, std::vector<OverlayTeamInput> teams);
+
+	const OverlayModel& Model() const { return model; }
+	uint64_t CellsFormatted() const { return cellsFormatted; }
+
+private:
+	bool SameLayout(const std::vector<OverlayColumn>& nextColumns, const std::vector<OverlayTeamInput>& teams) const;
+	void Rebuild(const std::vector<OverlayColumn>& nextColumns, std::vector<OverlayTeamInput>& teams);
+	std::string Format(OverlayColumn column, const OverlayPlayer& player);
+
+	std::vector<OverlayColumn> columns;
+	std::vector<OverlayPlayer> players; // by row, what the cells were formatted from
+	OverlayModel model;
+	uint64_t cellsFormatted = 0;
+};
@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "PluginProviderHost.h"
+
+PluginProviderHost::PluginProviderHost(std::shared_ptr<GameWrapper> gameWrapper, HttpPool& pool)
+	: gameWrapper(std::move(gameWrapper)), pool(pool)
+{
+}
+
+void PluginProviderHost::SendHttp(const HttpCall& call, std::function<void(int, std::string)> done)
+{
+	uint64_t id = pending->Add(pending->requests, done);
+	if (id == 0) {
+		done(0, "Unloaded");
+		return;
+	}
+	auto finish = [pending = pending, id](int code, std::string response) {
+		if (auto done = pending->Claim(pending->requests, id)) {
+			done(code, std::move(response));
+		}
+		};
+
+	// HttpWrapper stays in charge of https, the pool only speaks plain HTTP
+	if (poolEnabled && call.url.rfind("http://", 0) == 0) {
+		pool.Send(call, std::move(finish));
+		return;
+	}
+
+	CurlRequest req;
+	req.url = call.url;
+	req.verb = call.verb;
+	req.body = call.body;
+	for (const auto& [name, value] : call.headers) {
+		req.headers[name] = value;
+	}
+	HttpWrapper::SendCurlRequest(req, std::move(finish));
+}
+
+void PluginProviderHost::SetTimeout(std::function<void()> callback, float seconds)
+{
+	uint64_t id = pending->Add(pending->timers, callback);
+	if (id == 0) {
+		callback();
+		return;
+	}
+	// Pacing delays, hedges and failovers start on pool, HTTP and stream threads;
+	// the SDK only takes timers from the game thread, so hop there first
+	gameWrapper->Execute([pending = pending, id, seconds](GameWrapper* gw) {
+		gw->SetTimeout([pending, id](GameWrapper*) {
+			if (auto callback = pending->Claim(pending->timers, id)) {
+				callback();
+			}
+			}, seconds);
+		});
+}
+
+void PluginProviderHost::Log(const std::string& message)
+{
+	LOG("{}", message);
+}
+
+void PluginProviderHost::Shutdown()
+{
+	std::unordered_map<uint64_t, std::function<void(int, std::string)>> requests;
+	std::unordered_map<uint64_t, std::function<void()>> timers;
+	{
+		std::lock_guard<std::mutex> lock(pending->mutex);
+		pending->shutDown = true;
+		requests.swap(pending->requests);
+		timers.swap(pending->timers);
+	}
+	for (auto& [id, done] : requests) {
+		done(0, "Unloaded");
+	}
+	for (auto& [id, callback] : timers) {
+		callback();
+	}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "bakkesmod/plugin/bakkesmodplugin.h"
+#include "HttpPool.h"
+#include "StatsProvider.h"
+
+// Runs provider HTTP calls through the SDK's HttpWrapper and timers through the game.
+// Plain http:// calls go through the plugin's own HttpPool instead while that
+// is enabled, keeping connections to FlareSolverr open between lookups.
+// Every callback handed out is tracked until it runs. Shutdown (onUnload) runs
+// the ones still waiting at once, HTTP calls failing with "Unloaded", so the
+// lookups suspended on them finish; their late completions are ignored.
+class PluginProviderHost : public ProviderHost
+{
+public:
+	PluginProviderHost(std::shared_ptr<GameWrapper> gameWrapper, HttpPool& pool);
+
+	void SetPoolEnabled(bool enabled) { poolEnabled = enabled; }
+
+	void SendHttp(const HttpCall& call, std::function<void(int, std::string)> done) override;
+	void SetTimeout(std::function<void()> callback, float seconds) override;
+	void Log(const std::string& message) override;
+
+	// Runs what is still pending as cancelled, later calls are answered the same way at once
+	void Shutdown();
+
+private:
+	// Shared with the callbacks, which may outlive the host. Each callback waits
+	// here by id, so what goes to the SDK only carries the id
+	struct PendingCallbacks {
+		std::mutex mutex;
+		std::unordered_map<uint64_t, std::function<void(int, std::string)>> requests;
+		std::unordered_map<uint64_t, std::function<void()>> timers;
+		uint64_t nextId = 0;
+		bool shutDown = false;
+
+		// Takes callback and returns its id, or 0 once shut down and callback is left to the caller
+		template <typename Callback>
+		uint64_t Add(std::unordered_map<uint64_t, Callback>& into, Callback& callback)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (shutDown) {
+				return 0;
+			}
+			uint64_t id = ++nextId;
+			into.emplace(id, std::move(callback));
+			return id;
+		}
+
+		// The callback if id is still pending, empty when Shutdown already ran it
+		template <typename Callback>
+		Callback Claim(std::unordered_map<uint64_t, Callback>& from, uint64_t id)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto node = from.extract(id);
+			return node ? std::move(node.mapped()) : Callback();
+		}
+	};
+
+	std::shared_ptr<GameWrapper> gameWrapper;
+	HttpPool& pool;
+	std::atomic<bool> poolEnabled = true;
+	std::shared_ptr<PendingCallbacks> pending = std::make_shared<PendingCallbacks>();
+};
@@ -0,0 +1,343 @@
+#include "Providers.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "ContentEncoding.h"
+#include "json.hpp"
+#include "url_encode.h"
+
+namespace {
+	// Below this FlareSolverr cannot get through the challenge page anyway
+	constexpr long long minTimeoutMs = 5000;
+
+	std::string ReplaceAll(std::string text, const std::string& from, const std::string& to)
+	{
+		for (size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+			text.replace(pos, from.size(), to);
+		}
+		return text;
+	}
+
+	// The plugin's HTTP stack does not say which Content-Encoding came back, and
+	// may or may not have inflated it already, so go by the body itself. Returns
+	// response or decoded, nullptr with result marked failed when it is corrupt.
+	const std::string* DecodeIfCompressed(const std::string& response, std::string& decoded, LookupResult& result)
+	{
+		ContentEncoding encoding = SniffContentEncoding(response);
+		if (encoding == ContentEncoding::Identity) {
+			return &response;
+		}
+		if (!DecodeContent(response, encoding, decoded)) {
+			MarkFailed(result, LookupFailure::ParseFailure, "Could not decode " + std::string(ContentEncodingName(encoding)) + " reply: " + decoded);
+			return nullptr;
+		}
+		return &decoded;
+	}
+}
+
+FlareSolverrProvider::FlareSolverrProvider(ProviderHost& host, ProviderConfig config)
+	: host(host), config(std::move(config)),
+	balancer(this->config.endpoints.size(), this->config.perEndpointLimit)
+{
+	for (const std::string& endpoint : this->config.endpoints) {
+		auto it = this->config.sessions.find(endpoint);
+		idleSessions.push_back(it != this->config.sessions.end() ? it->second : std::vector<std::string>());
+	}
+	warmed.assign(this->config.endpoints.size(), false);
+}
+
+HttpCall FlareSolverrProvider::SessionCall(const std::string& endpoint, const std::string& command, const std::string& session)
+{
+	nlohmann::json data;
+	data["cmd"] = command;
+	data["session"] = session;
+
+	HttpCall call;
+	call.url = "http://" + endpoint + "/v1";
+	call.verb = "POST";
+	call.body = data.dump();
+	call.headers["Content-Type"] = "application/json";
+	return call;
+}
+
+std::string FlareSolverrProvider::ProfileUrl(const ProviderRequest& request)
+{
+	constexpr std::string_view base = "https://rlstats.net/profile/";
+	// Both branches as string_view, a std::string result would be a temporary the view outlives
+	std::string_view platform = request.platform == "XboxOne" ? std::string_view("Xbox") : std::string_view(request.platform);
+
+	std::string url;
+	url.reserve(base.size() + platform.size() + 1 + urlEncodedLength(request.playerName));
+	url += base;
+	url += platform;
+	url += '/';
+	urlEncodeAppend(url, request.playerName);
+	return url;
+}
+
+void FlareSolverrProvider::Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done)
+{
+	balancer.Acquire([this, request, done = std::move(done)](size_t endpoint) mutable {
+		// Waited for a free instance, the lookup may be over by now
+		if (request.cancel.stop_requested() || (request.HasDeadline() && request.deadline <= std::chrono::steady_clock::now())) {
+			balancer.Release(endpoint);
+			done(0, "Lookup ended while waiting for a free FlareSolverr instance");
+			return;
+		}
+		Send(endpoint, request, std::move(done));
+		});
+}
+
+void FlareSolverrProvider::Send(size_t endpoint, const ProviderRequest& request, std::function<void(int, std::string)> done)
+{
+	std::string targetUrl = ProfileUrl(request);
+
+	nlohmann::json data;
+	data["cmd"] = "request.get";
+	data["url"] = targetUrl;
+	// FlareSolverr gives up at the lookup's deadline instead of always waiting the full timeout
+	auto maxTimeout = request.Remaining(std::chrono::milliseconds(config.maxTimeoutMs));
+	data["maxTimeout"] = std::max<long long>(maxTimeout.count(), minTimeoutMs);
+
+	// A warm session skips starting a browser, without a free one FlareSolverr uses a throwaway instance
+	std::string session;
+	{
+		std::lock_guard<std::mutex> lock(sessionsMutex);
+		std::vector<std::string>& idle = idleSessions[endpoint];
+		if (!idle.empty()) {
+			session = std::move(idle.back());
+			idle.pop_back();
+		}
+	}
+	if (!session.empty()) {
+		data["session"] = session;
+	}
+
+	// Session and slot go back before the result moves on, so the next request can use them
+	done = [this, endpoint, session, done = std::move(done)](int code, std::string response) {
+		if (!session.empty()) {
+			std::lock_guard<std::mutex> lock(sessionsMutex);
+			bool warm = session == warmSessionName;
+			// A restarted instance forgets its sessions, the next probe warms a new one
+			if (warm && response.find("session does not exist") != std::string::npos) {
+				warmed[endpoint] = false;
+			}
+			else if (!warm || warmed[endpoint]) {
+				idleSessions[endpoint].push_back(session);
+			}
+		}
+		balancer.Release(endpoint);
+		if (balancer.ReportRequest(endpoint, code > 0)) {
+			LogHealthChange(endpoint, code > 0, "requests failing");
+		}
+		done(code, std::move(response));
+		};
+
+	HttpCall call;
+	call.url = "http://" + config.endpoints[endpoint] + "/v1";
+	call.verb = "POST";
+	call.body = data.dump();
+	call.headers["Content-Type"] = "application/json";
+	call.headers["Accept-Encoding"] = std::string(acceptEncodingHeader);
+
+	host.Log("Sending stats request: " + targetUrl + " via " + config.endpoints[endpoint]);
+	host.SendHttp(call, std::move(done));
+}
+
+void FlareSolverrProvider::Probe()
+{
+	// A probe may outlive the provider when the settings change meanwhile
+	std::weak_ptr<FlareSolverrProvider> weak = weak_from_this();
+	for (size_t endpoint = 0; endpoint < config.endpoints.size(); endpoint++) {
+		HttpCall call;
+		call.url = "http://" + config.endpoints[endpoint] + "/health";
+		call.timeout = std::chrono::seconds(5);
+		auto started = std::chrono::steady_clock::now();
+		host.SendHttp(call, [weak, endpoint, started](int code, std::string) {
+			if (auto self = weak.lock()) {
+				auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+				// Older FlareSolverr builds have no /health, any answer short of a server error means it is up
+				self->OnProbe(endpoint, code >= 200 && code < 500, latency, code);
+			}
+			});
+	}
+}
+
+void FlareSolverrProvider::OnProbe(size_t endpoint, bool ok, std::chrono::milliseconds latency, int code)
+{
+	if (balancer.ReportProbe(endpoint, ok, latency)) {
+		LogHealthChange(endpoint, ok, "health check returned " + std::to_string(code));
+	}
+	if (!ok) {
+		// Whatever it had warm is gone if it restarts, warm again once it is back
+		std::lock_guard<std::mutex> lock(sessionsMutex);
+		if (warmed[endpoint]) {
+			std::vector<std::string>& idle = idleSessions[endpoint];
+			idle.erase(std::remove(idle.begin(), idle.end(), warmSessionName), idle.end());
+			warmed[endpoint] = false;
+		}
+		return;
+	}
+	if (balancer.First() == endpoint) {
+		WarmUp(endpoint);
+	}
+}
+
+void FlareSolverrProvider::WarmUp(size_t endpoint)
+{
+	const std::string& address = config.endpoints[endpoint];
+	{
+		std::lock_guard<std::mutex> lock(sessionsMutex);
+		if (warmed[endpoint] || config.sessions.count(address)) {
+			return;
+		}
+		warmed[endpoint] = true;
+	}
+
+	std::weak_ptr<FlareSolverrProvider> weak = weak_from_this();
+	host.Log("Warming a FlareSolverr session on " + address);
+	host.SendHttp(SessionCall(address, "sessions.create", warmSessionName), [weak, endpoint](int code, std::string response) {
+		auto self = weak.lock();
+		if (!self) {
+			return;
+		}
+		// "Session already exists" is fine too, it is ours from an earlier run
+		nlohmann::json reply = nlohmann::json::parse(response, nullptr, false);
+		bool ok = code == 200 && reply.is_object() && reply.value("status", "") == "ok";
+		{
+			std::lock_guard<std::mutex> lock(self->sessionsMutex);
+			if (ok && self->warmed[endpoint]) {
+				self->idleSessions[endpoint].push_back(warmSessionName);
+			}
+			else {
+				self->warmed[endpoint] = false;
+			}
+		}
+		if (!ok) {
+			self->host.Log("Could not warm a session on " + self->config.endpoints[endpoint] + " (" + std::to_string(code) + ")");
+		}
+		});
+}
+
+void FlareSolverrProvider::LogHealthChange(size_t endpoint, bool ok, const std::string& detail)
+{
+	host.Log("FlareSolverr " + config.endpoints[endpoint] + (ok ? " is back in rotation" : " is out of rotation, " + detail));
+}
+
+LookupResult FlareSolverrProvider::Parse(int code, const std::string& response) const
+{
+	std::string decoded;
+	LookupResult result;
+	result.httpCode = code;
+	const std::string* body = DecodeIfCompressed(response, decoded, result);
+	return body ? ParseStatsResponse(code, *body) : result;
+}
+
+TrackerSiteProvider::TrackerSiteProvider(ProviderHost& host, ProviderConfig config)
+	: host(host), config(std::move(config))
+{
+}
+
+void TrackerSiteProvider::Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done)
+{
+	HttpCall call;
+	call.url = ReplaceAll(ReplaceAll(config.urlTemplate, "{platform}", urlEncode(request.platform)),
+		"{name}", urlEncode(request.playerName));
+	call.headers["Accept"] = "application/json";
+	call.headers["Accept-Encoding"] = std::string(acceptEncodingHeader);
+
+	host.Log("Sending tracker request: " + call.url);
+	host.SendHttp(call, std::move(done));
+}
+
+LookupResult TrackerSiteProvider::Parse(int code, const std::string& response) const
+{
+	LookupResult result;
+	result.httpCode = code;
+	if (code != 200) {
+		MarkFailed(result, FailureFromHttpCode(code), "Tracker request failed with code: " + std::to_string(code));
+		return result;
+	}
+
+	std::string decoded;
+	const std::string* body = DecodeIfCompressed(response, decoded, result);
+	if (!body) {
+		return result;
+	}
+	try {
+		auto response_data = nlohmann::json::parse(*body);
+		const auto& wins = response_data.at(nlohmann::json::json_pointer(config.winsPointer));
+		result.wins = wins.is_string() ? wins.get<std::string>() : wins.dump();
+		result.ok = true;
+	}
+	catch (const nlohmann::json::exception& e) {
+		MarkFailed(result, LookupFailure::ParseFailure, std::string("Tracker parsing error: ") + e.what());
+	}
+	return result;
+}
+
+LocalFileProvider::LocalFileProvider(ProviderHost& host, ProviderConfig config)
+	: host(host), config(std::move(config))
+{
+}
+
+void LocalFileProvider::LoadFile()
+{
+	std::ifstream file(config.filePath);
+	if (!file.is_open()) {
+		host.Log("Could not open local stats file: " + config.filePath);
+		return;
+	}
+
+	try {
+		auto data = nlohmann::json::parse(file);
+		for (const auto& [key, value] : data.items()) {
+			auto winsIt = value.find("wins");
+			if (winsIt != value.end()) {
+				wins[key] = winsIt->is_string() ? winsIt->get<std::string>() : winsIt->dump();
+			}
+		}
+	}
+	catch (const nlohmann::json::exception& e) {
+		host.Log(std::string("Local stats file parsing error: ") + e.what());
+	}
+}
+
+void LocalFileProvider::Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done)
+{
+	std::call_once(loadOnce, [this]() { LoadFile(); });
+
+	auto it = wins.find(request.platform + "/" + request.playerName);
+	if (it == wins.end()) {
+		done(404, "");
+		return;
+	}
+	done(200, it->second);
+}
+
+LookupResult LocalFileProvider::Parse(int code, const std::string& response) const
+{
+	LookupResult result;
+	result.httpCode = code;
+	if (code != 200) {
+		MarkFailed(result, LookupFailure::NotFound, "Not in local stats file");
+		return result;
+	}
+	result.ok = true;
+	result.wins = response;
+	return result;
+}
+
+void RegisterBuiltinProviders(ProviderRegistry& registry)
+{
+	registry.RegisterFactory("flaresolverr", [](ProviderHost& host, const ProviderConfig& config) {
+		return std::make_shared<FlareSolverrProvider>(host, config);
+		});
+	registry.RegisterFactory("tracker", [](ProviderHost& host, const ProviderConfig& config) {
+		return std::make_shared<TrackerSiteProvider>(host, config);
+		});
+	registry.RegisterFactory("localfile", [](ProviderHost& host, const ProviderConfig& config) {
+		return std::make_shared<LocalFileProvider>(host, config);
+		});
+}
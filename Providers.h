@@ -0,0 +1,92 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "EndpointBalancer.h"
+#include "StatsProvider.h"
+
+// rlstats.net profile pages fetched through one or more FlareSolverr instances
+// (POST /v1), balanced by outstanding requests and health
+class FlareSolverrProvider : public StatsProvider, public std::enable_shared_from_this<FlareSolverrProvider>
+{
+public:
+	FlareSolverrProvider(ProviderHost& host, ProviderConfig config);
+
+	std::string Name() const override { return "flaresolverr"; }
+	bool IsConfigured() const override { return !config.endpoints.empty(); }
+	void Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done) override;
+	LookupResult Parse(int code, const std::string& response) const override;
+
+	// Most requests all instances together take at once
+	size_t Capacity() const { return config.endpoints.size() * config.perEndpointLimit; }
+
+	// GET /health on every endpoint, feeding the balancer's health and latency.
+	// Then makes sure the endpoint the next lookup goes to has a warm session,
+	// unless the host already gave that endpoint sessions of its own.
+	void Probe();
+
+	const std::vector<std::string>& Endpoints() const { return config.endpoints; }
+	std::vector<EndpointBalancer::EndpointStatus> Health() const { return balancer.Status(); }
+
+	// Fixed, so a restarted plugin picks up the session it warmed before instead of leaking browsers
+	static constexpr const char* warmSessionName = "smurftracker-warm";
+
+	static std::string ProfileUrl(const ProviderRequest& request);
+	// sessions.create / sessions.destroy call for a FlareSolverr instance
+	static HttpCall SessionCall(const std::string& endpoint, const std::string& command, const std::string& session);
+
+private:
+	void Send(size_t endpoint, const ProviderRequest& request, std::function<void(int, std::string)> done);
+	void OnProbe(size_t endpoint, bool ok, std::chrono::milliseconds latency, int code);
+	void WarmUp(size_t endpoint);
+	void LogHealthChange(size_t endpoint, bool ok, const std::string& detail);
+
+	ProviderHost& host;
+	ProviderConfig config;
+	EndpointBalancer balancer;
+	std::mutex sessionsMutex;
+	std::vector<std::vector<std::string>> idleSessions; // by endpoint, each session serves one request at a time
+	std::vector<bool> warmed; // by endpoint, warm session created or on its way
+};
+
+// Any tracker site with a JSON API, queried with a plain GET
+class TrackerSiteProvider : public StatsProvider
+{
+public:
+	TrackerSiteProvider(ProviderHost& host, ProviderConfig config);
+
+	std::string Name() const override { return "tracker"; }
+	bool IsConfigured() const override { return !config.urlTemplate.empty(); }
+	void Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done) override;
+	LookupResult Parse(int code, const std::string& response) const override;
+
+private:
+	ProviderHost& host;
+	ProviderConfig config;
+};
+
+// Answers from a local JSON file: { "Epic/playername": { "wins": "123" }, ... }
+class LocalFileProvider : public StatsProvider
+{
+public:
+	LocalFileProvider(ProviderHost& host, ProviderConfig config);
+
+	std::string Name() const override { return "localfile"; }
+	bool IsConfigured() const override { return !config.filePath.empty(); }
+	void Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done) override;
+	LookupResult Parse(int code, const std::string& response) const override;
+
+private:
+	void LoadFile();
+
+	ProviderHost& host;
+	ProviderConfig config;
+	std::once_flag loadOnce;
+	std::map<std::string, std::string> wins; // "platform/name" -> wins
+};
+
+// Registers flaresolverr, tracker and localfile
+void RegisterBuiltinProviders(ProviderRegistry& registry);
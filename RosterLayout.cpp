@@ -0,0 +1,81 @@
+#include "RosterLayout.h"
+
+#include <algorithm>
+
+namespace
+{
+	// Reference units, a 1080 pixel high screen, scaled with the screen height
+	constexpr float referenceHeight = 1080.0f;
+	constexpr float headerScale = 2.0f;
+	constexpr float headerHeight = 60.0f;
+	constexpr float textScale = 1.5f;
+	constexpr float titleHeight = 50.0f;
+	constexpr float rowHeight = 49.0f;
+	constexpr float teamGap = 38.0f;
+	constexpr float blockCenter = 520.0f; // around the middle of the in-game scoreboard
+	constexpr float rightInset = 480.0f;  // left edge of the overlay, from the right screen edge
+	constexpr float columnGap = 24.0f;
+	constexpr float margin = 20.0f;
+
+	const LayoutColor white{ 255, 255, 255, 255 };
+}
+
+std::vector<DrawCommand> BuildRosterLayout(const LayoutRequest& request, const MeasureText& measure)
+{
+	std::vector<DrawCommand> commands;
+	float width = static_cast<float>(std::max(request.width, 1));
+	float unit = static_cast<float>(std::max(request.height, 1)) / referenceHeight;
+
+	float headerX = width - rightInset * unit;
+	float headerSize = headerScale * unit;
+	headerX = std::max(0.0f, std::min(headerX, width - margin * unit - measure(request.header, headerSize)));
+	commands.push_back(DrawCommand{ headerX, 0, headerSize, white, request.header });
+
+	if (request.teams.empty()) {
+		return commands;
+	}
+
+	// Shrink the whole block when it does not fit between the header and the bottom edge
+	size_t rowCount = 0;
+	for (const LayoutTeam& team : request.teams) {
+		rowCount += team.rows.size();
+	}
+	float natural = request.teams.size() * titleHeight + rowCount * rowHeight + (request.teams.size() - 1) * teamGap;
+	float available = referenceHeight - margin - headerHeight;
+	float fit = std::min(1.0f, available / natural);
+	float blockHeight = natural * fit;
+	float top = std::clamp(blockCenter - blockHeight / 2, headerHeight, referenceHeight - margin - blockHeight);
+
+	// Column widths across every team, so names and values line up
+	float size = textScale * fit * unit;
+	float nameWidth = 0;
+	float valueWidth = measure(request.valueTitle, size);
+	for (const LayoutTeam& team : request.teams) {
+		nameWidth = std::max(nameWidth, measure(team.title, size));
+		for (const LayoutRow& row : team.rows) {
+			nameWidth = std::max(nameWidth, measure(row.name, size));
+			valueWidth = std::max(valueWidth, measure(row.value, size));
+		}
+	}
+	float gap = columnGap * unit;
+	float x = width - rightInset * unit;
+	if (x + nameWidth + gap + valueWidth > width - margin * unit) {
+		x = std::max(margin * unit, width - margin * unit - nameWidth - gap - valueWidth);
+	}
+	float valueX = x + nameWidth + gap;
+
+	commands.reserve(1 + request.teams.size() * 2 + rowCount * 2);
+	float y = top * unit;
+	for (const LayoutTeam& team : request.teams) {
+		commands.push_back(DrawCommand{ x, y, size, team.color, team.title });
+		commands.push_back(DrawCommand{ valueX, y, size, team.color, request.valueTitle });
+		y += titleHeight * fit * unit;
+		for (const LayoutRow& row : team.rows) {
+			commands.push_back(DrawCommand{ x, y, size, white, row.name });
+			commands.push_back(DrawCommand{ valueX, y, size, white, row.value });
+			y += rowHeight * fit * unit;
+		}
+		y += teamGap * fit * unit;
+	}
+	return commands;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Overlay layout for any number of teams of any size at any resolution. The
+// layout is computed from the roster once and replayed as plain draw commands
+// every frame until the roster, the mode or the screen size changes.
+struct LayoutColor {
+	float r = 255;
+	float g = 255;
+	float b = 255;
+	float a = 255;
+};
+
+struct DrawCommand {
+	float x = 0;
+	float y = 0;
+	float scale = 1; // text scale, the same on both axes
+	LayoutColor color;
+	std::string text;
+	bool dropShadow = true;
+};
+
+struct LayoutRow {
+	std::string name;
+	std::string value;
+};
+
+struct LayoutTeam {
+	std::string title;
+	LayoutColor color;
+	std::vector<LayoutRow> rows;
+};
+
+struct LayoutRequest {
+	int width = 1920;
+	int height = 1080;
+	std::string header;
+	std::string valueTitle; // heads the value column on every team's title row
+	std::vector<LayoutTeam> teams; // stacked top to bottom
+};
+
+// Width in pixels of text drawn at scale
+using MeasureText = std::function<float(const std::string& text, float scale)>;
+
+// Names and values get a column each, aligned across all teams. Teams are
+// stacked around the middle of the screen, rows shrink when they would not
+// fit between the header and the bottom edge, and the block moves left when
+// a long name would run off the right edge.
+std::vector<DrawCommand> BuildRosterLayout(const LayoutRequest& request, const MeasureText& measure);
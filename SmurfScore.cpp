@@ -0,0 +1,45 @@
+#include "SmurfScore.h"
+
+#include <algorithm>
+
+namespace
+{
+	// About how many wins a typical account has by the time it reaches an MMR,
+	// roughly linear from Bronze (~200) up to Grand Champion
+	constexpr double winsPerMmr = 1.2;
+	constexpr int mmrFloor = 200;
+	constexpr double minimumExpectedWins = 50;
+}
+
+std::optional<int> ParseWinsCount(std::string_view wins)
+{
+	int count = 0;
+	bool digits = false;
+	for (char c : wins) {
+		if (c >= '0' && c <= '9') {
+			if (count > 100000000) {
+				return std::nullopt;
+			}
+			count = count * 10 + (c - '0');
+			digits = true;
+		}
+		else if (c != ',' && c != '.' && c != ' ' && c != '*') {
+			return std::nullopt;
+		}
+	}
+	if (!digits) {
+		return std::nullopt;
+	}
+	return count;
+}
+
+int SmurfScore(int mmr, std::string_view wins)
+{
+	std::optional<int> count = ParseWinsCount(wins);
+	if (mmr <= 0 || !count) {
+		return -1;
+	}
+	double expected = std::max(minimumExpectedWins, (mmr - mmrFloor) * winsPerMmr);
+	double score = 100.0 * (1.0 - *count / expected);
+	return static_cast<int>(std::clamp(score, 0.0, 100.0));
+}
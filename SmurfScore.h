@@ -0,0 +1,13 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+
+// Career wins from their display text ("6,201"), nothing for placeholders like
+// "Searching..." or a failure text
+std::optional<int> ParseWinsCount(std::string_view wins);
+
+// Rough 0-100 indication that an account has far fewer career wins than its
+// rank usually takes, -1 while the MMR or the wins are not known. Not a
+// verdict, a fast learner or an old offline account scores high too.
+int SmurfScore(int mmr, std::string_view wins);
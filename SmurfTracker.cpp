@@ -1,8 +1,11 @@
 #include "pch.h"
 #include "SmurfTracker.h"
-#include "json.hpp"
+#include <cmath>
 #include <set>
-#include "url_encode.h"
+#include "StatsParser.h"
+#include "Providers.h"
+#include "LobbyStreamClient.h"
+#include "LookupBenchmark.h"
 
 BAKKESMOD_PLUGIN(SmurfTracker, "Identify Smurfs.", plugin_version, PLUGINTYPE_FREEPLAY)
 
@@ -37,24 +40,133 @@ void SmurfTracker::onLoad()
 		LOG("Failed to open log file!");
 	}
 
+	parsePool = std::make_unique<WorkerPool>();
+	httpPool = std::make_unique<HttpPool>();
+	providerHost = std::make_unique<PluginProviderHost>(gameWrapper, *httpPool);
+	RegisterBuiltinProviders(providerRegistry);
+	lookupPipeline = std::make_unique<LookupPipeline>(*providerHost, *parsePool, statsCache);
+
+	// Team and PRI hooks arrive in bursts while a match loads, each kind of work runs once per burst
+	hookWork = std::make_unique<EventCoalescer<HookWork>>([this, unloaded = unloadSource.get_token()](std::function<void()> callback, float seconds) {
+		gameWrapper->SetTimeout([unloaded, callback = std::move(callback)](GameWrapper* gw) {
+			if (!unloaded.stop_requested()) {
+				callback();
+			}
+			}, seconds);
+		});
+	hookWork->Define(HookWork::Roster, std::chrono::milliseconds(200), std::chrono::milliseconds(1000), [this]() {
+		InitializeCurrentPlayers();
+		});
+	hookWork->Define(HookWork::Scores, std::chrono::milliseconds(100), std::chrono::milliseconds(500), [this]() {
+		UpdatePlayerList();
+		});
+	hookWork->Define(HookWork::Fetch, std::chrono::milliseconds(250), std::chrono::milliseconds(1000), [this]() {
+		HTTPRequest();
+		});
+
+	// Stats cache from earlier sessions, next to the log file
+	std::string cacheError;
+	if (!statsCache.Load(statsCachePath, cacheError)) {
+		LOG("{}", cacheError);
+	}
+
 	// Register the render function to be called each frame
 	gameWrapper->RegisterDrawable([this](CanvasWrapper canvas) {
 		Render(canvas);
 		});
+
+	// The ImGui overlay is this plugin's window, opened with the scoreboard; it never takes input
+	menuTitle_ = "SmurfTracker overlay";
+	windowFlags_ = overlayWindowFlags;
+	imguiOverlay.SetModel(overlayTable.Model());
+	overlayColumns.Publish(ParseOverlayColumns(defaultOverlayColumns));
 	
 	cvarManager->registerCvar("SmurfTracker_enabled", "0", "Enable SmurfTracker Plugin", true, true, 0, true, 1)
 		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
 		smurfTrackerEnabled = cvar.getBoolValue();
+		ShowImGuiOverlay(ImGuiOverlayWanted());
 	});
 
 	cvarManager->registerCvar("SmurfTracker_mode", "0", "SmurfTracker selected mode", true, true, 0, true, 2)
 		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
 		selectedMode = cvar.getIntValue();
+		FetchIfWinsNeeded();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_overlay", "0", "Overlay drawn with 0 the canvas (one mode), 1 ImGui (the columns in SmurfTracker_columns)", true, true, 0, true, 1)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		imguiOverlayEnabled = cvar.getIntValue() == 1;
+		ShowImGuiOverlay(ImGuiOverlayWanted());
+		FetchIfWinsNeeded();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_columns", std::string(defaultOverlayColumns), "Columns of the ImGui overlay, any of score,mmr,wins,smurf,met", true)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		overlayColumns.Publish(ParseOverlayColumns(cvar.getStringValue()));
+		FetchIfWinsNeeded();
 	});
 
-	cvarManager->registerCvar("SmurfTracker_ip", "127.0.0.1", "IP Address for SmurfTracker endpoint", true, true, 0, true, 15)
+	cvarManager->registerCvar("SmurfTracker_overlay_cache", "1", "Keep the ImGui overlay's vertices between frames, rebuilt when the roster changes", true, true, 0, true, 1)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		imguiOverlayCache = cvar.getBoolValue();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_cache_soft_ttl", "30", "Minutes until cached wins are shown as stale and refreshed in the background", true, true, 0)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ApplyCacheTtl();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_cache_hard_ttl", "10080", "Minutes until cached wins are no longer shown at all", true, true, 0)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ApplyCacheTtl();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_cache_negative_ttl", "10", "Minutes a not found, unreadable or failed lookup is remembered (endpoint errors at most 1)", true, true, 0)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ApplyCacheTtl();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_ip", "127.0.0.1", "FlareSolverr endpoints, comma separated host or host:port (port 8191 if omitted, IPv6 in brackets)")
 		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
 		ipAddress = cvar.getStringValue();
+		ConfigureProviders();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_endpoint_concurrency", "1", "Requests at once per FlareSolverr endpoint", true, true, 1, true, 8)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ConfigureProviders();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_http_pool", "1", "Send http:// lookups over the plugin's own kept-alive connections instead of BakkesMod's HTTP", true, true, 0, true, 1)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		providerHost->SetPoolEnabled(cvar.getBoolValue());
+	});
+
+	cvarManager->registerCvar("SmurfTracker_daemon", "", "host:port of a SmurfTrackerDaemon to send whole lobbies to, empty looks players up directly");
+
+	cvarManager->registerCvar("SmurfTracker_providers", "flaresolverr", "Comma separated stats providers, primary first (flaresolverr, tracker, localfile)")
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ConfigureProviders();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_hedging", "1", "Ask the next provider when the primary is slower than its p95", true, true, 0, true, 1)
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		lookupPipeline->SetHedging(cvar.getBoolValue());
+	});
+
+	cvarManager->registerCvar("SmurfTracker_tracker_url", "", "Tracker site URL with {platform} and {name} placeholders")
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ConfigureProviders();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_tracker_wins_pointer", "/wins", "JSON pointer to the wins value in a tracker reply")
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ConfigureProviders();
+	});
+
+	cvarManager->registerCvar("SmurfTracker_local_stats_file", "", "Local JSON stats file for the localfile provider")
+		.addOnValueChanged([this](std::string oldValue, CVarWrapper cvar) {
+		ConfigureProviders();
 	});
 
 	cvarManager->registerCvar("SmurfTracker_check_teammates", "1", "Check teammates stats", true, true, 0, true, 1)
@@ -75,60 +187,176 @@ void SmurfTracker::onLoad()
 		HTTPRequest();
 		}, "", PERMISSION_ALL);
 
+	// SmurfTracker_bench_urlencode [iterations]
+	cvarManager->registerNotifier("SmurfTracker_bench_urlencode", [this](std::vector<std::string> args) {
+		size_t iterations = 20000;
+		try {
+			if (args.size() > 1) iterations = std::stoul(args[1]);
+		}
+		catch (const std::exception&) {
+			LOG("Usage: SmurfTracker_bench_urlencode [iterations]");
+			return;
+		}
+		LOG("Url encode benchmark: {}", RunUrlEncodeBenchmark(iterations));
+		}, "Benchmark url encoding over real-world player names", PERMISSION_ALL);
+
+	// SmurfTracker_bench_wire [iterations]
+	cvarManager->registerNotifier("SmurfTracker_bench_wire", [this](std::vector<std::string> args) {
+		size_t iterations = 20000;
+		try {
+			if (args.size() > 1) iterations = std::stoul(args[1]);
+		}
+		catch (const std::exception&) {
+			LOG("Usage: SmurfTracker_bench_wire [iterations]");
+			return;
+		}
+		LOG("Wire format benchmark: {}", RunWireFormatBenchmark(iterations));
+		}, "Benchmark decoding daemon results as JSON and as MessagePack", PERMISSION_ALL);
+
+	// Average CPU time per frame of each overlay path since the last call, then starts over
+	cvarManager->registerNotifier("SmurfTracker_overlay_stats", [this](std::vector<std::string> args) {
+		auto report = [](const char* name, OverlayTiming& timing) {
+			uint64_t frames = timing.frames.exchange(0);
+			uint64_t nanoseconds = timing.nanoseconds.exchange(0);
+			LOG("{} overlay: {} frames, {:.1f} us/frame", name, frames, frames ? nanoseconds / 1000.0 / frames : 0.0);
+			};
+		report("Canvas", canvasTiming);
+		report("ImGui", imguiTiming);
+		ImGuiOverlay::Stats stats = imguiOverlay.GetStats();
+		LOG("ImGui overlay: {} builds, {} replays, {} vertices, {} indices, {} cells formatted",
+			stats.builds, stats.replays, stats.vertices, stats.indices, cellsFormatted.load());
+		}, "Log the time per frame spent drawing the canvas and the ImGui overlay", PERMISSION_ALL);
+
+	// SmurfTracker_bench_pipeline [lobbies] [lobbies/s] [repeat ratio] [mock latency ms] [endpoints] [per endpoint]
+	cvarManager->registerNotifier("SmurfTracker_bench_pipeline", [this](std::vector<std::string> args) {
+		RunPipelineBenchmark(args);
+		}, "Benchmark the lookup pipeline against a mock endpoint", PERMISSION_ALL);
+
 	// Hook into the OnAllTeamsCreated event to log when all teams are created	
 	//gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.OnAllTeamsCreated", [this](std::string eventName) {
 	//	LOG("Initialize Game Session");
 	//	cvarManager->executeCommand("InitializeCurrentPlayers");
 	//	});
 
+	ConfigureProviders();
+	ApplyCacheTtl();
+	ScheduleHealthProbe();
+	ScheduleScorePoll();
+
+	// The plugin may be loaded in the middle of a match
+	RefreshGameState();
+
+	// Kickoffs re-check the state too, they also catch freeplay resets and rejoined matches
+	gameWrapper->HookEvent("Function GameEvent_Soccar_TA.Active.StartRound", [this](std::string eventName) {
+		RefreshGameState();
+		});
+
+	// Leaving a match, freeplay or replay destroys its game event
+	gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.Destroyed", [this](std::string eventName) {
+		SetGameState(GameState::Menu);
+		});
+
 	gameWrapper->HookEvent("Function TAGame.Team_TA.PostBeginPlay", [this](std::string eventName) {
 		LOG("Initialize Game Session");
-		cvarManager->executeCommand("InitializeCurrentPlayers");
+		RefreshGameState();
+		hookWork->Request(HookWork::Roster);
+		});
+
+	// A player joining, leaving for a team or switching sides
+	gameWrapper->HookEvent("Function TAGame.PRI_TA.OnTeamChanged", [this](std::string eventName) {
+		hookWork->Request(HookWork::Roster);
 		});
 
 	// Hook into the OnOpenScoreboard event to display player IDs when the scoreboard is opened
 	gameWrapper->HookEvent("Function TAGame.GFxData_GameEvent_TA.OnOpenScoreboard", [this](std::string eventName) {
 		isSBOpen = true;
-		UpdatePlayerList();
+		hookWork->Request(HookWork::Scores);
+		ServerWrapper sw = CurrentServer();
+		if (!sw.IsNull() && !RosterCoversServer(sw)) {
+			hookWork->Request(HookWork::Roster);
+		}
+		ShowImGuiOverlay(ImGuiOverlayWanted());
+		});
+
+	// Goals, saves, assists, shots and demos change a match score, the ticker reports them for every player
+	gameWrapper->HookEvent("Function TAGame.GFxHUD_TA.HandleStatTickerMessage", [this](std::string eventName) {
+		hookWork->Request(HookWork::Scores);
 		});
 
 	// Hook into the OnCloseScoreboard event to log a message when the scoreboard is closeds
 	gameWrapper->HookEvent("Function TAGame.GFxData_GameEvent_TA.OnCloseScoreboard", [this](std::string eventName) {
 		isSBOpen = false;
+		ShowImGuiOverlay(false);
 		});
 
 	// Hook into the OnMatchEnded event to remove cached player details
 	gameWrapper->HookEvent("Function TAGame.GameEvent_Soccar_TA.OnMatchEnded", [this](std::string eventName) {
 		LOG("Finalize Game Session");
+		SetGameState(GameState::MatchEnded);
 		ClearCurrentPlayers();
 		});
 }
 
+void SmurfTracker::RefreshGameState()
+{
+	if (gameWrapper->IsInReplay()) {
+		SetGameState(GameState::Replay);
+	}
+	else if (gameWrapper->IsInFreeplay()) {
+		SetGameState(GameState::Freeplay);
+	}
+	else if (gameWrapper->IsInOnlineGame()) {
+		// A match that ended stays ended until its game event goes away
+		ServerWrapper sw = gameWrapper->GetOnlineGame();
+		SetGameState(!sw.IsNull() && sw.GetbMatchEnded() ? GameState::MatchEnded : GameState::OnlineMatch);
+	}
+	else {
+		SetGameState(GameState::Menu);
+	}
+}
+
+void SmurfTracker::SetGameState(GameState next)
+{
+	if (next != gameState) {
+		DEBUGLOG("Game state {} -> {}", static_cast<int>(gameState), static_cast<int>(next));
+		gameState = next;
+	}
+}
+
+ServerWrapper SmurfTracker::CurrentServer()
+{
+	switch (gameState) {
+	case GameState::Freeplay:
+		return gameWrapper->GetGameEventAsServer();
+	case GameState::OnlineMatch:
+	case GameState::MatchEnded:
+		return gameWrapper->GetOnlineGame();
+	default:
+		return ServerWrapper(NULL);
+	}
+}
+
 void SmurfTracker::InitializeCurrentPlayers()
 {
 	if (!smurfTrackerEnabled) {
 		return;
 	}
 
-	// Clear any existing players
-	currentPlayers.clear();
+	// Players still in the match keep their slot, handle and fetched stats
+	std::shared_ptr<const RosterSnapshot> previous = roster.Load();
 
-	// Check if the game is valid
-	if (!gameWrapper->IsInOnlineGame() && !gameWrapper->IsInFreeplay() || gameWrapper->IsInReplay()) {
+	// Check if the game is valid, the old players are cleared only then
+	if (!InLiveGame()) {
 		LOG("Not in an online game or freeplay!");
+		roster.Publish(RosterSnapshot{});
 		return;
 	}
 
-	ServerWrapper sw = NULL;
-	if (gameWrapper->IsInFreeplay()) {
-		sw = gameWrapper->GetGameEventAsServer();
-	}
-	else {
-		sw = gameWrapper->GetOnlineGame();
-	}
+	ServerWrapper sw = CurrentServer();
 
 	if (sw.IsNull() || sw.GetbMatchEnded()) {
 		LOG("Invalid game state or match ended!");
+		roster.Publish(RosterSnapshot{});
 		return;
 	}
 
@@ -138,6 +366,21 @@ void SmurfTracker::InitializeCurrentPlayers()
 	// Initialize a map to store unique IDs and corresponding player details
 	std::map<std::string, PlayerDetails> uniqueIDMap;
 
+	std::map<std::string, const PlayerDetails*> previousByID;
+	for (const PlayerDetails& player : previous->players) {
+		if (player.occupied) {
+			previousByID[player.uniqueID] = &player;
+		}
+	}
+
+	// Start from the previous slots so returning players keep their handles
+	RosterSnapshot next;
+	next.players = previous->players;
+	for (PlayerDetails& slot : next.players) {
+		slot.occupied = false;
+	}
+	std::vector<PlayerDetails> arrivals;
+
 	// Get the array of players
 	ArrayWrapper<PriWrapper> players = sw.GetPRIs();
 
@@ -156,6 +399,8 @@ void SmurfTracker::InitializeCurrentPlayers()
 		details.uniqueID = uniqueIDString; // Unique ID format: Platform|UniqueID|PlayerIndex
 		details.playerIndex = static_cast<int>(i);  // Assuming i is the player index
 		details.team = playerWrapper.GetTeamNum();  // 0 is blue, 1 is orange 11
+		details.pri = playerWrapper.memory_address;
+		details.currentScore = playerWrapper.GetMatchScore();
 		details.mmr = std::to_string(static_cast<int>(std::round(gameWrapper->GetMMRWrapper().GetPlayerMMR(playerWrapper.GetUniqueIdWrapper(), 11))));// 11 is playlist ID for ranked 2v2
 		details.wins = "Waiting..."; // Default value	
 
@@ -166,6 +411,7 @@ void SmurfTracker::InitializeCurrentPlayers()
 		// Check for valid separators
 		if (firstSeparator == std::string::npos || secondSeparator == std::string::npos || firstSeparator >= secondSeparator) {
 			LOG("Invalid unique ID format: " + uniqueIDString);
+			next.skippedPris.push_back(playerWrapper.memory_address);
 			continue; // Skip this player if the unique ID format is not as expected
 		}
 
@@ -184,305 +430,649 @@ void SmurfTracker::InitializeCurrentPlayers()
 				details = uniqueIDMap[uniqueIDPart];
 				// Log the splitscreen relationship
 				LOG("Splitscreen player of main player at index " + std::to_string(details.playerIndex));
-				continue;
 			}
 			else {
 				LOG("Main player's details not found for splitscreen player: " + uniqueIDString);
-				continue;
 			}
+			next.skippedPris.push_back(playerWrapper.memory_address);
+			continue;
 		}
 
-		// Add the player details to the currentPlayers vector
-		currentPlayers.push_back(details);
+		arrivals.push_back(details);
 	}
 
-	UpdateTeamStrings();
+	// Add the player details to the new roster, returning players first so
+	// newcomers only get slots that nobody still in the match holds
+	std::vector<bool> slotTaken(next.players.size(), false);
+	for (PlayerDetails& details : arrivals) {
+		auto known = previousByID.find(details.uniqueID);
+		if (known == previousByID.end()) {
+			continue;
+		}
+		details.handle = known->second->handle;
+		details.requested = known->second->requested;
+		details.wins = known->second->wins;
+		details.winsStale = known->second->winsStale;
+		details.encounters = known->second->encounters;
+		details.occupied = true;
+		slotTaken[details.handle.slot] = true;
+		next.players[details.handle.slot] = details;
+	}
+	for (PlayerDetails& details : arrivals) {
+		if (details.occupied) {
+			continue;
+		}
+		uint32_t slot = 0;
+		while (slot < slotTaken.size() && slotTaken[slot]) {
+			slot++;
+		}
+		if (slot == slotTaken.size()) {
+			next.players.emplace_back();
+			slotTaken.push_back(false);
+		}
+		details.handle = PlayerHandle{ slot, ++lastGeneration };
+		details.encounters = ++encounterCounts[details.uniqueID];
+		details.occupied = true;
+		slotTaken[slot] = true;
+		next.players[slot] = details;
+	}
 
-	int currentMode = cvarManager->getCvar("SmurfTracker_mode").getIntValue();
-	if (currentMode == 2) {
-		HTTPRequest();
+	UpdateTeamOrder(next);
+	next.SortTeamsByScore();
+
+	// Lookups for players who left are not delivered any more (their results still reach the cache)
+	for (const auto& [uniqueID, player] : previousByID) {
+		const PlayerDetails* stayed = next.Find(player->handle);
+		if (stayed == nullptr) {
+			CancelPlayerLookups(player->handle);
+		}
+	}
+
+	roster.Publish(std::move(next));
+
+	if (WinsNeeded()) {
+		hookWork->Request(HookWork::Fetch);
+	}
+}
+
+bool SmurfTracker::WinsNeeded() const
+{
+	return imguiOverlayEnabled ? ColumnsNeedWins(*overlayColumns.Load()) : selectedMode == 2;
+}
+
+void SmurfTracker::FetchIfWinsNeeded()
+{
+	if (WinsNeeded() && InLiveGame()) {
+		hookWork->Request(HookWork::Fetch);
 	}
 }
 
 void SmurfTracker::ClearCurrentPlayers()
 {
-	currentPlayers.clear();
+	roster.Publish(RosterSnapshot{});
+	ShowImGuiOverlay(false);
+
+	// Nothing left to refresh, a burst still waiting would only find the match gone
+	hookWork->CancelAll();
+	for (HookWork work : { HookWork::Roster, HookWork::Scores, HookWork::Fetch }) {
+		EventCoalescer<HookWork>::Counts counts = hookWork->GetCounts(work);
+		DEBUGLOG("Hook work {}: {} requests, {} runs", static_cast<int>(work), counts.requests, counts.runs);
+	}
+
+	// Match over: stop delivering to this roster and drop what has not been sent yet
+	for (auto& [handle, source] : playerCancels) {
+		source.request_stop();
+	}
+	playerCancels.clear();
+	lookupPipeline->Clear();
+	// Stopped streams wind down within a connect poll or a read, they are joined off the game thread
+	auto stoppedStreams = std::make_shared<std::vector<std::jthread>>(std::move(daemonStreams));
+	daemonStreams.clear();
+	for (std::jthread& stream : *stoppedStreams) {
+		stream.request_stop();
+	}
+
+	// Persist what this match taught us, off the game thread
+	parsePool->Submit([this, stoppedStreams]() {
+		stoppedStreams->clear();
+		SaveStatsCache();
+		});
 }
 
-void SmurfTracker::UpdatePlayerList() {
-	ServerWrapper sw = NULL;
-	if (gameWrapper->IsInFreeplay()) {
-		sw = gameWrapper->GetGameEventAsServer();
+void SmurfTracker::ApplyCacheTtl()
+{
+	int softMinutes = cvarManager->getCvar("SmurfTracker_cache_soft_ttl").getIntValue();
+	int hardMinutes = cvarManager->getCvar("SmurfTracker_cache_hard_ttl").getIntValue();
+	int negativeMinutes = cvarManager->getCvar("SmurfTracker_cache_negative_ttl").getIntValue();
+	statsCache.SetTtl(std::chrono::minutes(std::max(softMinutes, 0)), std::chrono::minutes(std::max(hardMinutes, 0)));
+	statsCache.SetNegativeTtl(std::chrono::minutes(std::max(negativeMinutes, 0)));
+}
+
+void SmurfTracker::SaveStatsCache()
+{
+	std::string error;
+	if (!statsCache.Save(statsCachePath, error)) {
+		LOG("{}", error);
 	}
-	else {
-		sw = gameWrapper->GetOnlineGame();
+}
+
+void SmurfTracker::CancelPlayerLookups(PlayerHandle handle)
+{
+	auto it = playerCancels.find(handle.Pack());
+	if (it != playerCancels.end()) {
+		it->second.request_stop();
+		playerCancels.erase(it);
 	}
+}
+
+std::chrono::steady_clock::time_point SmurfTracker::LookupDeadline(ServerWrapper& sw) const
+{
+	// A result is only worth waiting for while it can still be shown, plus a little
+	// grace for the post-match scoreboard. Overtime has no known end, use the cap.
+	constexpr std::chrono::seconds maxLookupTime(60);
+	constexpr std::chrono::seconds matchEndGrace(15);
+
+	std::chrono::seconds budget = maxLookupTime;
+	if (!sw.GetbOverTime()) {
+		budget = std::min(budget, std::chrono::seconds(std::max(sw.GetSecondsRemaining(), 0)) + matchEndGrace);
+	}
+	return std::chrono::steady_clock::now() + budget;
+}
+
+void SmurfTracker::UpdatePlayerList() {
+	ServerWrapper sw = CurrentServer();
 
 	if (sw.IsNull() || sw.GetbMatchEnded()) {
 		LOG("Invalid game state or match ended!");
 		return;
 	}
 
-	if (currentPlayers.size() < 1) {
-		InitializeCurrentPlayers();
-		return;
-	}
+	std::shared_ptr<const RosterSnapshot> current = roster.Load();
 
-	if (currentPlayers.size() < sw.GetPRIs().Count()) {
-		InitializeCurrentPlayers();
+	// Only scores are read here; joins and leaves reach the roster through the team and scoreboard hooks
+	if (current->playerCount < 1) {
 		return;
 	}
 
-	// Get the array of players
+	// Read every score once, players are matched by their PRI rather than by name or ID string
 	ArrayWrapper<PriWrapper> players = sw.GetPRIs();
-
-	// perform sanity check for player count and expected player count
-	std::set<std::string> playerNamesSet(blueTeam.begin(), blueTeam.end());
-	playerNamesSet.insert(orangeTeam.begin(), orangeTeam.end());
-
-	bool allPlayersFound = true;
+	std::vector<std::pair<uint32_t, int>> changed; // slot, new score
 	for (size_t i = 0; i < players.Count(); ++i) {
 		PriWrapper priw = players.Get(i);
 		if (priw.IsNull()) continue;
 
-		std::string playerName = priw.GetPlayerName().ToString();
-		if (playerNamesSet.find(playerName) == playerNamesSet.end()) {
-			allPlayersFound = false;
-			break;
+		const PlayerDetails* known = nullptr;
+		for (const PlayerDetails& player : current->players) {
+			if (player.occupied && player.pri == priw.memory_address) {
+				known = &player;
+				break;
+			}
+		}
+		if (known == nullptr) {
+			continue; // skipped by the rebuild, or joined since
+		}
+		int score = priw.GetMatchScore();
+		if (score != known->currentScore) {
+			changed.emplace_back(known->handle.slot, score);
 		}
 	}
-	if (!allPlayersFound) {
-		LogF("Connected Players:" + std::to_string(currentPlayers.size()) + "/" + std::to_string(players.Count()) + " (Not all players found!)");
-		InitializeCurrentPlayers();
-		return;
+	if (changed.empty()) {
+		return; // Render keeps the version it has
 	}
 
-	// Update the current scores of the players
-	for (PlayerDetails& player : currentPlayers) {
-		for (size_t i = 0; i < players.Count(); ++i) {
-			PriWrapper priw = players.Get(i);
-			if (priw.IsNull()) continue;
+	roster.Update([&](RosterSnapshot& next) {
+		for (const auto& [slot, score] : changed) {
+			next.players[slot].currentScore = score;
+		}
+		next.SortTeamsByScore();
+		});
+}
 
-			UniqueIDWrapper uidw = priw.GetUniqueIdWrapper();
-			std::string uidString = uidw.GetIdString();
-			if (uidString == player.uniqueID) {
-				player.currentScore = priw.GetMatchScore();
-				break;  // Exit the inner loop as we've found the matching player
-			}
+void SmurfTracker::ScheduleScorePoll()
+{
+	gameWrapper->SetTimeout([this, unloaded = unloadSource.get_token()](GameWrapper* gw) {
+		if (unloaded.stop_requested()) {
+			return;
+		}
+		if (smurfTrackerEnabled && InLiveGame() && roster.Load()->playerCount > 0) {
+			hookWork->Request(HookWork::Scores);
 		}
+		ScheduleScorePoll();
+		}, scorePollSeconds);
+}
+
+PlayerDetails* RosterSnapshot::Find(PlayerHandle handle) {
+	if (handle.slot >= players.size()) {
+		return nullptr;
 	}
+	PlayerDetails& player = players[handle.slot];
+	return player.occupied && player.handle == handle ? &player : nullptr;
+}
 
-	// Sort the players by team and score	
-	std::sort(currentPlayers.begin(), currentPlayers.end(), [](const PlayerDetails& a, const PlayerDetails& b) {
-		if (a.team == b.team) {
-			return a.currentScore > b.currentScore;  // Sort by currentScore within the same team
+const PlayerDetails* RosterSnapshot::Find(PlayerHandle handle) const {
+	return const_cast<RosterSnapshot*>(this)->Find(handle);
+}
+
+bool RosterSnapshot::Knows(uintptr_t pri) const {
+	for (const PlayerDetails& player : players) {
+		if (player.occupied && player.pri == pri) {
+			return true;
 		}
-		return a.team < b.team;  // Sort by team (Blue before Orange)
-		});
+	}
+	return std::find(skippedPris.begin(), skippedPris.end(), pri) != skippedPris.end();
+}
 
-	UpdateTeamStrings();
+bool SmurfTracker::RosterCoversServer(ServerWrapper& sw) const {
+	std::shared_ptr<const RosterSnapshot> current = roster.Load();
+	ArrayWrapper<PriWrapper> players = sw.GetPRIs();
+	for (size_t i = 0; i < players.Count(); i++) {
+		PriWrapper priw = players.Get(i);
+		if (!priw.IsNull() && !current->Knows(priw.memory_address)) {
+			return false;
+		}
+	}
+	return true;
 }
 
-void SmurfTracker::UpdateTeamStrings() {
-	blueTeam.clear();
-	orangeTeam.clear();
+void RosterSnapshot::SortTeamsByScore() {
+	// Slots themselves never move, and a team already in order is left alone
+	auto byScore = [this](uint32_t a, uint32_t b) {
+		return players[a].currentScore > players[b].currentScore;
+		};
+	for (std::vector<uint32_t>* team : { &blueTeam, &orangeTeam }) {
+		if (!std::is_sorted(team->begin(), team->end(), byScore)) {
+			std::stable_sort(team->begin(), team->end(), byScore);
+		}
+	}
+}
+
+void SmurfTracker::UpdateTeamOrder(RosterSnapshot& snapshot) {
+	snapshot.blueTeam.clear();
+	snapshot.orangeTeam.clear();
+	snapshot.playerCount = 0;
 
-	for (const auto& player : currentPlayers) {
+	for (const auto& player : snapshot.players) {
+		if (!player.occupied) {
+			continue;
+		}
+		snapshot.playerCount++;
 		if (player.team == 0) {
-			blueTeam.push_back(player.playerName);
+			snapshot.blueTeam.push_back(player.handle.slot);
 		}
 		else if (player.team == 1) {
-			orangeTeam.push_back(player.playerName);
+			snapshot.orangeTeam.push_back(player.handle.slot);
 		}
 	}
 }
 
 void SmurfTracker::HTTPRequest()
 {
-	ServerWrapper sw = NULL;
-	if (gameWrapper->IsInFreeplay()) {
-		sw = gameWrapper->GetGameEventAsServer();
-	}
-	else {
-		sw = gameWrapper->GetOnlineGame();
-	}
+	ServerWrapper sw = CurrentServer();
 
 	if (sw.IsNull() || sw.GetbMatchEnded()) {
 		LOG("Invalid game state or match ended!");
 		return;
 	}
 
-	if (currentPlayers.size() < sw.GetPRIs().Count()) {
-		InitializeCurrentPlayers();
+	if (!RosterCoversServer(sw)) {
+		hookWork->Request(HookWork::Roster);
 		return;
 	}
 
-	auto processPlayer = std::make_shared<std::function<void(std::shared_ptr<std::set<std::string>>)>>();
-
-	*processPlayer = [this, processPlayer](std::shared_ptr<std::set<std::string>> processedPlayers) {
-		for (auto& player : currentPlayers) {
-			if (processedPlayers->count(player.playerName)) {
-				continue; // Skip already processed players
+	// Mark everyone not yet requested in one roster version, then hand them to the pipeline
+	auto deadline = LookupDeadline(sw);
+	std::vector<ProviderRequest> requests;
+	roster.Update([&](RosterSnapshot& next) {
+		for (auto& player : next.players) {
+			if (!player.occupied || player.requested) {
+				continue; // Skip departed players and players that have already been requested
 			}
-			if (player.requested) {
-				continue; // Skip players that have already been requested
+			player.requested = true;
+			player.wins = "Searching...";
+			player.winsStale = false;
+			ProviderRequest request{ player.playerName, player.platform, player.handle.Pack() };
+			request.deadline = deadline;
+			request.cancel = playerCancels[player.handle.Pack()].get_token();
+			requests.push_back(std::move(request));
+		}
+		});
+
+	for (const ProviderRequest& request : requests) {
+		LOG("Requesting stats for: " + request.playerName);
+	}
+	if (requests.empty()) {
+		return;
+	}
+
+	std::string daemon = cvarManager->getCvar("SmurfTracker_daemon").getStringValue();
+	if (!daemon.empty()) {
+		LookupViaDaemon(daemon, std::move(requests), deadline);
+		return;
+	}
+	lookupPipeline->LookupLobby(requests, [this](const LookupResult& result) {
+		PushResult(result);
+		});
+}
+
+void SmurfTracker::LookupViaDaemon(const std::string& address, std::vector<ProviderRequest> requests, std::chrono::steady_clock::time_point deadline)
+{
+	// The whole lobby in one request, the daemon does the pacing and caching and
+	// streams each player back as soon as it resolves
+	LobbyRequest lobby;
+	lobby.players = requests;
+	lobby.timeout = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+
+	// One stream per batch of newly seen players, all of them end with the match
+	daemonStreams.emplace_back([this, address, lobby = std::move(lobby), requests = std::move(requests)](std::stop_token stop) {
+		std::set<uint64_t> answered;
+		std::string error;
+		bool complete = StreamLobbyFromDaemon(address, lobby, [&](const LookupResult& result) {
+			answered.insert(result.tag);
+			PushResult(result);
+			}, stop, error);
+		if (complete || stop.stop_requested()) {
+			return;
+		}
+
+		// Daemon down or gone mid-stream, look up whoever is still missing directly
+		std::vector<ProviderRequest> missing;
+		for (const ProviderRequest& request : requests) {
+			if (!answered.count(request.tag)) {
+				missing.push_back(request);
 			}
+		}
+		LOG("SmurfTracker daemon: {}, looking up {} players directly", error, missing.size());
+		lookupPipeline->LookupLobby(missing, [this](const LookupResult& result) {
+			PushResult(result);
+			});
+		});
+}
 
-			processedPlayers->insert(player.playerName);
-			player.requested = true;
+void SmurfTracker::PushResult(const LookupResult& result)
+{
+	lookupResults.Push(result);
+	ScheduleResultDrain();
+}
 
-			std::string ipAddress = cvarManager->getCvar("SmurfTracker_ip").getStringValue();
-			std::string url = "http://" + ipAddress + ":8191/v1";
-			std::string platform = player.platform == "XboxOne" ? "Xbox" : player.platform;
-			std::string playerName = player.playerName;
-			std::string targetUrl = "https://rlstats.net/profile/" + platform + "/" + urlEncode(playerName);
-			player.wins = "Searching...";
-			LOG("Requesting stats for: " + playerName);
-
-			nlohmann::json data;
-			data["cmd"] = "request.get";
-			data["url"] = targetUrl;
-			data["maxTimeout"] = 60000;
-
-			LOG(getCurrentTime() + " Sending stats request: " + targetUrl);
-
-			CurlRequest req;
-			req.url = url;
-			req.body = data.dump();
-			req.headers["Content-Type"] = "application/json";
-
-			auto weakProcessPlayer = std::weak_ptr<std::function<void(std::shared_ptr<std::set<std::string>>)>>
-				(processPlayer);
-
-			HttpWrapper::SendCurlRequest(req, [this, weakProcessPlayer, processedPlayers, playerName](int code, std::string response) {
-				if (auto processPlayer = weakProcessPlayer.lock()) {
-					if (code == 200) {
-						try {
-							auto response_data = nlohmann::json::parse(response);
-							std::string wins = response_data["wins"];
-							for (auto& p : currentPlayers) {
-								if (p.playerName == playerName) {
-									p.wins = wins;
-									LOG(playerName + " - Wins: " + wins);
-									break;
-								}
-							}
-						}
-						catch (const nlohmann::json::exception& e) {
-							LOG(std::string("JSON parsing error: ") + e.what());
-							for (auto& p : currentPlayers) {
-								if (p.playerName == playerName) {
-									p.wins = "Error";
-									break;
-								}
-							}
-						}
-					}
-					else {
-						LOG("Request failed with code: " + std::to_string(code));
-						for (auto& p : currentPlayers) {
-							if (p.playerName == playerName) {
-								p.wins = "Error: " + std::to_string(code);
-								break;
-							}
-						}
-					}
-
-					gameWrapper->SetTimeout([processPlayer, processedPlayers](...) {
-						(*processPlayer)(processedPlayers);
-						}, 1.0f);
-				}
-				});
+void SmurfTracker::ConfigureProviders()
+{
+	std::map<std::string, ProviderConfig> configs;
+
+	ProviderConfig& flaresolverr = configs["flaresolverr"];
+	flaresolverr.endpoints = ParseEndpointList(cvarManager->getCvar("SmurfTracker_ip").getStringValue(), 8191);
+	flaresolverr.perEndpointLimit = std::max(cvarManager->getCvar("SmurfTracker_endpoint_concurrency").getIntValue(), 1);
+
+	ProviderConfig& tracker = configs["tracker"];
+	tracker.urlTemplate = cvarManager->getCvar("SmurfTracker_tracker_url").getStringValue();
+	tracker.winsPointer = cvarManager->getCvar("SmurfTracker_tracker_wins_pointer").getStringValue();
+
+	ProviderConfig& localFile = configs["localfile"];
+	localFile.filePath = cvarManager->getCvar("SmurfTracker_local_stats_file").getStringValue();
+
+	// In-flight lookups keep their own references to the previous chain
+	std::string order = cvarManager->getCvar("SmurfTracker_providers").getStringValue();
+	std::vector<std::shared_ptr<StatsProvider>> chain = providerRegistry.BuildChain(order, *providerHost, configs);
+	std::shared_ptr<FlareSolverrProvider> flareSolverrProvider;
+	for (const std::shared_ptr<StatsProvider>& provider : chain) {
+		if (auto candidate = std::dynamic_pointer_cast<FlareSolverrProvider>(provider)) {
+			flareSolverrProvider = candidate;
+		}
+	}
+	// New endpoints are checked right away instead of by the first lookup
+	if (flareSolverrProvider) {
+		flareSolverrProvider->Probe();
+	}
+	flareSolverr.store(flareSolverrProvider);
+	LOG("Stats providers: " + order + " (" + std::to_string(chain.size()) + " active, "
+		+ std::to_string(flaresolverr.endpoints.size()) + " FlareSolverr endpoints)");
+	lookupPipeline->SetChain(std::move(chain));
+	// Every slot pauses a second after its lookup, FlareSolverr struggles with bursts;
+	// the slots grow with the endpoints so each container adds its share
+	lookupPipeline->SetPacing(1.0f, std::max<size_t>(flaresolverr.endpoints.size(), 1) * flaresolverr.perEndpointLimit);
+	// The pooled connections to each endpoint follow the same setting as its balancer
+	httpPool->SetPerHostLimit(flaresolverr.perEndpointLimit);
+}
 
-			break; // Exit after sending the request for the first player found
+void SmurfTracker::ScheduleHealthProbe()
+{
+	gameWrapper->SetTimeout([this, unloaded = unloadSource.get_token()](GameWrapper* gw) {
+		if (unloaded.stop_requested()) {
+			return;
 		}
-		};
+		// Only between matches, in a match the lookups themselves report how their endpoint does
+		std::shared_ptr<FlareSolverrProvider> provider = flareSolverr.load();
+		if (provider && !gw->IsInOnlineGame() && !gw->IsInGame()) {
+			provider->Probe();
+		}
+		ScheduleHealthProbe();
+		}, healthProbeSeconds);
+}
+
+void SmurfTracker::RunPipelineBenchmark(const std::vector<std::string>& args)
+{
+	if (benchmarkThread.joinable()) {
+		benchmarkThread.join();
+	}
+
+	PipelineBenchmarkOptions options;
+	try {
+		if (args.size() > 1) options.lobbies = std::stoul(args[1]);
+		if (args.size() > 2) options.lobbiesPerSecond = std::stof(args[2]);
+		if (args.size() > 3) options.repeatRatio = std::stof(args[3]);
+		if (args.size() > 4) options.mockLatencyMs = std::stoi(args[4]);
+		if (args.size() > 5) options.endpoints = std::stoul(args[5]);
+		if (args.size() > 6) options.perEndpointLimit = std::stoul(args[6]);
+	}
+	catch (const std::exception&) {
+		LOG("Usage: SmurfTracker_bench_pipeline [lobbies] [lobbies/s] [repeat ratio] [mock latency ms] [endpoints] [per endpoint]");
+		return;
+	}
+
+	LOG("Running pipeline benchmark...");
+	// Off the game thread, the report is logged back on it
+	benchmarkThread = std::thread([gameWrapper = gameWrapper, options, unloaded = unloadSource.get_token()]() {
+		PipelineBenchmarkReport report = ::RunPipelineBenchmark(options, unloaded);
+		if (unloaded.stop_requested()) {
+			return;
+		}
+		gameWrapper->Execute([report](GameWrapper* gw) {
+			LOG("Pipeline benchmark: {}", report.ToString());
+			});
+		});
+}
 
-	auto processedPlayers = std::make_shared<std::set<std::string>>();
-	(*processPlayer)(processedPlayers);
+void SmurfTracker::ScheduleResultDrain()
+{
+	// One pending drain at a time, producers racing in after it starts schedule the next one
+	if (drainScheduled.exchange(true)) {
+		return;
+	}
+	gameWrapper->Execute([this, unloaded = unloadSource.get_token()](GameWrapper* gw) {
+		if (!unloaded.stop_requested()) {
+			DrainResults();
+		}
+		});
+}
+
+void SmurfTracker::DrainResults()
+{
+	drainScheduled.store(false);
+
+	std::vector<LookupResult> results;
+	LookupResult result;
+	while (lookupResults.TryPop(result)) {
+		results.push_back(std::move(result));
+	}
+	if (results.empty()) {
+		return;
+	}
+
+	// One roster version for the whole batch, each result lands in its slot directly
+	roster.Update([&](RosterSnapshot& next) {
+		for (const LookupResult& r : results) {
+			if (r.ok) {
+				LOG(r.playerName + " - Wins: " + r.wins);
+			}
+			else {
+				LOG(r.error);
+			}
+
+			PlayerDetails* player = next.Find(PlayerHandle::Unpack(r.tag));
+			if (player == nullptr) {
+				LOG("Dropping result for departed player: " + r.playerName);
+				continue;
+			}
+			player->wins = r.wins;
+			player->winsStale = r.stale;
+		}
+		});
 }
 
 void SmurfTracker::Render(CanvasWrapper canvas)
 {
-	if (!smurfTrackerEnabled || !isSBOpen || (!gameWrapper->IsInOnlineGame() && !gameWrapper->IsInFreeplay()) || gameWrapper->IsInReplay()) {
+	if (!smurfTrackerEnabled || !isSBOpen || !InLiveGame() || imguiOverlayEnabled) {
 		return;
 	}
+	auto start = std::chrono::steady_clock::now();
+
+	// Lay out again only when something the layout depends on changed, every other frame replays it
+	std::shared_ptr<const RosterSnapshot> snapshot = roster.Load();
+	Vector2 screen = canvas.GetSize();
+	if (snapshot != laidOutRoster || selectedMode != laidOutMode || screen.X != laidOutScreen.X || screen.Y != laidOutScreen.Y) {
+		overlayCommands = LayoutOverlay(*snapshot, selectedMode, canvas);
+		laidOutRoster = std::move(snapshot);
+		laidOutMode = selectedMode;
+		laidOutScreen = screen;
+	}
 
-	// selected mode to display
-	int currentMode = cvarManager->getCvar("SmurfTracker_mode").getIntValue();
+	for (const DrawCommand& command : overlayCommands) {
+		canvas.SetColor(LinearColor{ command.color.r, command.color.g, command.color.b, command.color.a });
+		canvas.SetPosition(Vector2F{ command.x, command.y });
+		canvas.DrawString(command.text, command.scale, command.scale, command.dropShadow);
+	}
+	canvasTiming.Add(start);
+}
+
+std::vector<DrawCommand> SmurfTracker::LayoutOverlay(const RosterSnapshot& snapshot, int mode, CanvasWrapper& canvas)
+{
 	const char* items[] = { "Score", "MMR", "Wins" }; // Modes
-	LinearColor white{ 255, 255, 255, 255 };
-	LinearColor blue{ 0, 0, 255, 255 };
-	LinearColor orange{ 255, 165, 0, 255 };
-
-	int bluePos[3] = { 380, 429, 478 };
-	int orangePos[3] = { 615, 663, 710 };
-
-	if (currentPlayers.size() <= 2) {
-		bluePos[0] = 488;
-		orangePos[0] = 615;
-	}
-	if (currentPlayers.size() <= 4 && currentPlayers.size() > 2) {
-		bluePos[0] = 435;
-		bluePos[1] = 483;
-		orangePos[0] = 615;
-		orangePos[1] = 663;
-	}
-	if (currentPlayers.size() > 4) {
-		bluePos[0] = 380;
-		bluePos[1] = 429;
-		bluePos[2] = 478;
-		orangePos[0] = 615;
-		orangePos[1] = 663;
-		orangePos[2] = 710;
-	}
-
-	// Map for quick lookup of player details by name
-	std::unordered_map<std::string, PlayerDetails> playerDetailsMap;
-	for (const auto& player : currentPlayers) {
-		playerDetailsMap[player.playerName] = player;
-	}
-
-	// Display header information
-	canvas.SetColor(white);
-	canvas.SetPosition(Vector2(1440, 0));
-	canvas.DrawString("Connected Players: " + std::to_string(currentPlayers.size()) + " Mode: " + items[currentMode], 2.0, 2.0, true, true);
-
-	auto drawTeam = [&](const std::vector<std::string>& team, const LinearColor& color, int* positions) {
-		canvas.SetColor(color);
-		std::string teamName = (color == blue) ? "Blue:" : "Orange:";
-		canvas.SetPosition(Vector2(1440, positions[0] - 50));
-		canvas.DrawString(teamName, 1.5, 1.5, true);
-
-		canvas.SetColor(white);
-		int index = 0;
-		for (const auto& player : team) {
-			auto it = playerDetailsMap.find(player);
-			if (it != playerDetailsMap.end()) {
-				const auto& playerDetails = it->second;
-				std::string displayString = player;
-				if (currentMode == 0) {
-					displayString += " - Score: " + std::to_string(playerDetails.currentScore);
-				}
-				else if (currentMode == 1) {
-					displayString += " - MMR: " + playerDetails.mmr;
-				}
-				else if (currentMode == 2) {
-					displayString += " - Wins: " + playerDetails.wins;
+	mode = std::clamp(mode, 0, 2);
+
+	LayoutRequest request;
+	Vector2 screen = canvas.GetSize();
+	request.width = screen.X;
+	request.height = screen.Y;
+	request.header = "Connected Players: " + std::to_string(snapshot.playerCount) + " Mode: " + items[mode];
+	request.valueTitle = items[mode];
+
+	auto addTeam = [&](const std::vector<uint32_t>& slots, std::string title, LayoutColor color) {
+		LayoutTeam& team = request.teams.emplace_back();
+		team.title = std::move(title);
+		team.color = color;
+		for (uint32_t slot : slots) {
+			const PlayerDetails& playerDetails = snapshot.players[slot];
+			LayoutRow& row = team.rows.emplace_back();
+			row.name = playerDetails.playerName;
+			if (mode == 0) {
+				row.value = std::to_string(playerDetails.currentScore);
+			}
+			else if (mode == 1) {
+				row.value = playerDetails.mmr;
+			}
+			else {
+				row.value = playerDetails.wins;
+				if (playerDetails.winsStale) {
+					row.value += "*"; // cached value, refresh pending
 				}
-				canvas.SetPosition(Vector2(1440, positions[index]));
-				canvas.DrawString(displayString, 1.5, 1.5, true);
-				index++;
 			}
 		}
 		};
+	addTeam(snapshot.blueTeam, "Blue:", LayoutColor{ 0, 0, 255, 255 });
+	addTeam(snapshot.orangeTeam, "Orange:", LayoutColor{ 255, 165, 0, 255 });
+
+	return BuildRosterLayout(request, [&canvas](const std::string& text, float scale) {
+		return canvas.GetStringSize(text, scale, scale).X;
+		});
+}
+
+bool SmurfTracker::UpdateOverlayTable(const RosterSnapshot& snapshot, const std::vector<OverlayColumn>& columns)
+{
+	auto team = [&](const std::vector<uint32_t>& slots, std::string title, ImU32 color) {
+		OverlayTeamInput input{ std::move(title), color, {} };
+		input.players.reserve(slots.size());
+		for (uint32_t slot : slots) {
+			const PlayerDetails& player = snapshot.players[slot];
+			input.players.push_back(OverlayPlayer{ player.handle.Pack(), player.playerName, player.currentScore,
+				player.mmr, player.wins, player.winsStale, player.encounters });
+		}
+		return input;
+		};
+	std::vector<OverlayTeamInput> teams;
+	teams.push_back(team(snapshot.blueTeam, "Blue", IM_COL32(0, 0, 255, 255)));
+	teams.push_back(team(snapshot.orangeTeam, "Orange", IM_COL32(255, 165, 0, 255)));
+	bool changed = overlayTable.Update(columns, "Connected Players: " + std::to_string(snapshot.playerCount), std::move(teams));
+	cellsFormatted = overlayTable.CellsFormatted();
+	return changed;
+}
+
+void SmurfTracker::ShowImGuiOverlay(bool show)
+{
+	if (show == imguiOverlayShown) {
+		return;
+	}
+	imguiOverlayShown = show;
+	cvarManager->executeCommand((show ? "openmenu " : "closemenu ") + GetMenuName());
+}
 
-	drawTeam(blueTeam, blue, bluePos);
-	drawTeam(orangeTeam, orange, orangePos);
+void SmurfTracker::RenderWindow()
+{
+	// The window may still be open for a frame after the plugin was disabled
+	if (!smurfTrackerEnabled) {
+		return;
+	}
+	auto start = std::chrono::steady_clock::now();
+	std::shared_ptr<const RosterSnapshot> snapshot = roster.Load();
+	std::shared_ptr<const std::vector<OverlayColumn>> columns = overlayColumns.Load();
+	if (snapshot != overlayRoster || columns != overlayColumnsShown) {
+		if (UpdateOverlayTable(*snapshot, *columns)) {
+			imguiOverlay.Invalidate();
+		}
+		overlayRoster = std::move(snapshot);
+		overlayColumnsShown = std::move(columns);
+	}
+	imguiOverlay.cacheEnabled = imguiOverlayCache;
+	imguiOverlay.DrawWindow();
+	imguiTiming.Add(start);
+}
+
+bool SmurfTracker::ShouldBlockInput()
+{
+	return false;
+}
+
+void SmurfTracker::OverlayTiming::Add(std::chrono::steady_clock::time_point start)
+{
+	frames++;
+	nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
 }
 
 void SmurfTracker::onUnload()
 {
+	// From here on late completions and timers return without touching the plugin
+	unloadSource.request_stop();
+	// The streams run plugin code and must be gone before it unloads; stopped, each
+	// returns within a connect poll (50 ms) or its closed socket's read
+	daemonStreams.clear();
+	// Lookups resumed from here on drop out at their next step without delivering
+	lookupPipeline->CancelAll();
+	httpPool->Stop(); // fails what is in flight, the lookups waiting on it finish
+	providerHost->Shutdown(); // curl replies and timers still pending resume their lookups cancelled
+	// Sees unloaded between lobbies and while waiting for results
+	if (benchmarkThread.joinable()) {
+		benchmarkThread.join();
+	}
+	parsePool->Stop(); // waits for a match end save already running
+	SaveStatsCache();
 	if (logFile.is_open()) {
 		logFile.close();
 	}
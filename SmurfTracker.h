@@ -1,33 +1,98 @@
 #pragma once
 
 #include "GuiBase.h"
+#include "Snapshot.h"
+#include "MpscQueue.h"
+#include "StatsParser.h"
+#include "StatsProvider.h"
+#include "Providers.h"
+#include "PluginProviderHost.h"
+#include "LookupPipeline.h"
+#include "StatsCache.h"
+#include "WorkerPool.h"
+#include "EventCoalescer.h"
+#include "RosterLayout.h"
+#include "OverlayTable.h"
 #include "bakkesmod/plugin/bakkesmodplugin.h"
 #include "bakkesmod/plugin/pluginwindow.h"
 #include "bakkesmod/plugin/PluginSettingsWindow.h"
+#include <atomic>
 #include <string>
 #include <vector>
 #include <fstream>
+#include <stop_token>
+#include <unordered_map>
+#include <thread>
 
 #include "version.h"
 
 constexpr auto plugin_version = stringify(VERSION_MAJOR) "." stringify(VERSION_MINOR) "." stringify(VERSION_PATCH) "." stringify(VERSION_BUILD);
 
+// Stable reference to a roster slot. A slot gets a fresh generation whenever a
+// different player takes it, so results for departed players can be told apart.
+struct PlayerHandle {
+	uint32_t slot = 0;
+	uint32_t generation = 0; // 0 is never handed out
+
+	uint64_t Pack() const { return (static_cast<uint64_t>(generation) << 32) | slot; }
+	static PlayerHandle Unpack(uint64_t packed) { return { static_cast<uint32_t>(packed), static_cast<uint32_t>(packed >> 32) }; }
+	bool operator==(const PlayerHandle& other) const = default;
+};
+
 struct PlayerDetails {
+	PlayerHandle handle;
+	bool occupied = false; // false once the player has left, the slot may be reused
 	std::string playerName;
 	std::string platform;
 	std::string uniqueID;
 	std::string wins = "0";
+	bool winsStale = false; // wins came from an old cache entry and are being revalidated
 	std::string mmr = "0";
 	bool requested = false;
 	int playerIndex = 0;
 	int currentScore = 0;
 	int team;
+	uintptr_t pri = 0; // address of the PRI the player was read from, scores are polled by it
+	int encounters = 0; // matches this session the player was in, this one included
+};
+
+// Work the game hooks ask for, each coalesced on its own window
+enum class HookWork {
+	Roster, // InitializeCurrentPlayers
+	Scores, // UpdatePlayerList
+	Fetch,  // HTTPRequest
+};
+
+// Where the game is, kept up to date by the hooks so per-frame code does not ask the wrappers
+enum class GameState {
+	Menu,
+	Freeplay,
+	OnlineMatch,
+	Replay,
+	MatchEnded, // the online match is over but its server is still around
+};
+
+// Everything Render needs, published as one immutable version
+struct RosterSnapshot {
+	std::vector<PlayerDetails> players; // indexed by PlayerHandle::slot
+	std::vector<uint32_t> blueTeam;     // slots in display order
+	std::vector<uint32_t> orangeTeam;
+	size_t playerCount = 0;
+	std::vector<uintptr_t> skippedPris; // PRIs the last rebuild saw but did not admit (splitscreen guests, bad IDs)
+
+	PlayerDetails* Find(PlayerHandle handle);
+	const PlayerDetails* Find(PlayerHandle handle) const;
+	// Whether the last rebuild saw this PRI, admitted or skipped
+	bool Knows(uintptr_t pri) const;
+	// Re-sorts a team only when a score change broke its order
+	void SortTeamsByScore();
 };
 
 std::string getCurrentTime();
 
 class SmurfTracker : public BakkesMod::Plugin::BakkesModPlugin
 	, public SettingsWindowBase
+	, public PluginWindowBase
 {
 	// Boilerplate
 	void onLoad() override;
@@ -35,23 +100,95 @@ class SmurfTracker : public BakkesMod::Plugin::BakkesModPlugin
 
     void HTTPRequest();
 	void Render(CanvasWrapper canvas);
+	std::vector<DrawCommand> LayoutOverlay(const RosterSnapshot& snapshot, int mode, CanvasWrapper& canvas);
+	bool UpdateOverlayTable(const RosterSnapshot& snapshot, const std::vector<OverlayColumn>& columns);
+	// Wins are looked up only while the overlay in use shows them
+	bool WinsNeeded() const;
+	void FetchIfWinsNeeded();
+	void ShowImGuiOverlay(bool show);
+	// Plugin and table overlay on, scoreboard open in a live game
+	bool ImGuiOverlayWanted() const { return smurfTrackerEnabled && imguiOverlayEnabled && isSBOpen && InLiveGame(); }
 	void InitializeCurrentPlayers();
 	void ClearCurrentPlayers();
 	void LogF(const std::string& message);
 	void UpdatePlayerList();
-	void UpdateTeamStrings();	
+	// False when the server has a PRI the roster has not seen yet
+	bool RosterCoversServer(ServerWrapper& sw) const;
+	void UpdateTeamOrder(RosterSnapshot& snapshot);
+	// Asks the wrappers once, from the hooks where the state may have changed
+	void RefreshGameState();
+	void SetGameState(GameState next);
+	bool InLiveGame() const { return gameState == GameState::OnlineMatch || gameState == GameState::Freeplay; }
+	// The server of the online match or freeplay session, null anywhere else
+	ServerWrapper CurrentServer();
+	std::chrono::steady_clock::time_point LookupDeadline(ServerWrapper& sw) const;
+	void CancelPlayerLookups(PlayerHandle handle);
+	void ConfigureProviders();
+	void ScheduleHealthProbe();
+	void ScheduleScorePoll();
+	void ApplyCacheTtl();
+	void SaveStatsCache();
+	void RunPipelineBenchmark(const std::vector<std::string>& args);
+	void LookupViaDaemon(const std::string& address, std::vector<ProviderRequest> requests, std::chrono::steady_clock::time_point deadline);
+	void PushResult(const LookupResult& result);
+	void ScheduleResultDrain();
+	void DrainResults();
 
-	bool isSBOpen;
-	bool smurfTrackerEnabled;
-	int selectedMode; // displayed mode chosen by combo box
+	bool isSBOpen = false;
+	GameState gameState = GameState::Menu; // game thread only
+	std::atomic<bool> smurfTrackerEnabled = false; // also read by RenderWindow
+	int selectedMode = 0; // displayed mode chosen by combo box
 	bool checkTeammates;
 	bool checkSelf;
-	std::string ipAddress; // IP address of endpoint
-	std::vector<PlayerDetails> currentPlayers;
+	std::string ipAddress; // FlareSolverr endpoint list as entered
+	Snapshot<RosterSnapshot> roster; // read by Render, replaced on the game thread
+	// Render replays overlayCommands until the roster version, mode or screen size changes
+	std::shared_ptr<const RosterSnapshot> laidOutRoster;
+	int laidOutMode = -1;
+	Vector2 laidOutScreen{ 0, 0 };
+	std::vector<DrawCommand> overlayCommands;
+	bool imguiOverlayEnabled = false; // SmurfTracker_overlay, the ImGui window replaces the canvas overlay
+	bool imguiOverlayShown = false;   // openmenu sent, game thread
+	std::atomic<bool> imguiOverlayCache = true;
+	Snapshot<std::vector<OverlayColumn>> overlayColumns; // SmurfTracker_columns, read by the render thread
+	// Render thread, overlayTable is updated when the roster version or the columns differ from what it shows
+	OverlayTable overlayTable;
+	ImGuiOverlay imguiOverlay; // draws overlayTable's model
+	std::shared_ptr<const RosterSnapshot> overlayRoster;
+	std::shared_ptr<const std::vector<OverlayColumn>> overlayColumnsShown;
+	std::atomic<uint64_t> cellsFormatted{ 0 }; // overlayTable's count, for SmurfTracker_overlay_stats
+	// CPU time per overlay path, SmurfTracker_overlay_stats logs and resets them
+	struct OverlayTiming {
+		std::atomic<uint64_t> frames = 0;
+		std::atomic<uint64_t> nanoseconds = 0;
+		void Add(std::chrono::steady_clock::time_point start);
+	};
+	OverlayTiming canvasTiming;
+	OverlayTiming imguiTiming;
+	std::unordered_map<std::string, int> encounterCounts; // by unique ID, game thread
+	uint32_t lastGeneration = 0; // last PlayerHandle generation handed out
+	std::unordered_map<uint64_t, std::stop_source> playerCancels; // by packed handle, stopped when the player leaves
+	std::stop_source unloadSource; // stopped in onUnload
 	std::ofstream logFile;
-	std::vector<std::string> blueTeam;
-	std::vector<std::string> orangeTeam;
+	std::unique_ptr<WorkerPool> parsePool; // decodes responses off the HTTP thread
+	MpscQueue<LookupResult> lookupResults; // filled by parsePool, drained on the game thread
+	std::atomic<bool> drainScheduled = false;
+	std::unique_ptr<HttpPool> httpPool; // keep-alive connections for http:// lookups, one I/O thread
+	std::unique_ptr<PluginProviderHost> providerHost;
+	ProviderRegistry providerRegistry;
+	StatsCache statsCache; // survives between matches, persisted to statsCachePath
+	std::string statsCachePath = "SmurfTracker_cache.json";
+	std::unique_ptr<LookupPipeline> lookupPipeline;
+	std::unique_ptr<EventCoalescer<HookWork>> hookWork; // one roster rebuild, score pass or fetch per burst of hooks
+	std::atomic<std::shared_ptr<FlareSolverrProvider>> flareSolverr; // in the current chain, probed between matches and shown in the settings
+	static constexpr float healthProbeSeconds = 30.0f;
+	static constexpr float scorePollSeconds = 1.0f; // catches score changes without a stat event (touches, clears)
+	std::thread benchmarkThread;
+	SocketLibrary sockets; // WinSock for the daemon streams while the plugin is loaded
+	std::vector<std::jthread> daemonStreams; // this match's result streams from SmurfTracker_daemon
 
 public:
 	void RenderSettings() override;
+	void RenderWindow() override;
+	bool ShouldBlockInput() override;
 };
@@ -27,22 +27,186 @@ void SmurfTracker::RenderSettings() {
         ImGui::SetTooltip("Select the mode to display"); 
     }
 
+    // ImGui overlay: every column at once instead of the selected mode
+    CVarWrapper overlayCvar = cvarManager->getCvar("SmurfTracker_overlay");
+    if (!overlayCvar) { return; }
+    bool imguiOverlay = overlayCvar.getIntValue() == 1;
+    if (ImGui::Checkbox("Table overlay", &imguiOverlay)) {
+        overlayCvar.setValue(imguiOverlay ? 1 : 0);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Show score, MMR, wins, smurf indication and earlier encounters together, drawn with ImGui");
+    }
+
+    // Table columns, wins are only looked up while the wins or smurf column is shown
+    CVarWrapper columnsCvar = cvarManager->getCvar("SmurfTracker_columns");
+    if (!columnsCvar) { return; }
+    std::vector<OverlayColumn> columns = ParseOverlayColumns(columnsCvar.getStringValue());
+    ImGui::TextUnformatted("Columns:");
+    for (OverlayColumn column : { OverlayColumn::Score, OverlayColumn::Mmr, OverlayColumn::Wins, OverlayColumn::Smurf, OverlayColumn::Met }) {
+        auto found = std::find(columns.begin(), columns.end(), column);
+        bool shown = found != columns.end();
+        ImGui::SameLine();
+        if (ImGui::Checkbox(std::string(OverlayColumnTitle(column)).c_str(), &shown)) {
+            if (shown) {
+                columns.push_back(column);
+            }
+            else {
+                columns.erase(found);
+            }
+            columnsCvar.setValue(OverlayColumnsToString(columns));
+        }
+    }
+
+    CVarWrapper overlayCacheCvar = cvarManager->getCvar("SmurfTracker_overlay_cache");
+    if (!overlayCacheCvar) { return; }
+    bool overlayCache = overlayCacheCvar.getBoolValue();
+    if (ImGui::Checkbox("Reuse table geometry between frames", &overlayCache)) {
+        overlayCacheCvar.setValue(overlayCache);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Only lay out the table again when a player or value changes. SmurfTracker_overlay_stats compares the costs");
+    }
+
+    // Cached wins: shown marked stale (*) and refreshed after the soft TTL, dropped after the hard TTL
+    CVarWrapper softTtlCvar = cvarManager->getCvar("SmurfTracker_cache_soft_ttl");
+    if (!softTtlCvar) { return; }
+    int softTtl = softTtlCvar.getIntValue();
+    if (ImGui::InputInt("Refresh cached wins after (min)", &softTtl, 5, 60, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        softTtlCvar.setValue(std::max(softTtl, 0));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Older cached wins are shown with a * while a fresh value is fetched in the background");
+    }
+
+    CVarWrapper hardTtlCvar = cvarManager->getCvar("SmurfTracker_cache_hard_ttl");
+    if (!hardTtlCvar) { return; }
+    int hardTtl = hardTtlCvar.getIntValue();
+    if (ImGui::InputInt("Forget cached wins after (min)", &hardTtl, 60, 1440, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        hardTtlCvar.setValue(std::max(hardTtl, 0));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Cached wins older than this are fetched again before they are shown");
+    }
+
+    CVarWrapper negativeTtlCvar = cvarManager->getCvar("SmurfTracker_cache_negative_ttl");
+    if (!negativeTtlCvar) { return; }
+    int negativeTtl = negativeTtlCvar.getIntValue();
+    if (ImGui::InputInt("Retry failed lookups after (min)", &negativeTtl, 1, 10, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        negativeTtlCvar.setValue(std::max(negativeTtl, 0));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Not found and unreadable profiles are not requested again until then, endpoint errors for at most a minute");
+    }
+
     ImGui::Separator();
     ImGui::TextUnformatted("Wins mode settings:");
 
-    // IP address input of endpoint
+    // FlareSolverr endpoints, one or more containers
     CVarWrapper ipCvar = cvarManager->getCvar("SmurfTracker_ip");
     if (!ipCvar) { return; }
-    char ip[16] = ""; // Buffer to store IP address
-    std::string currentIP = ipCvar.getStringValue();
-    strncpy(ip, currentIP.c_str(), sizeof(ip));
-    ip[sizeof(ip) - 1] = '\0'; // Ensure null-termination
+    std::string endpoints = ipCvar.getStringValue();
+    if (ImGui::InputText("FlareSolverr endpoints", &endpoints, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        ipCvar.setValue(endpoints);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Comma separated host or host:port, port 8191 if omitted, IPv6 as [::1]:8191. Requests go to the least busy one");
+    }
+
+    CVarWrapper endpointConcurrencyCvar = cvarManager->getCvar("SmurfTracker_endpoint_concurrency");
+    if (!endpointConcurrencyCvar) { return; }
+    int endpointConcurrency = endpointConcurrencyCvar.getIntValue();
+    if (ImGui::InputInt("Requests per endpoint", &endpointConcurrency, 1, 1, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        endpointConcurrencyCvar.setValue(std::clamp(endpointConcurrency, 1, 8));
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Lookups each FlareSolverr endpoint works on at once");
+    }
+
+    // Live health from the background probes and the lookups themselves
+    if (std::shared_ptr<FlareSolverrProvider> provider = flareSolverr.load()) {
+        const std::vector<std::string>& names = provider->Endpoints();
+        std::vector<EndpointBalancer::EndpointStatus> health = provider->Health();
+        for (size_t i = 0; i < names.size() && i < health.size(); i++) {
+            const EndpointBalancer::EndpointStatus& status = health[i];
+            if (!status.checked) {
+                ImGui::TextDisabled("%s: not checked yet", names[i].c_str());
+            }
+            else if (status.healthy) {
+                ImGui::TextColored(ImVec4(0.3f, 0.9f, 0.3f, 1.0f), "%s: up, %.0f ms, %zu busy", names[i].c_str(), status.latencyMs, status.outstanding);
+            }
+            else {
+                ImGui::TextColored(ImVec4(0.9f, 0.3f, 0.3f, 1.0f), "%s: down, %zu failures in a row", names[i].c_str(), status.consecutiveFailures);
+            }
+        }
+    }
+
+    CVarWrapper httpPoolCvar = cvarManager->getCvar("SmurfTracker_http_pool");
+    if (!httpPoolCvar) { return; }
+    bool useHttpPool = httpPoolCvar.getBoolValue();
+    if (ImGui::Checkbox("Keep connections open", &useHttpPool)) {
+        httpPoolCvar.setValue(useHttpPool);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Send http:// lookups over the plugin's own pooled connections instead of BakkesMod's HTTP");
+    }
+    if (useHttpPool) {
+        HttpPool::Stats poolStats = httpPool->GetStats();
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu open, %llu of %llu requests reused one", poolStats.open,
+            static_cast<unsigned long long>(poolStats.reused), static_cast<unsigned long long>(poolStats.requests));
+    }
+
+    // Lookup daemon, whole lobbies in one request
+    CVarWrapper daemonCvar = cvarManager->getCvar("SmurfTracker_daemon");
+    if (!daemonCvar) { return; }
+    std::string daemon = daemonCvar.getStringValue();
+    if (ImGui::InputText("Daemon address", &daemon, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        daemonCvar.setValue(daemon);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("host:port of a SmurfTrackerDaemon, e.g. 127.0.0.1:8192. Leave empty to look players up directly");
+    }
+
+    // Stats providers, primary first
+    CVarWrapper providersCvar = cvarManager->getCvar("SmurfTracker_providers");
+    if (!providersCvar) { return; }
+    std::string providers = providersCvar.getStringValue();
+    if (ImGui::InputText("Providers", &providers, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        providersCvar.setValue(providers);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Comma separated, primary first: flaresolverr, tracker, localfile");
+    }
+
+    CVarWrapper hedgingCvar = cvarManager->getCvar("SmurfTracker_hedging");
+    if (!hedgingCvar) { return; }
+    bool hedging = hedgingCvar.getBoolValue();
+    if (ImGui::Checkbox("Hedge slow requests", &hedging)) {
+        hedgingCvar.setValue(hedging);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Also ask the next provider when the primary is slower than usual");
+    }
+
+    CVarWrapper trackerUrlCvar = cvarManager->getCvar("SmurfTracker_tracker_url");
+    if (!trackerUrlCvar) { return; }
+    std::string trackerUrl = trackerUrlCvar.getStringValue();
+    if (ImGui::InputText("Tracker URL", &trackerUrl, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        trackerUrlCvar.setValue(trackerUrl);
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Used by the tracker provider, e.g. https://example.com/api/{platform}/{name}");
+    }
 
-    if (ImGui::InputText("IP Address", ip, IM_ARRAYSIZE(ip))) {
-        ipCvar.setValue(std::string(ip));
+    CVarWrapper localFileCvar = cvarManager->getCvar("SmurfTracker_local_stats_file");
+    if (!localFileCvar) { return; }
+    std::string localFile = localFileCvar.getStringValue();
+    if (ImGui::InputText("Local stats file", &localFile, ImGuiInputTextFlags_EnterReturnsTrue)) {
+        localFileCvar.setValue(localFile);
     }
     if (ImGui::IsItemHovered()) {
-        ImGui::SetTooltip("Set the IP address of the SmurfTracker endpoint");
+        ImGui::SetTooltip("Used by the localfile provider");
     }
 
     ImGui::TextUnformatted("Does not work yet:");
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Immutable value published RCU-style: readers take their own reference to the
+// current version and keep it alive for as long as they hold the pointer, so a
+// writer replacing it never invalidates what a reader is iterating.
+// Writers are serialized among themselves, copy the current version, mutate
+// the copy and publish it by switching the current slot index.
+//
+// Loading is lock-free. std::atomic<std::shared_ptr> would not do, MSVC and
+// libstdc++ implement it with a lock. A reader pins the slot it read the index
+// of, checks that it is still current and copies the shared_ptr out of it;
+// writers only refill slots that are neither current nor pinned. A reader
+// retries only when a writer published between its two index loads.
+template <typename T>
+class Snapshot
+{
+public:
+	Snapshot() { slots[0].value = std::make_shared<const T>(); }
+
+	std::shared_ptr<const T> Load() const
+	{
+		for (;;) {
+			size_t index = current.load();
+			Slot& slot = slots[index];
+			slot.readers.fetch_add(1);
+			// Pinned before the second load, so no writer refills it while it stays current
+			if (current.load() == index) {
+				std::shared_ptr<const T> value = slot.value;
+				slot.readers.fetch_sub(1);
+				return value;
+			}
+			slot.readers.fetch_sub(1);
+		}
+	}
+
+	void Publish(T value)
+	{
+		std::lock_guard<std::mutex> lock(writerMutex);
+		Store(std::make_shared<const T>(std::move(value)));
+	}
+
+	// Copy-on-write update, mutate receives a T& holding the latest version
+	template <typename Fn>
+	void Update(Fn&& mutate)
+	{
+		std::lock_guard<std::mutex> lock(writerMutex);
+		T next = *slots[current.load()].value;
+		mutate(next);
+		Store(std::make_shared<const T>(std::move(next)));
+	}
+
+private:
+	struct Slot {
+		std::shared_ptr<const T> value;
+		std::atomic<size_t> readers = 0; // Load calls between their two index loads
+	};
+
+	// Expects writerMutex held. Readers pin a slot for a pointer copy, so a free one turns up at once
+	void Store(std::shared_ptr<const T> value)
+	{
+		size_t now = current.load();
+		for (;;) {
+			for (size_t i = 0; i < slots.size(); i++) {
+				if (i != now && slots[i].readers.load() == 0) {
+					slots[i].value = std::move(value); // the version it held lives on in its readers
+					current.store(i);
+					return;
+				}
+			}
+			std::this_thread::yield();
+		}
+	}
+
+	mutable std::array<Slot, 3> slots;
+	std::atomic<size_t> current = 0;
+	std::mutex writerMutex;
+};
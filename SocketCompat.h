@@ -0,0 +1,187 @@
+#pragma once
+
+// Just enough of Winsock and BSD sockets behind one set of names for the
+// daemon's HTTP server and client and the plugin's daemon stream. The POSIX
+// side lets the daemon run next to a FlareSolverr container as well.
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+
+using SocketHandle = SOCKET;
+constexpr SocketHandle invalidSocket = INVALID_SOCKET;
+
+inline void CloseSocket(SocketHandle socket) { closesocket(socket); }
+inline void ShutdownSocket(SocketHandle socket) { shutdown(socket, SD_BOTH); }
+inline int SendSome(SocketHandle socket, const char* data, size_t size) { return send(socket, data, static_cast<int>(size), 0); }
+inline int RecvSome(SocketHandle socket, char* data, size_t size) { return recv(socket, data, static_cast<int>(size), 0); }
+
+inline void SetReceiveTimeout(SocketHandle socket, int milliseconds)
+{
+	DWORD timeout = static_cast<DWORD>(milliseconds);
+	setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+}
+
+// Non-blocking sockets and poll, for the plugin's HTTP pool
+using PollDescriptor = WSAPOLLFD;
+inline int PollSockets(PollDescriptor* descriptors, size_t count, int milliseconds) { return WSAPoll(descriptors, static_cast<ULONG>(count), milliseconds); }
+inline bool SetNonBlocking(SocketHandle socket) { u_long on = 1; return ioctlsocket(socket, FIONBIO, &on) == 0; }
+inline bool SetBlocking(SocketHandle socket) { u_long off = 0; return ioctlsocket(socket, FIONBIO, &off) == 0; }
+// The last call on a non-blocking socket would have blocked, or a connect is under way
+inline bool WouldBlock() { int error = WSAGetLastError(); return error == WSAEWOULDBLOCK || error == WSAEINPROGRESS; }
+// A failed accept only lost that one client, unlike running out of descriptors or memory
+inline bool AcceptAborted() { int error = WSAGetLastError(); return error == WSAECONNRESET || error == WSAEINTR; }
+// Pending error of the socket, how a non-blocking connect reports its outcome
+inline int SocketError(SocketHandle socket)
+{
+	int error = 0;
+	int length = sizeof(error);
+	return getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) == 0 ? error : -1;
+}
+
+// WSAStartup/WSACleanup for the lifetime of the process
+struct SocketLibrary {
+	SocketLibrary() { WSADATA data; WSAStartup(MAKEWORD(2, 2), &data); }
+	~SocketLibrary() { WSACleanup(); }
+};
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+using SocketHandle = int;
+constexpr SocketHandle invalidSocket = -1;
+
+inline void CloseSocket(SocketHandle socket) { close(socket); }
+inline void ShutdownSocket(SocketHandle socket) { shutdown(socket, SHUT_RDWR); }
+inline int SendSome(SocketHandle socket, const char* data, size_t size) { return static_cast<int>(send(socket, data, size, MSG_NOSIGNAL)); }
+inline int RecvSome(SocketHandle socket, char* data, size_t size) { return static_cast<int>(recv(socket, data, size, 0)); }
+
+inline void SetReceiveTimeout(SocketHandle socket, int milliseconds)
+{
+	timeval timeout{ milliseconds / 1000, (milliseconds % 1000) * 1000 };
+	setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+using PollDescriptor = pollfd;
+inline int PollSockets(PollDescriptor* descriptors, size_t count, int milliseconds) { return poll(descriptors, count, milliseconds); }
+inline bool SetNonBlocking(SocketHandle socket) { return fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) | O_NONBLOCK) == 0; }
+inline bool SetBlocking(SocketHandle socket) { return fcntl(socket, F_SETFL, fcntl(socket, F_GETFL, 0) & ~O_NONBLOCK) == 0; }
+inline bool WouldBlock() { return errno == EWOULDBLOCK || errno == EAGAIN || errno == EINPROGRESS; }
+inline bool AcceptAborted() { return errno == ECONNABORTED || errno == EINTR || errno == EPROTO; }
+inline int SocketError(SocketHandle socket)
+{
+	int error = 0;
+	socklen_t length = sizeof(error);
+	return getsockopt(socket, SOL_SOCKET, SO_ERROR, &error, &length) == 0 ? error : -1;
+}
+
+struct SocketLibrary {};
+#endif
+
+#include <stop_token>
+#include <string>
+#include <string_view>
+
+// "host:port", "[v6]:port" or a bare host, which gets defaultPort
+inline void SplitHostPort(const std::string& authority, const std::string& defaultPort, std::string& host, std::string& port)
+{
+	host = authority;
+	port = defaultPort;
+	size_t portSeparator = authority.rfind(':');
+	size_t v6End = authority.rfind(']');
+	bool bareV6 = v6End == std::string::npos && authority.find(':') != portSeparator;
+	if (portSeparator != std::string::npos && !bareV6 && (v6End == std::string::npos || portSeparator > v6End)) {
+		host = authority.substr(0, portSeparator);
+		port = authority.substr(portSeparator + 1);
+	}
+	if (host.size() > 1 && host.front() == '[' && host.back() == ']') {
+		host = host.substr(1, host.size() - 2);
+	}
+}
+
+// Connects without blocking past the timeout or a stop, the socket is left blocking on success
+inline bool ConnectWithin(SocketHandle connection, const addrinfo& address, std::stop_token stop, int timeoutMilliseconds)
+{
+	if (!SetNonBlocking(connection)) {
+		return false;
+	}
+	if (connect(connection, address.ai_addr, static_cast<int>(address.ai_addrlen)) != 0 && !WouldBlock()) {
+		return false;
+	}
+	// Short waits so a stop is seen quickly
+	constexpr int sliceMilliseconds = 50;
+	for (int waited = 0; waited < timeoutMilliseconds && !stop.stop_requested(); waited += sliceMilliseconds) {
+		PollDescriptor descriptor{};
+		descriptor.fd = connection;
+		descriptor.events = POLLOUT;
+		int ready = PollSockets(&descriptor, 1, sliceMilliseconds);
+		if (ready < 0) {
+			return false;
+		}
+		if (ready > 0) {
+			return SocketError(connection) == 0 && SetBlocking(connection);
+		}
+	}
+	return false;
+}
+
+// Tries every address host resolves to, invalidSocket and error when none connects.
+// Name resolution itself cannot be interrupted, the connects give up on stop.
+inline SocketHandle ConnectTcp(const std::string& host, const std::string& port, std::string& error,
+	std::stop_token stop = {}, int timeoutMilliseconds = 10000)
+{
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* addresses = nullptr;
+	if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0 || addresses == nullptr) {
+		error = "Cannot resolve " + host;
+		return invalidSocket;
+	}
+	SocketHandle connection = invalidSocket;
+	for (addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+		connection = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+		if (connection == invalidSocket) {
+			continue;
+		}
+		if (ConnectWithin(connection, *address, stop, timeoutMilliseconds)) {
+			break;
+		}
+		CloseSocket(connection);
+		connection = invalidSocket;
+		if (stop.stop_requested()) {
+			break;
+		}
+	}
+	freeaddrinfo(addresses);
+	if (connection == invalidSocket) {
+		error = "Cannot connect to " + host + ":" + port;
+	}
+	return connection;
+}
+
+// Loops until everything is sent, false once the peer is gone
+inline bool SendAll(SocketHandle socket, std::string_view data)
+{
+	while (!data.empty()) {
+		int sent = SendSome(socket, data.data(), data.size());
+		if (sent <= 0) {
+			return false;
+		}
+		data.remove_prefix(static_cast<size_t>(sent));
+	}
+	return true;
+}
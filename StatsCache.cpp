@@ -0,0 +1,199 @@
+#include "StatsCache.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include "json.hpp"
+
+StatsCache::StatsCache(std::chrono::seconds softTtl, std::chrono::seconds hardTtl)
+	: softTtl(softTtl), hardTtl(hardTtl)
+{
+}
+
+void StatsCache::SetTtl(std::chrono::seconds soft, std::chrono::seconds hard)
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	softTtl = soft;
+	hardTtl = hard < soft ? soft : hard;
+}
+
+void StatsCache::SetNegativeTtl(std::chrono::seconds negative)
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	negativeTtl = negative;
+}
+
+std::chrono::seconds StatsCache::MaxAge(const Entry& entry) const
+{
+	switch (entry.failure) {
+	case LookupFailure::None:
+		return hardTtl;
+	case LookupFailure::UpstreamError:
+		return std::min(negativeTtl, upstreamErrorTtl);
+	default:
+		return negativeTtl;
+	}
+}
+
+bool StatsCache::Expired(const Entry& entry, Clock::time_point now) const
+{
+	return now - entry.fetchedAt > MaxAge(entry);
+}
+
+void StatsCache::DropExpired()
+{
+	auto now = Clock::now();
+	std::erase_if(entries, [&](const auto& item) { return Expired(item.second, now); });
+}
+
+std::string StatsCache::Key(const std::string& platform, const std::string& playerName)
+{
+	return platform + "/" + playerName;
+}
+
+std::optional<StatsCache::Hit> StatsCache::Get(const std::string& key) const
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	auto it = entries.find(key);
+	if (it == entries.end()) {
+		return std::nullopt;
+	}
+	const Entry& entry = it->second;
+	auto now = Clock::now();
+	if (Expired(entry, now)) {
+		return std::nullopt;
+	}
+	auto age = now - entry.fetchedAt;
+	// Failures are not revalidated, they are simply asked for again once expired
+	return Hit{ entry.wins, entry.failure == LookupFailure::None && age > softTtl, entry.failure };
+}
+
+void StatsCache::Put(const std::string& key, const std::string& wins)
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	entries[key] = Entry{ wins, Clock::now() };
+}
+
+void StatsCache::PutFailure(const std::string& key, LookupFailure failure, const std::string& text)
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	auto it = entries.find(key);
+	if (it != entries.end() && it->second.failure == LookupFailure::None && !Expired(it->second, Clock::now())) {
+		return; // a known win count beats a failed refresh, until it expires itself
+	}
+	entries[key] = Entry{ text, Clock::now(), failure };
+}
+
+void StatsCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	entries.clear();
+}
+
+// File layout: {"version": 1, "entries": {"platform/name": {"wins": "6,201", "fetchedAt": unix seconds, "failure": "notFound"}}}
+// with "failure" only present on cached failures
+bool StatsCache::Load(const std::string& path, std::string& error)
+{
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		return true; // first run
+	}
+
+	nlohmann::json data;
+	try {
+		data = nlohmann::json::parse(file);
+	}
+	catch (const nlohmann::json::exception& e) {
+		error = std::string("Stats cache file parsing error: ") + e.what();
+		return false;
+	}
+	if (data.value("version", 0) != 1 || !data.contains("entries") || !data["entries"].is_object()) {
+		error = "Stats cache file has an unknown format, ignoring it";
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	DropExpired();
+	auto now = Clock::now();
+	for (const auto& [key, value] : data["entries"].items()) {
+		if (!value.is_object() || !value.contains("wins") || !value["wins"].is_string()) {
+			continue;
+		}
+		Entry entry{ value["wins"].get<std::string>(),
+			Clock::time_point{ std::chrono::seconds(value.value("fetchedAt", int64_t{ 0 })) },
+			FailureFromName(value.value("failure", "")) };
+		if (Expired(entry, now)) {
+			continue;
+		}
+		// Fresher in-memory entries win over the file
+		auto it = entries.find(key);
+		if (it == entries.end() || it->second.fetchedAt < entry.fetchedAt) {
+			entries[key] = std::move(entry);
+		}
+	}
+	return true;
+}
+
+bool StatsCache::Save(const std::string& path, std::string& error)
+{
+	nlohmann::json data;
+	data["version"] = 1;
+	nlohmann::json& out = data["entries"] = nlohmann::json::object();
+	{
+		std::lock_guard<std::mutex> lock(entriesMutex);
+		DropExpired();
+		for (const auto& [key, entry] : entries) {
+			nlohmann::json& item = out[key] = {
+				{ "wins", entry.wins },
+				{ "fetchedAt", std::chrono::duration_cast<std::chrono::seconds>(entry.fetchedAt.time_since_epoch()).count() }
+			};
+			if (entry.failure != LookupFailure::None) {
+				item["failure"] = FailureName(entry.failure);
+			}
+		}
+	}
+
+	// Write next to the target and swap it in, a crash mid-write keeps the old file
+	std::lock_guard<std::mutex> fileLock(fileMutex);
+	std::string tempPath = path + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::trunc);
+		if (!file.is_open()) {
+			error = "Could not write stats cache file: " + tempPath;
+			return false;
+		}
+		file << data.dump();
+		if (!file.good()) {
+			error = "Could not write stats cache file: " + tempPath;
+			return false;
+		}
+	}
+	// Replaces the target in one step (MoveFileExW with MOVEFILE_REPLACE_EXISTING on Windows)
+	std::error_code renameError;
+	std::filesystem::rename(tempPath, path, renameError);
+	if (renameError) {
+		error = "Could not replace stats cache file: " + path + " (" + renameError.message() + ")";
+		return false;
+	}
+	return true;
+}
+
+size_t StatsCache::Size() const
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	return entries.size();
+}
+
+size_t StatsCache::ApproxBytes() const
+{
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	// Node (key, entry, next pointer, cached hash) plus bucket slot plus any spilled string storage
+	size_t bytes = entries.bucket_count() * sizeof(void*);
+	for (const auto& [key, entry] : entries) {
+		bytes += sizeof(std::pair<const std::string, Entry>) + 2 * sizeof(void*);
+		if (key.capacity() > 15) bytes += key.capacity() + 1;
+		if (entry.wins.capacity() > 15) bytes += entry.wins.capacity() + 1;
+	}
+	return bytes;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "StatsParser.h"
+
+// Wins per player, remembered between matches and sessions so repeat opponents
+// show up at once. Entries older than the soft TTL are still served but marked
+// stale so the caller can revalidate them, past the hard TTL they are gone.
+// Failed lookups are remembered as well, for the shorter negative TTL, so a
+// missing or private profile is not requested again every match.
+class StatsCache
+{
+public:
+	// Wall clock, entries keep their age across restarts through the cache file
+	using Clock = std::chrono::system_clock;
+
+	struct Hit {
+		std::string wins;
+		bool stale = false; // older than the soft TTL
+		LookupFailure failure = LookupFailure::None; // a cached failure, wins holds its overlay text
+	};
+
+	explicit StatsCache(std::chrono::seconds softTtl = std::chrono::minutes(30),
+		std::chrono::seconds hardTtl = std::chrono::hours(24 * 7));
+
+	void SetTtl(std::chrono::seconds softTtl, std::chrono::seconds hardTtl);
+	// Upstream errors are usually transient and are kept at most upstreamErrorTtl
+	void SetNegativeTtl(std::chrono::seconds negativeTtl);
+	static constexpr std::chrono::seconds upstreamErrorTtl{ 60 };
+
+	// playerName is expected to be normalized already (normalizeUtf8)
+	static std::string Key(const std::string& platform, const std::string& playerName);
+
+	std::optional<Hit> Get(const std::string& key) const;
+	void Put(const std::string& key, const std::string& wins);
+	void PutFailure(const std::string& key, LookupFailure failure, const std::string& text);
+	void Clear();
+
+	// Persistence, a missing file loads as empty. Expired entries are dropped on both ends,
+	// in memory as well as in the file.
+	bool Load(const std::string& path, std::string& error);
+	bool Save(const std::string& path, std::string& error);
+
+	size_t Size() const;
+	// Rough heap footprint of the entries, for benchmarks
+	size_t ApproxBytes() const;
+
+private:
+	struct Entry {
+		std::string wins;
+		Clock::time_point fetchedAt;
+		LookupFailure failure = LookupFailure::None;
+	};
+
+	std::chrono::seconds MaxAge(const Entry& entry) const; // expects entriesMutex held
+	bool Expired(const Entry& entry, Clock::time_point now) const; // expects entriesMutex held
+	void DropExpired(); // expects entriesMutex held
+
+	mutable std::mutex entriesMutex;
+	mutable std::mutex fileMutex; // one Save writing the temp file at a time
+	std::chrono::seconds softTtl;
+	std::chrono::seconds hardTtl;
+	std::chrono::seconds negativeTtl = std::chrono::minutes(10);
+	std::unordered_map<std::string, Entry> entries;
+};
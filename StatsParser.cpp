@@ -0,0 +1,123 @@
+#include "StatsParser.h"
+#include "json.hpp"
+
+void MarkFailed(LookupResult& result, LookupFailure failure, std::string error)
+{
+	result.ok = false;
+	result.failure = failure;
+	result.wins = FailureText(failure, result.httpCode);
+	result.error = std::move(error);
+}
+
+std::string FailureText(LookupFailure failure, int httpCode)
+{
+	switch (failure) {
+	case LookupFailure::NotFound:
+		return "Not found";
+	case LookupFailure::ParseFailure:
+		return "No stats";
+	case LookupFailure::UpstreamError:
+		return httpCode != 0 && httpCode != 200 ? "Error: " + std::to_string(httpCode) : "Error";
+	default:
+		return "Error";
+	}
+}
+
+const char* FailureName(LookupFailure failure)
+{
+	switch (failure) {
+	case LookupFailure::NotFound:
+		return "notFound";
+	case LookupFailure::ParseFailure:
+		return "parseFailure";
+	case LookupFailure::UpstreamError:
+		return "upstreamError";
+	default:
+		return "";
+	}
+}
+
+LookupFailure FailureFromName(std::string_view name)
+{
+	if (name == "notFound") return LookupFailure::NotFound;
+	if (name == "parseFailure") return LookupFailure::ParseFailure;
+	if (name == "upstreamError") return LookupFailure::UpstreamError;
+	return LookupFailure::None;
+}
+
+LookupFailure FailureFromHttpCode(int code)
+{
+	return code == 404 ? LookupFailure::NotFound : LookupFailure::UpstreamError;
+}
+
+LookupResult ParseStatsResponse(int code, const std::string& response)
+{
+	LookupResult result;
+	result.httpCode = code;
+
+	if (code != 200) {
+		MarkFailed(result, FailureFromHttpCode(code), "Request failed with code: " + std::to_string(code));
+		return result;
+	}
+
+	try {
+		auto response_data = nlohmann::json::parse(response);
+
+		auto winsIt = response_data.find("wins");
+		if (winsIt != response_data.end()) {
+			result.wins = winsIt->is_string() ? winsIt->get<std::string>() : winsIt->dump();
+			result.ok = true;
+			return result;
+		}
+
+		// Stock FlareSolverr hands back the whole page
+		auto solutionIt = response_data.find("solution");
+		if (solutionIt != response_data.end() && solutionIt->contains("response")) {
+			// Status of the rlstats.net page itself, FlareSolverr answers 200 either way
+			int pageStatus = solutionIt->value("status", 200);
+			if (pageStatus != 200) {
+				result.httpCode = pageStatus;
+				MarkFailed(result, FailureFromHttpCode(pageStatus), "Profile page returned code: " + std::to_string(pageStatus));
+				return result;
+			}
+
+			const std::string& html = (*solutionIt)["response"].get_ref<const std::string&>();
+			if (auto wins = ExtractWinsFromHtml(html)) {
+				result.wins = *wins;
+				result.ok = true;
+				return result;
+			}
+			MarkFailed(result, LookupFailure::ParseFailure, "No wins found in profile page");
+			return result;
+		}
+
+		MarkFailed(result, LookupFailure::UpstreamError, "No wins found in response");
+	}
+	catch (const nlohmann::json::exception& e) {
+		MarkFailed(result, LookupFailure::UpstreamError, std::string("JSON parsing error: ") + e.what());
+	}
+	return result;
+}
+
+std::optional<std::string> ExtractWinsFromHtml(std::string_view html)
+{
+	// The first stats table on the page is the selected season: <td>6,201 Wins</td>
+	constexpr std::string_view suffix = " Wins</td>";
+	constexpr std::string_view cellOpen = "<td>";
+
+	size_t end = html.find(suffix);
+	if (end == std::string_view::npos) {
+		return std::nullopt;
+	}
+	size_t begin = html.rfind(cellOpen, end);
+	if (begin == std::string_view::npos) {
+		return std::nullopt;
+	}
+	begin += cellOpen.size();
+
+	std::string_view wins = html.substr(begin, end - begin);
+	if (wins.empty() || wins.find_first_not_of("0123456789,") != std::string_view::npos) {
+		return std::nullopt;
+	}
+	return std::string(wins);
+}
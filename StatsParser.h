@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Why a lookup failed, kept apart so each kind can be cached and shown on its own
+enum class LookupFailure {
+	None,          // success, or a local problem that says nothing about the player
+	NotFound,      // the profile does not exist (404)
+	ParseFailure,  // a profile page came back without readable stats, e.g. a private profile
+	UpstreamError, // the endpoint or the site behind it failed
+};
+
+// Outcome of one stats lookup after the response has been decoded
+struct LookupResult {
+	std::string playerName;
+	uint64_t tag = 0; // ProviderRequest::tag of the lookup this answers
+	int httpCode = 0;
+	bool ok = false;
+	std::string wins;  // display value, e.g. "6,201"
+	std::string error; // reason when !ok
+	LookupFailure failure = LookupFailure::None;
+	bool stale = false; // served from an old cache entry, a revalidated value may follow
+};
+
+// Sets ok = false, the failure kind, its overlay text as wins and the log message
+void MarkFailed(LookupResult& result, LookupFailure failure, std::string error);
+
+// Overlay text for a failure kind, httpCode is shown for upstream errors
+std::string FailureText(LookupFailure failure, int httpCode);
+
+// Stable names for files and the wire ("notFound", ...), None is ""
+const char* FailureName(LookupFailure failure);
+LookupFailure FailureFromName(std::string_view name);
+
+// 404 is NotFound, anything else that is not 200 an UpstreamError
+LookupFailure FailureFromHttpCode(int code);
+
+// Decodes an endpoint response. Accepts the custom FlareSolverr image's
+// {"wins": ...} reply as well as the stock {"solution": {"response": html}}.
+LookupResult ParseStatsResponse(int code, const std::string& response);
+
+// Pulls the current season's win count out of an rlstats.net profile page
+std::optional<std::string> ExtractWinsFromHtml(std::string_view html);
@@ -0,0 +1,197 @@
+#include "StatsProvider.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+std::chrono::milliseconds ProviderRequest::Remaining(std::chrono::milliseconds fallback) const
+{
+	if (!HasDeadline()) {
+		return fallback;
+	}
+	auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+	return std::clamp(left, std::chrono::milliseconds(0), fallback);
+}
+
+void LatencyTracker::Record(std::chrono::milliseconds latency)
+{
+	std::lock_guard<std::mutex> lock(samplesMutex);
+	if (samples.size() < windowSize) {
+		samples.push_back(latency);
+	}
+	else {
+		samples[nextSample] = latency;
+	}
+	nextSample = (nextSample + 1) % windowSize;
+}
+
+std::chrono::milliseconds LatencyTracker::P95(std::chrono::milliseconds fallback) const
+{
+	std::vector<std::chrono::milliseconds> sorted;
+	{
+		std::lock_guard<std::mutex> lock(samplesMutex);
+		if (samples.size() < minSamples) {
+			return fallback;
+		}
+		sorted = samples;
+	}
+	size_t index = (sorted.size() * 95) / 100;
+	std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+	return sorted[index];
+}
+
+void ProviderRegistry::RegisterFactory(const std::string& name, ProviderFactory factory)
+{
+	factories[name] = std::move(factory);
+}
+
+bool ProviderRegistry::HasFactory(const std::string& name) const
+{
+	return factories.count(name) > 0;
+}
+
+std::vector<std::shared_ptr<StatsProvider>> ProviderRegistry::BuildChain(const std::string& order, ProviderHost& host,
+	const std::map<std::string, ProviderConfig>& configs) const
+{
+	std::vector<std::shared_ptr<StatsProvider>> chain;
+	std::stringstream names(order);
+	std::string name;
+	while (std::getline(names, name, ',')) {
+		name.erase(0, name.find_first_not_of(" \t"));
+		name.erase(name.find_last_not_of(" \t") + 1);
+
+		auto factory = factories.find(name);
+		if (factory == factories.end()) {
+			host.Log("Unknown stats provider: " + name);
+			continue;
+		}
+
+		auto config = configs.find(name);
+		std::shared_ptr<StatsProvider> provider = factory->second(host, config != configs.end() ? config->second : ProviderConfig{});
+		if (!provider || !provider->IsConfigured()) {
+			host.Log("Stats provider not configured, skipping: " + name);
+			continue;
+		}
+		chain.push_back(std::move(provider));
+	}
+	return chain;
+}
+
+namespace {
+	constexpr std::chrono::milliseconds defaultHedgeDelay{ 8000 };
+
+	struct HedgeState {
+		std::vector<std::shared_ptr<StatsProvider>> chain;
+		ProviderRequest request;
+		HedgedCallback done;
+		bool hedge = true;
+
+		std::mutex mutex;
+		size_t launched = 0;
+		size_t answered = 0;
+		bool finished = false;
+		int lastCode = 0;
+		std::string lastResponse;
+		size_t lastProvider = 0;
+	};
+
+	constexpr size_t anyIndex = static_cast<size_t>(-1);
+
+	void LaunchNext(const std::shared_ptr<HedgeState>& state, ProviderHost& host, size_t expectedIndex = anyIndex);
+
+	void OnAnswer(const std::shared_ptr<HedgeState>& state, ProviderHost& host, size_t index,
+		std::chrono::steady_clock::time_point started, int code, std::string response)
+	{
+		std::shared_ptr<StatsProvider> provider = state->chain[index];
+		if (code == 200) {
+			provider->Latency().Record(std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now() - started));
+		}
+
+		bool deliver = false;
+		bool failOver = false;
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->answered++;
+			if (state->finished) {
+				return; // someone else already won
+			}
+			if (code == 200) {
+				state->finished = true;
+				deliver = true;
+			}
+			else {
+				state->lastCode = code;
+				state->lastResponse = std::move(response);
+				state->lastProvider = index;
+				if (state->launched < state->chain.size()) {
+					failOver = true;
+				}
+				else if (state->answered == state->launched) {
+					state->finished = true;
+					deliver = true;
+					code = state->lastCode;
+					response = std::move(state->lastResponse);
+					provider = state->chain[state->lastProvider];
+				}
+			}
+		}
+
+		if (deliver) {
+			state->done(provider, code, std::move(response));
+		}
+		else if (failOver) {
+			LaunchNext(state, host);
+		}
+	}
+
+	// expectedIndex lets a hedge timer bail out when a failover already launched that provider
+	void LaunchNext(const std::shared_ptr<HedgeState>& state, ProviderHost& host, size_t expectedIndex)
+	{
+		size_t index;
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			if (state->finished || state->launched >= state->chain.size()) {
+				return;
+			}
+			if (expectedIndex != anyIndex && state->launched != expectedIndex) {
+				return;
+			}
+			index = state->launched++;
+		}
+
+		std::shared_ptr<StatsProvider> provider = state->chain[index];
+		auto started = std::chrono::steady_clock::now();
+		provider->Fetch(state->request, [state, &host, index, started](int code, std::string response) {
+			OnAnswer(state, host, index, started, code, std::move(response));
+			});
+
+		// Hedge: if this provider is slower than usual, ask the next one too, unless that is past the deadline
+		if (state->hedge && index + 1 < state->chain.size()) {
+			auto hedgeDelay = provider->Latency().P95(defaultHedgeDelay);
+			if (state->request.Remaining(hedgeDelay) < hedgeDelay) {
+				return;
+			}
+			float delay = std::chrono::duration<float>(hedgeDelay).count();
+			host.SetTimeout([state, &host, next = index + 1]() {
+				LaunchNext(state, host, next);
+				}, delay);
+		}
+	}
+}
+
+void HedgedFetch(const std::vector<std::shared_ptr<StatsProvider>>& chain, ProviderHost& host,
+	const ProviderRequest& request, bool hedge, HedgedCallback done)
+{
+	if (chain.empty()) {
+		done(nullptr, 0, "");
+		return;
+	}
+
+	auto state = std::make_shared<HedgeState>();
+	state->chain = chain;
+	state->request = request;
+	state->done = std::move(done);
+	state->hedge = hedge;
+	LaunchNext(state, host);
+}
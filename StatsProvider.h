@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include "StatsParser.h"
+
+// One player to look up, platform as it appears in the unique ID (Epic, Steam, XboxOne, ...)
+struct ProviderRequest {
+	std::string playerName;
+	std::string platform;
+	uint64_t tag = 0; // opaque to the pipeline, handed back in LookupResult::tag
+	std::chrono::steady_clock::time_point deadline{}; // default means no deadline
+	std::stop_token cancel; // the caller no longer wants the result (player left, match ended)
+
+	bool HasDeadline() const { return deadline != std::chrono::steady_clock::time_point{}; }
+	// Time left until the deadline, capped at fallback
+	std::chrono::milliseconds Remaining(std::chrono::milliseconds fallback) const;
+};
+
+struct HttpCall {
+	std::string url;
+	std::string verb = "GET";
+	std::map<std::string, std::string> headers;
+	std::string body;
+	std::chrono::milliseconds timeout{ 0 }; // 0 = the host's default, hosts without timeouts ignore it
+};
+
+// What a provider needs from whoever hosts it, so providers do not depend on the SDK
+class ProviderHost
+{
+public:
+	virtual ~ProviderHost() = default;
+
+	// done may run on any thread
+	virtual void SendHttp(const HttpCall& call, std::function<void(int, std::string)> done) = 0;
+	// May be called from any thread, callback runs on the host's main thread
+	virtual void SetTimeout(std::function<void()> callback, float seconds) = 0;
+	virtual void Log(const std::string& message) = 0;
+};
+
+// Per-provider settings, each provider reads the fields it understands
+struct ProviderConfig {
+	std::vector<std::string> endpoints; // host:port of each FlareSolverr instance, see ParseEndpointList
+	size_t perEndpointLimit = 1; // requests at once per FlareSolverr instance
+	std::string urlTemplate; // tracker URL with {platform} and {name} placeholders
+	std::string winsPointer = "/wins"; // JSON pointer to the wins value in a tracker reply
+	std::string filePath;    // local stats file
+	std::map<std::string, std::vector<std::string>> sessions; // FlareSolverr sessions by endpoint, created by the host
+	int maxTimeoutMs = 60000;
+};
+
+// Rolling window of successful response times, used to decide when to hedge
+class LatencyTracker
+{
+public:
+	void Record(std::chrono::milliseconds latency);
+
+	// Falls back to fallback until enough samples have been observed
+	std::chrono::milliseconds P95(std::chrono::milliseconds fallback) const;
+
+private:
+	static constexpr size_t windowSize = 64;
+	static constexpr size_t minSamples = 8;
+
+	mutable std::mutex samplesMutex;
+	std::vector<std::chrono::milliseconds> samples;
+	size_t nextSample = 0;
+};
+
+class StatsProvider
+{
+public:
+	virtual ~StatsProvider() = default;
+
+	virtual std::string Name() const = 0;
+
+	// Whether the provider has enough configuration to be asked at all
+	virtual bool IsConfigured() const = 0;
+
+	// done is called exactly once with the raw status code and body
+	virtual void Fetch(const ProviderRequest& request, std::function<void(int, std::string)> done) = 0;
+
+	// Runs on a parse worker, never on the game thread
+	virtual LookupResult Parse(int code, const std::string& response) const = 0;
+
+	LatencyTracker& Latency() { return latency; }
+
+private:
+	LatencyTracker latency;
+};
+
+using ProviderFactory = std::function<std::shared_ptr<StatsProvider>(ProviderHost& host, const ProviderConfig& config)>;
+
+// Known provider kinds by name, plus the ordered chain the plugin currently asks
+class ProviderRegistry
+{
+public:
+	void RegisterFactory(const std::string& name, ProviderFactory factory);
+	bool HasFactory(const std::string& name) const;
+
+	// Instantiates the comma separated provider list in order, unknown or unconfigured ones are skipped
+	std::vector<std::shared_ptr<StatsProvider>> BuildChain(const std::string& order, ProviderHost& host,
+		const std::map<std::string, ProviderConfig>& configs) const;
+
+private:
+	std::map<std::string, ProviderFactory> factories;
+};
+
+using HedgedCallback = std::function<void(std::shared_ptr<StatsProvider> provider, int code, std::string response)>;
+
+// Asks chain[0] first. If it has not answered within its observed p95 (or fails
+// outright) the next provider is asked as well, and so on. The first 200 wins;
+// if every provider fails, the last failure is reported. done runs exactly once.
+void HedgedFetch(const std::vector<std::shared_ptr<StatsProvider>>& chain, ProviderHost& host,
+	const ProviderRequest& request, bool hedge, HedgedCallback done);
@@ -0,0 +1,46 @@
+#include "TimerThread.h"
+
+TimerThread::TimerThread() : thread([this] { Run(); })
+{
+}
+
+TimerThread::~TimerThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	thread.join();
+}
+
+void TimerThread::After(std::chrono::milliseconds delay, std::function<void()> callback)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		timers.push(Timer{ Clock::now() + delay, sequence++, std::move(callback) });
+	}
+	wake.notify_all();
+}
+
+void TimerThread::Run()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!stopping) {
+		if (timers.empty()) {
+			wake.wait(lock);
+			continue;
+		}
+		// A copy, After may reallocate the queue while this waits
+		Clock::time_point due = timers.top().due;
+		if (Clock::now() < due) {
+			wake.wait_until(lock, due);
+			continue;
+		}
+		Timer timer = timers.top();
+		timers.pop();
+		lock.unlock();
+		timer.callback();
+		lock.lock();
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Runs callbacks at a deadline on one background thread, in due order.
+// Callbacks still pending when it is destroyed are dropped.
+class TimerThread
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	TimerThread();
+	~TimerThread();
+
+	TimerThread(const TimerThread&) = delete;
+	TimerThread& operator=(const TimerThread&) = delete;
+
+	void After(std::chrono::milliseconds delay, std::function<void()> callback);
+
+private:
+	struct Timer {
+		Clock::time_point due;
+		uint64_t sequence;
+		std::function<void()> callback;
+		bool operator>(const Timer& other) const
+		{
+			return due != other.due ? due > other.due : sequence > other.sequence;
+		}
+	};
+
+	void Run();
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+	uint64_t sequence = 0;
+	bool stopping = false;
+	std::thread thread;
+};
@@ -0,0 +1,70 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(size_t threadCount)
+{
+	if (threadCount == 0) {
+		size_t hardware = std::thread::hardware_concurrency();
+		threadCount = std::clamp<size_t>(hardware > 1 ? hardware - 1 : 1, 1, 4);
+	}
+
+	workers.reserve(threadCount);
+	for (size_t i = 0; i < threadCount; i++) {
+		workers.emplace_back([this] { WorkerLoop(); });
+	}
+}
+
+WorkerPool::~WorkerPool()
+{
+	Stop();
+}
+
+bool WorkerPool::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex);
+		if (stopping) {
+			return false;
+		}
+		jobs.push_back(std::move(job));
+	}
+	jobsAvailable.notify_one();
+	return true;
+}
+
+void WorkerPool::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobsMutex);
+		if (stopping) {
+			return;
+		}
+		stopping = true;
+		jobs.clear();
+	}
+	jobsAvailable.notify_all();
+
+	for (std::thread& worker : workers) {
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+}
+
+void WorkerPool::WorkerLoop()
+{
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(jobsMutex);
+			jobsAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+			if (stopping) {
+				return;
+			}
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		job();
+	}
+}
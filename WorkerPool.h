@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small fixed-size thread pool for CPU-heavy work (response decoding and
+// stats extraction) that should not run on the game or HTTP threads.
+class WorkerPool
+{
+public:
+	// threadCount 0 picks hardware_concurrency - 1, clamped to [1, 4]
+	explicit WorkerPool(size_t threadCount = 0);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	// Returns false once the pool is stopping, the job is not run then
+	bool Submit(std::function<void()> job);
+
+	// Drops queued jobs and joins the workers, jobs already running finish first
+	void Stop();
+
+	size_t Size() const { return workers.size(); }
+
+private:
+	void WorkerLoop();
+
+	std::vector<std::thread> workers;
+	std::deque<std::function<void()>> jobs;
+	std::mutex jobsMutex;
+	std::condition_variable jobsAvailable;
+	bool stopping = false;
+};
@@ -0,0 +1,395 @@
+#pragma once
+
+#include "ContentEncoding.h"
+
+// Streams produced by zlib 1.2.13 through Python's zlib module (compressobj with
+// the levels, strategies and memLevels named below), base64 encoded. The gzip
+// one with header fields was assembled by hand around a zlib raw stream.
+// Lobby text is rebuilt by LobbyText() in main.cpp rather than stored.
+// Regenerate with python3 codectest/make_vectors.py.
+
+enum class Plaintext {
+	Empty,
+	Sample,
+	Lobby,
+};
+
+struct CodecVector {
+	const char* name;
+	Plaintext plaintext;
+	ContentEncoding encoding;
+	bool checksummed; // gzip and zlib, raw deflate carries no checksum
+	const char* base64;
+};
+
+// A FlareSolverr reply as the proxy caches it, non-ASCII names included
+inline constexpr char sampleText[] =
+	"{\"status\":\"ok\",\"message\":\"Challenge not detected!\",\"solution\":{\"url\":\"https://rlsta"
+	"ts.net/profile/Steam/76561198000000000\",\"status\":200,\"response\":\"<html><head><title>Rocket"
+	" League Stats - Spieler \xC3\x9Cmlaut \xC3\x91""and\xC3\xBA</title></head><body><tr><td class=\\"
+	"\"playlist\\\">Ranked Doubles 2v2</td><td>Wins: 0</td><td>MMR 900</td></tr><tr><td class=\\\"pla"
+	"ylist\\\">Ranked Doubles 2v2</td><td>Wins: 37</td><td>MMR 913</td></tr><tr><td class=\\\"playlis"
+	"t\\\">Ranked Doubles 2v2</td><td>Wins: 74</td><td>MMR 926</td></tr><tr><td class=\\\"playlist\\\""
+	">Ranked Doubles 2v2</td><td>Wins: 111</td><td>MMR 939</td></tr><tr><td class=\\\"playlist\\\">Ra"
+	"nked Doubles 2v2</td><td>Wins: 148</td><td>MMR 952</td></tr><tr><td class=\\\"playlist\\\">Ranke"
+	"d Doubles 2v2</td><td>Wins: 185</td><td>MMR 965</td></tr><tr><td class=\\\"playlist\\\">Ranked D"
+	"oubles 2v2</td><td>Wins: 222</td><td>MMR 978</td></tr><tr><td class=\\\"playlist\\\">Ranked Doub"
+	"les 2v2</td><td>Wins: 259</td><td>MMR 991</td></tr><tr><td class=\\\"playlist\\\">Ranked Doubles"
+	" 2v2</td><td>Wins: 296</td><td>MMR 1004</td></tr><tr><td class=\\\"playlist\\\">Ranked Doubles 2"
+	"v2</td><td>Wins: 333</td><td>MMR 1017</td></tr><tr><td class=\\\"playlist\\\">Ranked Doubles 2v2"
+	"</td><td>Wins: 370</td><td>MMR 1030</td></tr><tr><td class=\\\"playlist\\\">Ranked Doubles 2v2</"
+	"td><td>Wins: 407</td><td>MMR 1043</td></tr></body></html>\"}}";
+
+inline constexpr size_t lobbyTextLength = 36007;
+
+inline const CodecVector codecVectors[] = {
+	{ "sample gzip, level 0", Plaintext::Sample, ContentEncoding::Gzip, true,
+		"H4sIAAAAAAAEAwEmBdn6eyJzdGF0dXMiOiJvayIsIm1lc3NhZ2UiOiJDaGFsbGVuZ2Ugbm90IGRldGVjdGVkISIsInNvbHV0aW9u"
+		"Ijp7InVybCI6Imh0dHBzOi8vcmxzdGF0cy5uZXQvcHJvZmlsZS9TdGVhbS83NjU2MTE5ODAwMDAwMDAwMCIsInN0YXR1cyI6MjAw"
+		"LCJyZXNwb25zZSI6IjxodG1sPjxoZWFkPjx0aXRsZT5Sb2NrZXQgTGVhZ3VlIFN0YXRzIC0gU3BpZWxlciDDnG1sYXV0IMORYW5k"
+		"w7o8L3RpdGxlPjwvaGVhZD48Ym9keT48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0"
+		"ZD5XaW5zOiAwPC90ZD48dGQ+TU1SIDkwMDwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91Ymxl"
+		"cyAydjI8L3RkPjx0ZD5XaW5zOiAzNzwvdGQ+PHRkPk1NUiA5MTM8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+"
+		"UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogNzQ8L3RkPjx0ZD5NTVIgOTI2PC90ZD48L3RyPjx0cj48dGQgY2xhc3M9"
+		"XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDExMTwvdGQ+PHRkPk1NUiA5Mzk8L3RkPjwvdHI+"
+		"PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMTQ4PC90ZD48dGQ+TU1S"
+		"IDk1MjwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiAx"
+		"ODU8L3RkPjx0ZD5NTVIgOTY1PC90ZD48L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2Mjwv"
+		"dGQ+PHRkPldpbnM6IDIyMjwvdGQ+PHRkPk1NUiA5Nzg8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2Vk"
+		"IERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMjU5PC90ZD48dGQ+TU1SIDk5MTwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxh"
+		"eWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiAyOTY8L3RkPjx0ZD5NTVIgMTAwNDwvdGQ+PC90cj48dHI+"
+		"PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiAzMzM8L3RkPjx0ZD5NTVIgMTAx"
+		"NzwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiAzNzA8"
+		"L3RkPjx0ZD5NTVIgMTAzMDwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3Rk"
+		"Pjx0ZD5XaW5zOiA0MDc8L3RkPjx0ZD5NTVIgMTA0MzwvdGQ+PC90cj48L2JvZHk+PC9odG1sPiJ9fdRr+NUmBQAA" },
+	{ "sample gzip, level 9, Z_FIXED", Plaintext::Sample, ContentEncoding::Gzip, true,
+		"H4sIAAAAAAACA6tWKi5JLCktVrJSys9W0lHKTS0uTkxPBXKdMxJzclLz0lMV8vJLFFJSS1KTS1JTFIFqivNzSksy8/OUrKqVSoty"
+		"gGozSkoKiq309YtyQKYV6+WllugXFOWnZeak6geXpCbm6pubmZoZGlpaGMAAyByozUYGBjpKRanFBfl5xSCbbTJKcnPsbDJSE1Ps"
+		"bEoyS3JS7YLyk7NTSxR8UhPTS1MVgkGWKOgqBBdkpuakFikcnpObk1haonB4YmJeyuFdNvoQTTb6ECOS8lMqgQYVAXGKQnJOYnGx"
+		"bYxSQU5iZU5mcUmMkl1QYl52aoqCS35pUk5qsYJRmRHQBJDVKXbhmXnFVgoGcL6vb5CCpQGUrw82knxjjc1RzTU0po655iao5hqZ"
+		"UcdcQ0NDVIONLalksIkFqsGmRlQy2MIU1WAzU+oYbGRkhGqwuQWVDDa1RDXY0pBKBluaoRhsaGBgQqVkbGyMZrKhObUyiAGaycZU"
+		"ynomBuZoJpsgZz59SJGhDy6IlGprAdRr+NUmBQAA" },
+	{ "sample gzip, level 9", Plaintext::Sample, ContentEncoding::Gzip, true,
+		"H4sIAAAAAAACA63UvU7DMBAH8Fcxngv+yHcUssBIl3Zg6eLWRxPVsaPYQaqqPgQ7T8LaFyNpCyIdkS15OOn8+y++O2DrhOstzrHZ"
+		"4RluwFqxhaF8qoRSoLeAtHFIgoONA3k39FijelcbjfMD7js19FbOtTYnpFOjZh80ONJ25q1WQJYOREOSOIoZy1L6c0bnmswpneEO"
+		"bGu0HZOLyjWqLCoQsixc7RSUC7PZgUMvILY9oOUYgu7Rsq1BQYdOn40SvUOnD6Hl6asgl0cFuRBrI/cD1A1Xoo0S1j6ucKvEXtXW"
+		"rXC5EHoHEj2bfq3AIv7OB2GMluVrrW2O6G89ny9QRq81OZP/Z4Nk6rLAj5uEU5fHflzG2BQOMk9wmE7hiHuC02gKx5EfmHM+hZPU"
+		"ExxlUzhjnuAsnsCM0tDTNw6CG5klvgaE3siBp9ELaXIjh3+Hj1xWBjkvInw8fgPUa/jVJgUAAA==" },
+	{ "sample zlib, level 0", Plaintext::Sample, ContentEncoding::Deflate, true,
+		"eAEBJgXZ+nsic3RhdHVzIjoib2siLCJtZXNzYWdlIjoiQ2hhbGxlbmdlIG5vdCBkZXRlY3RlZCEiLCJzb2x1dGlvbiI6eyJ1cmwi"
+		"OiJodHRwczovL3Jsc3RhdHMubmV0L3Byb2ZpbGUvU3RlYW0vNzY1NjExOTgwMDAwMDAwMDAiLCJzdGF0dXMiOjIwMCwicmVzcG9u"
+		"c2UiOiI8aHRtbD48aGVhZD48dGl0bGU+Um9ja2V0IExlYWd1ZSBTdGF0cyAtIFNwaWVsZXIgw5xtbGF1dCDDkWFuZMO6PC90aXRs"
+		"ZT48L2hlYWQ+PGJvZHk+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczog"
+		"MDwvdGQ+PHRkPk1NUiA5MDA8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90"
+		"ZD48dGQ+V2luczogMzc8L3RkPjx0ZD5NTVIgOTEzPC90ZD48L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBE"
+		"b3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDc0PC90ZD48dGQ+TU1SIDkyNjwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxp"
+		"c3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiAxMTE8L3RkPjx0ZD5NTVIgOTM5PC90ZD48L3RyPjx0cj48dGQg"
+		"Y2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDE0ODwvdGQ+PHRkPk1NUiA5NTI8L3Rk"
+		"PjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMTg1PC90ZD48"
+		"dGQ+TU1SIDk2NTwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5X"
+		"aW5zOiAyMjI8L3RkPjx0ZD5NTVIgOTc4PC90ZD48L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVz"
+		"IDJ2MjwvdGQ+PHRkPldpbnM6IDI1OTwvdGQ+PHRkPk1NUiA5OTE8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+"
+		"UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMjk2PC90ZD48dGQ+TU1SIDEwMDQ8L3RkPjwvdHI+PHRyPjx0ZCBjbGFz"
+		"cz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMzMzPC90ZD48dGQ+TU1SIDEwMTc8L3RkPjwv"
+		"dHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMzcwPC90ZD48dGQ+"
+		"TU1SIDEwMzA8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2lu"
+		"czogNDA3PC90ZD48dGQ+TU1SIDEwNDM8L3RkPjwvdHI+PC9ib2R5PjwvaHRtbD4ifX3sD68n" },
+	{ "sample zlib, level 9, Z_FIXED", Plaintext::Sample, ContentEncoding::Deflate, true,
+		"eAGrViouSSwpLVayUsrPVtJRyk0tLk5MTwVynTMSc3JS89JTFfLySxRSUktSk0tSUxSBaorzc0pLMvPzlKyqlUqLcoBqM0pKCoqt"
+		"9PWLckCmFevlpZboFxTlp2XmpOoHl6Qm5uqbm5maGRpaWhjAAMgcqM1GBgY6SkWpxQX5ecUgm20ySnJz7GwyUhNT7GxKMktyUu2C"
+		"8pOzU0sUfFIT00tTFYJBlijoKgQXZKbmpBYpHJ6Tm5NYWqJweGJiXsrhXTb6EE02+hAjkvJTKoEGFQFxikJyTmJxsW2MUkFOYmVO"
+		"ZnFJjJJdUGJedmqKgkt+aVJOarGCUZkR0ASQ1Sl24Zl5xVYKBnC+r2+QgqUBlK8PNpJ8Y43NUc01NKaOueYmqOYamVHHXENDQ1SD"
+		"jS2pZLCJBarBpkZUMtjCFNVgM1PqGGxkZIRqsLkFlQw2tUQ12NKQSgZbmqEYbGhgYEKlZGxsjGayoTm1MogBmsnGVMp6JgbmaCab"
+		"IGc+fUiRoQ8uiJRqawHsD68n" },
+	{ "sample zlib, level 9", Plaintext::Sample, ContentEncoding::Deflate, true,
+		"eNqt1L1OwzAQB/BXMZ4L/sh3FLLASJd2YOni1kcT1bGj2EGqqj4EO0/C2hcjaQsiHZEteTjp/Psvvjtg64TrLc6x2eEZbsBasYWh"
+		"fKqEUqC3gLRxSIKDjQN5N/RYo3pXG43zA+47NfRWzrU2J6RTo2YfNDjSduatVkCWDkRDkjiKGctS+nNG55rMKZ3hDmxrtB2Ti8o1"
+		"qiwqELIsXO0UlAuz2YFDLyC2PaDlGILu0bKtQUGHTp+NEr1Dpw+h5emrIJdHBbkQayP3A9QNV6KNEtY+rnCrxF7V1q1wuRB6BxI9"
+		"m36twCL+zgdhjJbla61tjuhvPZ8vUEavNTmT/2eDZOqywI+bhFOXx35cxtgUDjJPcJhO4Yh7gtNoCseRH5hzPoWT1BMcZVM4Y57g"
+		"LJ7AjNLQ0zcOghuZJb4GhN7IgafRC2lyI4d/h49cVgY5LyJ8PH4D7A+vJw==" },
+	{ "sample raw, level 0", Plaintext::Sample, ContentEncoding::Deflate, false,
+		"ASYF2fp7InN0YXR1cyI6Im9rIiwibWVzc2FnZSI6IkNoYWxsZW5nZSBub3QgZGV0ZWN0ZWQhIiwic29sdXRpb24iOnsidXJsIjoi"
+		"aHR0cHM6Ly9ybHN0YXRzLm5ldC9wcm9maWxlL1N0ZWFtLzc2NTYxMTk4MDAwMDAwMDAwIiwic3RhdHVzIjoyMDAsInJlc3BvbnNl"
+		"IjoiPGh0bWw+PGhlYWQ+PHRpdGxlPlJvY2tldCBMZWFndWUgU3RhdHMgLSBTcGllbGVyIMOcbWxhdXQgw5FhbmTDujwvdGl0bGU+"
+		"PC9oZWFkPjxib2R5Pjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDA8"
+		"L3RkPjx0ZD5NTVIgOTAwPC90ZD48L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+"
+		"PHRkPldpbnM6IDM3PC90ZD48dGQ+TU1SIDkxMzwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91"
+		"YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiA3NDwvdGQ+PHRkPk1NUiA5MjY8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0"
+		"XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2luczogMTExPC90ZD48dGQ+TU1SIDkzOTwvdGQ+PC90cj48dHI+PHRkIGNs"
+		"YXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAydjI8L3RkPjx0ZD5XaW5zOiAxNDg8L3RkPjx0ZD5NTVIgOTUyPC90ZD48"
+		"L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDE4NTwvdGQ+PHRk"
+		"Pk1NUiA5NjU8L3RkPjwvdHI+PHRyPjx0ZCBjbGFzcz1cInBsYXlsaXN0XCI+UmFua2VkIERvdWJsZXMgMnYyPC90ZD48dGQ+V2lu"
+		"czogMjIyPC90ZD48dGQ+TU1SIDk3ODwvdGQ+PC90cj48dHI+PHRkIGNsYXNzPVwicGxheWxpc3RcIj5SYW5rZWQgRG91YmxlcyAy"
+		"djI8L3RkPjx0ZD5XaW5zOiAyNTk8L3RkPjx0ZD5NTVIgOTkxPC90ZD48L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJh"
+		"bmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDI5NjwvdGQ+PHRkPk1NUiAxMDA0PC90ZD48L3RyPjx0cj48dGQgY2xhc3M9"
+		"XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDMzMzwvdGQ+PHRkPk1NUiAxMDE3PC90ZD48L3Ry"
+		"Pjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6IDM3MDwvdGQ+PHRkPk1N"
+		"UiAxMDMwPC90ZD48L3RyPjx0cj48dGQgY2xhc3M9XCJwbGF5bGlzdFwiPlJhbmtlZCBEb3VibGVzIDJ2MjwvdGQ+PHRkPldpbnM6"
+		"IDQwNzwvdGQ+PHRkPk1NUiAxMDQzPC90ZD48L3RyPjwvYm9keT48L2h0bWw+In19" },
+	{ "sample raw, level 9, Z_FIXED", Plaintext::Sample, ContentEncoding::Deflate, false,
+		"q1YqLkksKS1WslLKz1bSUcpNLS5OTE8Fcp0zEnNyUvPSUxXy8ksUUlJLUpNLUlMUgWqK83NKSzLz85SsqpVKi3KAajNKSgqKrfT1"
+		"i3JAphXr5aWW6BcU5adl5qTqB5ekJubqm5uZmhkaWloYwADIHKjNRgYGOkpFqcUF+XnFIJttMkpyc+xsMlITU+xsSjJLclLtgvKT"
+		"s1NLFHxSE9NLUxWCQZYo6CoEF2Sm5qQWKRyek5uTWFqicHhiYl7K4V02+hBNNvoQI5LyUyqBBhUBcYpCck5icbFtjFJBTmJlTmZx"
+		"SYySXVBiXnZqioJLfmlSTmqxglGZEdAEkNUpduGZecVWCgZwvq9vkIKlAZSvDzaSfGONzVHNNTSmjrnmJqjmGplRx1xDQ0NUg40t"
+		"qWSwiQWqwaZGVDLYwhTVYDNT6hhsZGSEarC5BZUMNrVENdjSkEoGW5qhGGxoYGBCpWRsbIxmsqE5tTKIAZrJxlTKeiYG5mgmmyBn"
+		"Pn1IkaEPLoiUamsB" },
+	{ "sample raw, level 9", Plaintext::Sample, ContentEncoding::Deflate, false,
+		"rdS9TsMwEAfwVzGeC/7IdxSywEiXdmDp4tZHE9Wxo9hBqqo+BDtPwtoXI2kLIh2RLXk46fz7L747YOuE6y3OsdnhGW7AWrGFoXyq"
+		"hFKgt4C0cUiCg40DeTf0WKN6VxuN8wPuOzX0Vs61NiekU6NmHzQ40nbmrVZAlg5EQ5I4ihnLUvpzRueazCmd4Q5sa7Qdk4vKNaos"
+		"KhCyLFztFJQLs9mBQy8gtj2g5RiC7tGyrUFBh06fjRK9Q6cPoeXpqyCXRwW5EGsj9wPUDVeijRLWPq5wq8Re1datcLkQegcSPZt+"
+		"rcAi/s4HYYyW5WutbY7obz2fL1BGrzU5k/9ng2TqssCPm4RTl8d+XMbYFA4yT3CYTuGIe4LTaArHkR+Ycz6Fk9QTHGVTOGOe4Cye"
+		"wIzS0NM3DoIbmSW+BoTeyIGn0QtpciOHf4ePXFYGOS8ifDx+Aw==" },
+	{ "lobby gzip, level 9", Plaintext::Lobby, ContentEncoding::Gzip, true,
+		"H4sIAAAAAAACA71dSZIcxxG8xyvS+AGaliPFk664UC+ABBxoooEHUKY3zTvmY+rp6a7KjHAP9yzARKMBg5meWjJj8fBY8sOHX8af"
+		"/vyXv354/D1++fjl358/jb///p9//vb563h9Gflb6Z/j+av/+Pzx6+9fRry+PL766Y9P41+/ffz69W8//PfXL19/+PmnH//49PNx"
+		"p/Lj15f7B25/5Z8c9/ggHvf5DOUKjx/0r/L68voS4Pb3x7r/Ee9fkqvX5z4e/LzE4x0j0s1vN14+PJ4vc3w3Xz1dYFndtCn5Xucm"
+		"sd08t+l8b7A001Pnv19f8l35q9wvnz6+rEbQLX1u+fPjQlrH+ms3+e5/IS+y2IRQmxbPTwTegLo0Rahs8Ss74K0RffZDaOgWu7Ka"
+		"dqE++nkHJHL5ao3GvkvP8z5E6G/q2ClTMFNFtO1dW4YUarId5NvY9Bx6WiVZbcLtN7K0Nk/8XEJkINWN8zpx+zPdZRUR8lRvJpv+"
+		"6Hkxco/b+6ONdWwTuG2232wXizqHVIK3R33q+Hzp8gyueq5eqSiYtkHLBR7KEOBC9++rFWDmq7dSQW5621X53sn84GW4GYX6Ri20"
+		"wd+FdqDfuNjzSY3WbuxlWTWgC8cCFvgybFmaRAaZnyBau+e7ZvtAxaH44jhQAZAGbOSPa1WZkIKPLctjgY5HYVgXQAu9gVjuHrcE"
+		"Ru79JeP4Ej0y1QkHsBrwBtlME+A3K8x0jccnDAOvwrys6eFrQCBQjLHymgW2GGahwN1wfqkueJFGifC0OBzXRCDPdBro8c9A9Njj"
+		"ot/wFw97YFhsEglCq2jjc4RIojh1B2bARVVoITZdsPf270vL48Rlz+C7LZ8wJWG0+HK1sQkNACBw+3+cunz7F3q0STsU7mKqHk0k"
+		"U3AtZR2OqzE0C3xiDYnoQxZbcE1XyYZhCai+buUl+g+XDRCWlC8pJ7dWiP6gcAgoEuKRrBXew5tAQjv1sExHIBUP2zbMm8a4EJY+"
+		"f3mOVOoudMro+hUSy0nnuaI1ya0Bgg4at+N1Q1+x2rSVZCsQk2w8tFpR0MI9ENolZCC8WdHfsOVZahUGHziUYlHjO0ANF5N2/O1p"
+		"xwk01Qg8oIPx8F74dFpPrbP30zughDjHqctt0w8nXFHXV1z4zsSj0D4J/bhIukQklzruTv68LtQCcvU4lQ/CGCTlTrDdshM9hYN8"
+		"KVpOcW0eBLNYaEF8kz4PKycEEiiTm98FVXs24KQLJ3g3KDckFGfxNuXTBwibwMJ+QLXqQrH/BEu2UdfCbVBKCRNvSQdMVo8K4UAm"
+		"IXpUT+k6QDY1MEar5lPCI0f2xH82ocUzH8gYcSMWvUA9jdNGUbsGcYbKoL5L/tvKNFTRqV7FEJ+c3KhZy956qJhGObfjqSB2lC4F"
+		"ceInHA7TDF3kPYBgfXOSzkyphsrQAEKvZOYomY+sFAx7DF6r93bTAycGdvoSi/USi2Jrb3GfeWXFv09cDmKtk5h2QdH62hnSGOs7"
+		"rdRJtDHT11conE+Pl9PHLF1AJt16XEmOBcdyjJYKsspImpT8cgI7BA2yeH/qTPv8cJu85j62dTJuwh/mpuvFQpLcBKNwmHqIK4xG"
+		"uDxErJis5pS1uFWdw7qZY1IFuBrMEqRMqCENT6RDGWsOl2nO3M03erVCzT6BOi6Fuey80pr+XGH2XHWW/gDh3JixRyKcek4p2ujT"
+		"yqpFbwEM/8FSck465vb2fiHiLGsGMqCqQoy5qs84uTZVIYSJI7CtI6e6qHYtvBmO2WySFWR1yo0gbZqWP5rSl8js0YiVUqiCmG6y"
+		"LvfhaiMaC0dWgtrYxAJz5V+VeEgtIlH1pOBNjhtbdCx3zRYMl129UxoOQtJBGE8lHrF3VcsifLTMlRp6K8zt61gDIstiJXwkZ9SE"
+		"hoLZgAEoZK5NoBn1GIN62Z7Jz4Z5t6gES2otBRih85sKhuY8sIHezfC9VC0jcbdZSeqg4izsEVWfLmdgsn6sYJDH1QYGqDom4h2v"
+		"9qVg+zesYS+Igl8sp6AqGHEW4boFWQHYBpnj5bYGNcVJ4aEEHDprbmTPbDTVFw8sfOYtokauOL6a064b5R05IQ2CVeapLMPX1aUy"
+		"yoWZ3u/aKGHAboKuqTkIx+ueTN5BBECoYZWGG0mgOKIxhmxUtECjDyoakEYaTq0ZK3IwISMjP521pJ1IhbUKEs0H8JqEPMbAuOOu"
+		"RnS5/JPmF+H9DhspUUFKx9Ly3fQ5xu9x4x19KZJbNkDgSA0iSXCVY6OYGHpoJcgNxfMVjeWNibxqRnGt42QplFOlHoCCXYJGvaAm"
+		"aZcdBJT0GbYFo2XomBEg+QbLUVVqIprCqDdw917yFMBkBrSbu5UJ3KSPWLFKSYFSLqYYP2lh99Kb0btlN13QEhWjkl6nmjgcLHFf"
+		"pxvjSGzsF7BLg3exin2tG+PVRoew7CRTxoU3jwEciAW6FRvZ1hE1WiqYVwzsJNnmFVPpWAoQU1ZWuEq4CQlZ3Od13MDSBRPHBXXq"
+		"EdHkdBhom/qdgiPgdt0s7qHNNZSalJptuFrz2kOhUVPoK2ndpKi8eHC/Usiv84dOkxixuSrqPdCOaBldmrNrI13a8K2z5eN6S6Ul"
+		"gkY8xkcrrIYOp/pEroInmDK+XtmPpSDvVNaapBeFgOGIEyuovBYuhc2P9ZG92UayyZDcq5B9MGsF1T3nhhJ6kaOg1nyCf7EUTBAq"
+		"RohJHwrh3pYhuzT9cEYy4IzBNWoTPCClqlsbkcBRU6nCpJ1dZ1iiRgvYtqtvNGHvqtagmR3kK1BTgJsh0tAdDIwsIaSTUSmtOV1v"
+		"4EJIn5prT8JuQlekAyg7fgurtXTM3HwmtCRTyhPWlGHYK2eJTnjHoHxhIU0gP3n2JoRb7KygPqQzy/K+bQ2LZbkUQrOm+umMKGqj"
+		"CkFNi1rIPS859oRaYxMsdHUw+5wDi7dWNfUegSuMboidmmVMome11A07wDSy9uDSHbk2UmZ/zEprohtsnMGFqIIS2KXD6wji4cZb"
+		"Tje8RcDYLE2EGq8Sa9yqU9MA2KiJdvBLk9Zok9MOGto0WdnJ/ok26phXb17RpQo7IixOp+9/B9uExiThQjl/4kdhcptm8O3pJxdL"
+		"SraqDWRiteQkjTkK+FYSo814pzZCrdVwVJ+znRkQAolBA/64y60RlakjXyej45lQ79i/BA1h9bqY4mUo79hJYOPRbbR1x0sgm7lW"
+		"WDe2Inp1pWedxMoCJQaA5yjhU4cbRTcwoWG1QEmw08y43YzXZi/c4TJ49gPjpyFsv0b98n59GJyrhgDWk9O3KT9qcIbl5qxOAGPG"
+		"L6uL7PL4sJkCMmSW1PSlDixf5DXN+eOGUssXSzt5vjccymt066lm99aweSIq/Dl0I41qGxz7bQepU6iY7/IYL20SCkOM1cgTdBej"
+		"XmYVWpW2bQrF8Zah5iL489VyYeTGdGurnb2Z/yCadlh/nWwKYH0osg147GLh1ACzk0Lg07uvZTj59Zxi7IhMUA02L7Pxk+/1jxsD"
+		"CWlwCBEpmgUHmsqxWIC0udk00DbYexSV3JQNpxNakHNGqHByG73mbqDXBurUPOIBR9AWzciEjBJYRVhnCAZL5Br04HeaH0GE0zDc"
+		"OGgb/4dqcjnLv466U9mKmqwoEbUan7J0mDZW2dRQHntPTQttKj3IxDqThZXerj/1IyasFQPwXjQntfyCz0lk5c1Wx7A1ufP0WVDo"
+		"jBiNlNlRDVfYk7ejmAo7FHheaL+RaXadQDNG+0Yu0/fdA/bosTXd50xuSwqSF74388CvNohakZTdJqYHuZ7Otenwhc6rAxgxRKIW"
+		"twbToGNhO1X+RxgsqBN8CpPRy4oQVvUItdMHXNsbnlIKNJpZJbk9fqsWMhtHqnsQsbX2L6gsx92WL4Hr6R7sWdmkIUD0dWcIWuoO"
+		"uD9XRFNvqtFYj5Cx6PlY29ykTSiw7zeHP2xMavELrb5l5Dup+7cGoEwD5670PQ6ws90ZZ7yHHPFndOSXalYfzVQS3YsYdo9LiJqD"
+		"e7O0wQtaocb1XiTHZ7AgP9x5qHQ+rM00YJNyZGD2es0R5BogNUHqdkdTPdT4ONpDvjfftpJeEcu81Ayr+8DobIZEs4BVFK3x3z2b"
+		"33qT/eSSrmfOx6ihASiy2VJxtiErYGN3GMLeKYrzYCtjuptZ++PkCdYmTTpijsJaMh3Vy/3XVhDzzTABO/A5AWO34ha/2MSOb9Qj"
+		"g64Q2eKUx3P26cWZ0GZOr1IjZmpiv3wshcT92ZpXZk/aJLfRfSEOJekZgvnsOm/Y6cyL7sxyb6eQuxfREwdhWLlr+KIbbyILu7Jh"
+		"vv3XAEJNb+xMdvaxV8s3yWmEVs18H51ST7/bwsGaV9dyzNLnEuiYjtraSTNqeNZPR0GwqpJlXtq34g2vt0B2wTRMVr/LGYbQI82M"
+		"48SkB3bn/lkSE34LZfFyTfJxr9xus5NYjVq/GiVfn2KW9//pJ9QpnqjZMy72VZcethibCRCT9pekRaAcI8lzL4V7lEq0arGfGJib"
+		"xhq3cTqUj0U+C1YrwG+OSlEzjeNqUYOXfI08ksjtfXWrguoMHDJwOpo8pXYFB4HQhGQim4AVsYOZDn8v479qI7uMwsUkzqAWWTYw"
+		"4kHhgQu8yXHFqsCx9pRtr5u6RXBOiw8lojPxp0d2giBebKr6s0kz87ccpoHHG7huPq7AiW86OMTpRVjqdocoYA2WMxqDj98zuX0f"
+		"NGyeCwSI0QBHLpfmihRrDdRwBarAEBPLZxXrwbT6qGDNeoTRu8tPD5WlhcuwLTNHPFpuSYI0xmcLbOXqqjwbAPfWgHNBzZMCaMX5"
+		"9sRIdxIUOpUO85htj8olL7sRGX0HFmz3XEwXMa1MKMx98YQl2mPliXdPsp07u3dGnDWJBB+NL+X6YDxLx3HUnPgypmCb3YjGvnUs"
+		"XdAKo2fhFTuy6DjoLRVpjHFZPKdzMJs+l+S15MD3bFAj2u4fHU/YxyunoPb4/v8AFQ8dKaeMAAA=" },
+	{ "lobby zlib, level 6, Z_FIXED", Plaintext::Lobby, ContentEncoding::Deflate, true,
+		"eAHz9Q1SMDQyNvGF0gpBiXnZqSkKLvmlSTmpxQqHVyqgC6FxFWBag1MTi/PzFLgOr4SybEpSFJJzEouLbZXKM/OKlexs9EtS7OA2"
+		"YUgfXglWAKTQZeB2oNPojoG5AcMEqAR+rxxeeXglFxbrwc4CE1wQJg7TMd0NdzjCCKgfubjQLAdajKJYAeYZuCi66WgGoIQuWqSg"
+		"24WIJFyxiYgmhL+xBA2Sq9HpwyvRbcXtFbDxaMpRQoMLZ5TCohymnEBqVUDVBkzf+DWgBzKBSOAiFGlcMBVc2CMAM2gwEhXRyQ8j"
+		"BogLI5xuhycanFFMbFpFiwVMpyNswJbk0E3Dk2MhqQdmD45ED8yO+DITZtqDFlU4chsktygQTNQ4ogOHMPaiB55PMVMyoUgA6kBP"
+		"rXhcDAtCbAUkIYvRwwl3+YNkC2oSweEqUJGNUwpmGA47gP7HFrHElE1YrEUvv3HFIkZ25iKYCUBOheVxZKMx3EBs9kStlTAyGOEy"
+		"CMUAaGbA1AbJBxhZi9jiC38pxYXDUmCsEvQ3WvGDPRiAhQKmj/A2bbCLYi0H8EccepARqJPw5FoS4hIj1LDkBXgAYjRfcAQiFvuR"
+		"kgy24ocLR64lre5CLh9wJgeMupgL3irAkhqwF/JwszDTBMGEj71kgQYQ3Cm42rpYmhaEIxB7uoNaiaWQg3iSC87E5mSceYKYBisR"
+		"zRtsZSaRDXw8IYwrr+Hun+BqA6MmZpQwhdc1WDoCGIUxoVoTo9lCRLGA0dwlULRASyyMAMdIjQRbeISTA9xMbI08IisNbM5HdETh"
+		"cYyRv7FqhJcHRJTYOHqCWEtFotvn2Fok6D0K4poZWAOVUGsBM1dR1hlSQGqB4+4nosQZVr+hqCAyJeBoN6IWeKiZA3c0AV3PpYDI"
+		"y0AeNqch5Q5C7S5cWR1HdYnW6iPgXkSdhKs1i6VOxOwS4XQkRllAXl7FEWHYUwBmXYc6LoFfMUYEEChJcQcp7sEt1CY6dAgHR6OI"
+		"QPJAK62wxyEwQWItp6AlE7wjxQUt2wi1lGCWcuFqaeHrlsI0I/dUMGMBX2Yktl7B0ZcjWHmittYIjq1hGaDDWrjBvUtw4Ac9kaKO"
+		"hULMQosLHBGPtdTiQvewArgjROqADNbmDWrrj3BDl+iuL/bGB/auFK5eI6SBiu4E0vppaKNRMN8SdC9mqYTSgsDea8ddTBE/nIZ/"
+		"aB2X/wjHAKFEjN5PRbEWTRKpXYEZvgQMBo/EY+vaoyV6BTIHXbhQXQ7OKlwI47F05kAuwmE6FyLzYW3GYEvlxHS28Y5O4B/CwVaX"
+		"YgtOAmbj7gTj6guhtPiQ8jP+DInTQgXk6QdSG1WklQGI4UKk5h2uGpzQyBtqbYOhGt4IQ2oskN6hQs0LGOU/jrYk3l4XytgGziEl"
+		"7ANvaHmAyFE9nIkQs3sCqpPxt+pxDtdhGWzC04whnDVhKZwLvWePo/7E07WAzQfiGhEnoi9KxtCTAqKMwlmuYW1n4HcJLM+DQgbP"
+		"UBEie2EUxIgxOYzmIpY5QPzD4SRWbnBXYW07EqxSsI2JI5rDuHp2pE6lEDlriFSGkT1JR+SUKo48ibAey4AeopZAzqHYanxspRTW"
+		"bg8R41r4azskB6ONwCIxsSdrlL4o9tKeqLFP9JAlwEe0y7H0tRAD08Q2ilC9jd6kISJ8kUIKMdCGq+hDMx9XZYM5mUNimwVfh4xg"
+		"tY5tTotgWxzbsAt87Ai7d7lwhDK21EQo/eIewMboI2IvIHEMbRLI50RUr3jqWLyVDLET/ljnpjENg03P4x7kxtFGwd1MhSdXrL0R"
+		"3OmBC2WwBtucMuHkhpnnsOdN9D4poQYXnjYL5oAazHCcqRPR0sE5Yo27uYw5/4OzxYe30YvePSO6D4Yar8SN6hE9r4RiNtwmLqRK"
+		"EslW3PaDluohtz3QBpzwjynhHFbHWXlhZiv8JQAR9Qfc66Q3gUGdd/QaC1+zG62yJ7FOwV9c4W55oWdUfN0szIF/rGULrGKBhx2u"
+		"IhQ9HaD0UNEGaIgdZMUyq4NhEdZhU7Tgx92ZBPUQ0BynwIU6pICZENEsQQ1ueFXLhbMQQaRlXJMUuGKW0OIFBbRMjMXxOLrzaL1q"
+		"pAyOPTdi6/LiTXd4ogCjWYI74IDZkJgWEuFOGO6pRHjfGzNbYiQ+nMtccRb0RHVzcY/Lwka+sBTOGKOGRLfkCAco7goRz9AaxmAu"
+		"0QNomNbjG2AgskuLPmZG5DwAUX1+zKUAWJyMkXYINUPR54GJaL0T2X1HT64K2JI70aOSOCsoLsTCHvyteqLHDIgc9cNR6mOt+Llw"
+		"lnKYzXQCQ8REtEFw5yBEqIFaWsQGCKHmF645BQI+wTGLQH4JgtoAI2Ewh7i5LQWcRTFahseaAuB5lsiIxD+ygTuGYW1hxLwFF2bP"
+		"FXv/Ch4x2Nbw4C5i4dpwNmZw1lREFXw4ClFsbQ+k5E3U6BSJcUD6gByO1jXO4gDrhCGOgRbImh6s4YCrHCB5QRW8MYC334t7lohQ"
+		"Rx1n0sA6jISltMTSLsMaFrgqCaztP6JG64gYp8EcU0GvwtH75hhLkrF16FEGXEgYu1JAGanG7PXgnjnG2m0jJkQItgrQpmNxjQ6j"
+		"q8M1voe78MbdVULpieE0AH/3ErMTiaNzhd43QmRmLAO3SNFMsGzC2i/HGCTAPTyELZ0R8BPcU1inOPCnFXhaw9XYxdEaJa5Tg5a7"
+		"iO4EwKsy3ON42AtWPMPCiI4z9jFNoioqzKEJLjwLo0CNO8iSJ4zwBXVusZabBFphRHSg4FEKGyXFUfnh3iyEUfgRLGHxFR6Y6Rl9"
+		"jQtBDaRMGMN9hTHohcgmxIzB4qi+ENUY7pYY4SEC3MP+xLbRcKnDCBQ8g69Iq43giYWUyRTC6QJbuwBLBUJUo5vQaCSughWtBCYy"
+		"4FCTCKH9EpiDbdgTFaHajYiEQuSsMGYKJ7JJiKvfR1RjTAHr0gUi23G4RjxBs0RceOZ0cDXakPY7ceFuAeMNN6LGHvDONaCNUWPb"
+		"q0/umlf8TSEFzCl01EFrPFNUxPUHCQ654BlUJab5j6MLgVGIIa+KgnS0ubBMQhFuG6ItuyeunMBiLPGJjIiBOKKSIBH9MVzZGv2o"
+		"COxTfQTmKnBPMKG3r1FHPxCOQF4oiWVXPlo6JjnlIdfX6IPD5HWXMBrlJA5rEmrTUzZCAl6FTHxjlqhONf4xN2wTekh7YLE2LlCL"
+		"Tyw8XFMwGIUoavrA28MkMOFCzO4l1JYm8d0ZgiPguEZwsQw9YB+MILLKwNnCxpMksPea0PRhHOGDudcZY3sL+cuScHeZ8S2UJRQG"
+		"eM4OIj4D4ejZYCZxbGU1RgDhGizBMehExEppwmO6WDv+JI9NIE8sc6F6n/QzRnA10ZErEowNFDiXXKMvIkJpHeHuVuOesMY5wkDa"
+		"chYufIkX81QlzDyIOgeBkZgwZkAIjeYQaupjHc7ECF5Q1ODqy+JOhViLNUL76YjoRRHZpMXaOkAb1UIZ3CNucgzW1CKY5rEPLhPT"
+		"LCYiEHD1t1CzKXFOwJ1hCG+IhSlENBgIDfSgltR4Rgdw5UiM3IA7RoichiatvUbMDDS2XIWlbYzeuMAxH442AE1w/hJLex1bEw/7"
+		"xlvcww2gHjD2YglpQA33KjE81Srh9I5taB0p0ZGwNAm1t4l72IFw0wbPrCxS+Yej4kAag8a2eg5pwwikwiNUWWN247BFOUY0YTsm"
+		"CW3+gNC4F9YSDSVF49kMTrAHRmoXDUcWwt36w53ecU+swoOR2GpYAdfcKcE2GnJ7B6MqRRoCR87rGPkZvZzBkjuRqnhctTmxpStx"
+		"k/7Yu/RETEZDgwT3fiYsTUNseZfAbCYxmRdbAxXn3BW22MGzdQdnTsA6VkOgoYN13Rhqi56QSbB1EqijQGgjADhHJbHPl+P2JLYU"
+		"Q1QDA8+UCWhUEutgA4mdGVyzFHinPggMb2BMNqOVurjqN5RmO3lDvzgGtbCfgYt3TgpPXwB9mAczJYBVYZ5fgc0KonYCEGqi4Z6z"
+		"wOZvvGNb2EfIiEo1OLwJz1/4V5nhbzgTXbdyIWo81AqF1IwBbaoQUZhhP9+HqByOtIYQUWsgBiqIP4cO3lRFr9YJrpEgqauIbgv0"
+		"eGkiBxRwjRNhH+RH6/+hj98RHnxHxD+utg8RtSVm3Yy9I0pENoZHCbYCj7hsgN0pBDsI+Lcm4sqZeOaqYc0W7M1rLLkGZ1Iguimu"
+		"gK+MwTuFgLNhS+pyfkIDxkQdRMiF1n7gwtJxw14Iow0RYB2Oxdngwdk5xNoiRSnRcFaqOJIFZlMFZyYiPhqJHaIiGCkkVDrYin9c"
+		"tmJtGnHhnCkiqrVB7BQXljES3K1R1AjGWhYht0ywxDpmGUl4hgDHUjxiRirJPTeTyMRJRMGNvdNG4VAckRNbRG7bgpe8BDeaY05W"
+		"YPSoCR2fgrLDFE+pTGQOxd33RiRD7OdooI8SEpjgwDUKS7C2w9vcRVq8BuqVYRn3wuEcyBFdhLM1zvYmenOMhLIGHtdcqAsKsecl"
+		"1L4BwsmI80Gw5SIc3sY+T4BqJMboEPqZOngGYJGSBRfWKSF8MzzYC2L0dEZ0Owc1w5DaYMBR8SrgzDFcGCUyvtll0oov4nMH1p4U"
+		"0dvECB/kiqhc8ezwxVp54WtgcOGrk3CMu+E4dBkpPaElXBJ386E0w9DTDs6aHssUKTFzEFhWkGHu9MFiNv4aCQcXz0Qd5uGK+Ic/"
+		"CfSycOY9rC02vOUfF860zAUuy1E6rojqAXf3jIiCGs/qSPSmFPYQRzkzFb0oJlAe4S+qUYtsaHIn2BdFOIvksUmiBxRwieMuLnDP"
+		"fhDRE8FdX5DZdMUS6CjbQ9DHHnAV8rBjI0gs6hWwxCyiYCWYjJFG0rGNn+E88gsj4WKkRlz9dzwnmSL8QvQeF4x9IeiNbPCxNITH"
+		"BYnqahA9woeRtompM3B18nG3D4g7fRZLYOKKNexFCnwGhsg4gRWt2BZUY5maQLcU54AftsVbeMaWiczPOKbBMEtOLpTzUtGb1fg7"
+		"RojNkFjyGMFeNOH2H3g2H29tQvrkEqFBPozjkJE7o4THsnAW4ugzUBgtC9xzJMQOyuAbaMY2Q42zese9p4dg8BHRFETdpAkZkSRy"
+		"lS32eUiIGYRiHtFTxNreIrIfhV7No/ufC2WWgujYwO4xpNFxEtYjYxSURJwXiX48J3bfYhZUuCs9zKERIqcmSBvCwix40e6wIDy4"
+		"R8RgC7GD3ETsvkCUsHiHdAgM+MAHwAiVoMjjonhqU2J6ZwQH20hvTWMfaiG14MN+wA2ehi22th7SiA0XngYh4eENvM0AHK0CwgkM"
+		"73gTocY4jhFx/FMQGJ07HDU9wTYLUfMu8BDH0aWEXU2DvWBCmh/GNaOGMRCDPf/ga1tgDDpjTiqROTRFYkYieqEPcq8E77gCZiOL"
+		"iNYaqWvPMfr2RDbYcaRP4rdQYtRyeCYfSVtuR2RXirhSneSqnYQRUQLb2RXQ6wn8Rx2hhCBiBIPE0MBVfnNhiQT8IUfksD/BQQsu"
+		"tJQCbzLi34iPZ48gMTEDbwPjLhox+224h0NxNk7gfQ5s+8rxXJWCy28444/YfEnc5Ct8KIlg9OHslRHIRhhn4GAdgEAaVMLSNSRc"
+		"FcAHEPB0yQjMJmDPiPiamcSM3xPs/2GWkfhmFMicxMGVa7kUCG5gxMwU2GpV9IkQUhpqSDsZ8IzmkRYSmHkQ95gWzolsnBqQnUxM"
+		"Jwhr8sI6hYXZ0yOrTYPvMg3sxxsQW80TN6eJtWNAag8GuZYkoqeKOMqYwAJWLlxzRuABKmLzMXafEt9owNtkJGbITwF5gR5K5kQO"
+		"OLS+FkrTAwsb0d7ANqmI0ZAl1ArBnZUwGjiERz0INx9xH8tD8KJTlPUmRM8R41i8D0uIhIIH13g2gbYVsXkVZ2MF32wP8in0iM4Y"
+		"kfUOtg4zajVPZHrHETDEzE7hGMfEGUiEixfiWsD4ekZUGAUjduCG2J0isDSKOhKKde4L94QltjgmVBMTSOx4ghFbCYC7qYNnIoH4"
+		"1jjKcn3Myhnv+T+Yc+IoxxSQPLrBhad8wzdKh3nRKmKFE3RIHcchqNCpPJTTo8HqSShzsGd4LLckIe9zQau1cI/roldbcI/h3f1D"
+		"uD9BsHeFOWyPOu4HAHOawzE=" },
+	{ "lobby raw, level 9, memLevel 1", Plaintext::Lobby, ContentEncoding::Deflate, false,
+		"hFI7EoIwEO1zih0u4Pgpkco2DZ4gGgpHJhTB8Ux7jr2YTMzHbIg0bMgu77MPKXvYH44n6Sv0yjwHDZfpdRsHC4TAr9grhE+vg7KT"
+		"AUHoT+2s4T4qa8/N+2Fs07W7WXeRqWgTuoGl8E7kkBtyg4YCwTf+WyEkFCv0TpZ7iO+xgl7qjsIThPcoBCNfiLNhCGbiLUdnANl2"
+		"WSicK4VUSzPFlHyvrOZHNa+EnLVuxcGz8WwbohppiDyMb/ytH0qrJAFiEITdeUX//8qh02qVJIBXWwGz6bVvc33nGyLIBQlWkWbj"
+		"D+MEIDQgqrb8gIEeRnL2KRpJcVergQUc/evAJBerJY591DP6CNG7HTMzmYoq4bbHLVcpakGHWObRM32KSq5I8B1RrcnEA0IWkFXj"
+		"iJPOn6XLLhEx1R3Z8tMoJnr4+RmxnWwibWN+KxbBzlaa4B51eHwtDTN07bnfSmCwOoO2Aq8ZjBT6r1cIqPjKU8pEU2e1PHeIHw6D"
+		"hwKeKH3a8FWaAzlxdnYnJa494BJQI16YAMLz5WpraZEMix8Trj27u9Z8kHKAu9jmq4CogYf8rIWaKIXPk+UFaI6i3rrkaVET+OPE"
+		"XHIghGEYus8pev9TUokSCLYbgzQLRqKlzcd5CY+79UkicuclIx/ZkWVOOMBq4A3TTBPwNxZWuab7E8XANZiLTbPWkEYAxLirmoAt"
+		"hiwA7oazCA0O0dgSXh8OuSeDPLNosOPfjWj6GPKbLkw9MBRbdIJUFW0+Z0QSUNQdzKBG7WghPpZg7/anaXWfWHxG71beMCNhbPmy"
+		"auyLBggIzN+4c3n+Y0d7ZEfHXSrVY9PJANfKqUPupmiW1ERsieQhQQv+5apwGI8ArHV1LrF/GRzQKKk2qR5uVURfIxwBRU14vNSK"
+		"+3AGJNWppUzZSMXStmF+NMaPtvRa/OxU0Au7ZHTriujl2uJZaa2drZEBHRW3vG70O6Km1SEbIKZw/MGZuSQxDIMwdM8puP8pO00m"
+		"wWAJ4azbcduUz9MznFq20cIVhE6FDMSbTH8+rmfZVRg+cJRiqfEGVJsyaedvY44TNNUEbnDBzHjP5jqtV+vs9+l/QBVxzanpY8uL"
+		"C1fsz1ccfJl4FO1L0ftH6WJWVqpfSz7OhV1ATrdoPogxqMonYbu1E73CQbsUPU5xNg/BLAsl4lv62Ud3QuACZVnzp1B1NgNCFy54"
+		"59QNicZJ22Z79wthCyycB6rcC9v8JyzZpq7kNqhSwuKt9MDQ6tEidDQSrKd6quuAbGowRrfmU+FWkz3Zn020eO4DmREfZNEP6slj"
+		"RtG5BjlD3aDelf9/Mo0qivbaBnE4Od9vLfvpoTKNWm7vt4LsKFcKcuKBw/Yj1VyyEIZCGDpnFd3/KnUkvyTk1IlHJ7WlPAg3mGXo"
+		"JfcAifW3SWdaqnE5NADoLWeOwnxUpeDYY3At3e3KDQ8CW77itG6zKK72FvuckT1+py4Hs1aCaVcU9ceeksaIb4lUgjZW+vSGQt49"
+		"DqevWdRAdrb1eGOOBddyDEsFiTLKpit/OcCOA4O07k+bqfaHpXnNe6xsMq7hD73pfbE4ITfRKFym/tIVTiM8HyK6Jtue8p1u+8zh"
+		"szln0ktwCc0SZE1IQMNUOpRYc7lMPXPXb/R2hcR7Antcl+ayfaVuf3aZXbfOxgcY556qPQZw0kwp5PRpuWqhK4DRP5gl59gx36f3"
+		"FxFrrhnKgB4VUsyv/YxkbdeGEAZH4LU+0+qip6txMzyz2ZAVuDrrjyA2/bBubTcMxCDs31Ow/5RVqyq5gA1O1Qkq5cD41fT8aKov"
+		"yO5R4LQU6iCmHzmfe51aoEE48RISY5MLrJf/XOIYt0io6seCNxk3R3Q+d80nCNdd/VgaDkOaRZiOEpf2rmtZhk/WXCXQWzK377GC"
+		"MsuCEj6TMzqhmGg2cQCKmWsbaEYfI+SV7Z38DMy3pRI+qbUKEJjzzYmG5hzYYO+mfC+tZTbutispDxR2sWdofbqegen6qcKg1tUG"
+		"B6g7Nugdr/tSuP2ba9gPMtEvlSlMDUaeIvyOICcBuzBzvGwrJBSnhacTsHbW/JC9s9G0L75ceOcWqMqV66tn7HpR78iBNBGr6lJZ"
+		"wNf1UpXloqD3r3+UMGi3YNcSDuBc3e3kLSOAUg2rGm6EQFhq7MW5GdwwDMMw8M8ptP+UQVEgTiydROdfoE1hU+SJIWczpQVMH3g0"
+		"SowUTteMSg6mZST46fyX+CZSolaCNK9iagI8ro1xx65C3S5/Yf4h3p/QyNEVbOtYrO9unyO+x+Ktvork1gbAjuQQCeFqz0Z6EPpS"
+		"JeALh9+Xbiy/mMitmYm1xqIU01DFCYBmF9yoF2q222WHgLQ+q7UgWkJHIgD7BmtQZTShphj1M3f/ypMKyVSpm6fNBJb00NurpBUo"
+		"spgkfqPCnq031Y9ld13QgorI0GtdE4fBwvhaY4ydWJwX2EfB+9hif/fGuG10H5aTZUp8eHJFMUAs0z3RyLZH1NzSgbzWxm6EbV6Z"
+		"as5SBZiytsL5hJuWkHKf98ZNWV0wfZxwqOvi5MyNGIhhGJijCvZfpcd2oI94pNChb3g6YgEIEJ4OW9qmvhP4BiyfW8QepNdwZFJO"
+		"t+E186pXoTot9BVaC4sq04P3SaE8599+NMkhNqei/kIbkESXenZS6dLCt3fL671SGY1goMf41QrrQddbfcar4AbTvl+v9GMJ5I2X"
+		"9TTpTRAQyTixQOWbXELMx7SyD2skl4Tkl0LOl9lIVGvm1hl62FWQPD6bX8yCAUExZky0FOq7LWVbmrmcsQScEdwgm5AtUi7dKkai"
+		"V01HCpM2u4YscVcLxGeXLpqw/+qegbg7KH+BRAB3X5HKNxgYLCHQKUhKe6abXbgA+03dsyeIS+gOOjSx46+s9tMxs/kdaFlSyg1r"
+		"Shju4ixQw1tFeeEBTVo+OboJSMPObtVvceaHkyu5YRiGYX9Pkf2nDPIIINm85AXawKlVitdxvN+rYbss/xXCsebydMEWNXAhuLao"
+		"Ru5l4tgPtZ4hWFA+mDnnwPatfk2zR+AXxgdiS1gmJHr6pBbsALuRZwaXvpG7Spl5zYoc0QIb7+DCuKAMdlF4HUE8HLzldMO3AeOx"
+		"VAg17hITf6uJpwGwUYV2yK1JfdvktIOHNkKVLfPPxKhXPb16os2FvdaKOB2dfwevCdUkYaNc3vhxMLkiDD5uP7m0lIzcBlZYPTTJ"
+		"oEcBf5XFaBXvnEGo7oaj93mfMw+EQKZoIK+7HFVUbol8L0avX1BX7N8GDaF73bR4BZf3mQjYuLqNRncyATnUWqFvrCN690m/T6Kz"
+		"QBsDwDVK+NQr3aIFTBCsFrAEJ2HGcRhPqhdpuQzufmD8NITtd9Qvz+vD5dwFAlgm5+XtTG4YhkIgeqcK+q8yh/jwPzALVpQGYinB"
+		"bMO8cJvyc4OTVpmznAAG4xfdRTIdfzRTjBsyK2r4qQPSizzTnI8bKpYvJDt5tTeclVey71Oxe/vYfCwqfA5dFlRb4t5vPaQeo2J9"
+		"yoOXNhcKKbAalaB7JfXGKrQubamE4lTLUFwEn69WDyMXdGvLzk74D8K0g/x10hSAfCjSBpzbXrgYYDYSAqZ3v1M48ec5x9gRdUGV"
+		"iJdJ6uT3/nEBJITD4diRTiy4wVQ+h8Ugm5umAWqw91ZU8kdZFJ3QgVwVobaTW3jN3UGPDuowPc6AozEXnZ0JQAncIawVgkRCrrEe"
+		"/BE/AgSnkbjnoS3/cE0uWf4ddafUii5WtIla4VMuhynJyuYbimfvw7RApfQAxDpzCyurHf/Xjzh6rchh7/Uh7UxSGIaBIHifV+j/"
+		"rwwYElmj3qRcAw4GW7N2telOarkgn0n0w9ujThBrOnn6FRQmFqPVNjsOuMKZXFoxbdOhwn6h+kE27zpTzQT4Rpfp5+kBZ/Q6cveZ"
+		"y207guTCd+EHfguIRp1UjIl5I9eZXAXhC5OXKjBqmEUtRoNp07FMO93+xwQseCa4C1PAsqIKa88IO+kD/jszT9kEGsKrpOPxR1rI"
+		"Hhzp2YMVm4x/Rd/lemL50rjO9BB7ZRMgwHDdvQTddAc8n7tBkw7VyNajbC86b+t4NhkPFNjv4uMPB04tudDqH8t3ovuPDFBehnM3"
+		"3OMAT1Z944wz5Gh+Ri2/HKw+hCuJZxErZlzKaA4eWDqYC0atxj2LlOQM1uRX6odK/WHjSQMOKb8NzBlrjkquAVYTRLc7hHpI5DjK"
+		"kJ/5235IO7MbhmEYhv5rCu8/ZYsAQW0dPNwOUKBIEUkU+VRFr4iDl5rbajwY/cKQHQuYTdG8/3u2+bCa+Msl7mfOZ9Q6AAoNWzLN"
+		"NqgDNlwYgndFcQdbCXQ30fuj7AnOkOaImBvb2oGOqu3+axRE/GW9ALv6OwHLddz2P2xTxw0/cpMKoRGnjOfE68Vd0J6KXpVGxNWE"
+		"bx9LIzG+rXnDnpRFbiF9QY6SYIVgv12nwU53XdRhuUMKufolnDjYjpXuiy8Q3oQau/KL+fsBDSGXNxyys957Qb2J0gglzzyeTsdK"
+		"70Y4pvDqaccsOZfoznTUaOe4UetZP0iCmFwlBy/t335DyxbQFAxQsvBTzm3IeNJMOCdGK7DK/ZP+MaFHKEuVA8tHz25nJokZav12"
+		"Sr6nmOXn/9YJdsWzC3vGZa66ZNhimQsQUfanokV0O8YPa1dyxDAQwv5UQf9V5pXEGAmJtStwxhnvgk7CcxfhHoUSLS32dwbmR2Pf"
+		"2zgcymOR/4LVPuAPVSkq0zhORQ0e+Rr3SCLX++qqgnoGDgmcjoGn1FfBD0AYVjLBJuAPcRozHfxe7n/9jJwYhUMSJ+mJLA2MOCg8"
+		"sMCb1BUrgWP3lK3fm3pEcEyLhxLRTPzLT3aWIC42Vf5sYmZ+UqaB4w3caz5OxolHxSGOF6HodlMIWINxRpk8fs/E9v2hYdkLBIDR"
+		"AJXLzVxx27USGa6ACgwhsTyrWAfT6qpgjXqE4d3l7aFSWljCtkyOOEdsSQ5pDM8Ws5X7rcpuAOytAb2gZlMAVZyvEyPdJCjUSodx"
+		"zNGjcnTLLjajF1CwbS+mOzFVJBRyX5ywRP+xuom3TbZXZ/cm4mwgEvxpvMj1QTzLhHF0TvwzlGMKSB7d4MJTvuEbpePCucIItvAK"
+		"15VF8Ive0BZpKCiQnTyR7sHEs88FrdYieOA7eoHKxYV39w/h/gTR1yujdWrh4gA=" },
+	{ "lobby zlib, level 1", Plaintext::Lobby, ContentEncoding::Deflate, true,
+		"eAGVnE2yZLlthedvFRnagMM/Q0kjT3sir6Dt7oHCitag5PCaah21MZEgDsj7HTBTmjy+SwIHBz8EmTdf1U8//en1r//27//xU46v"
+		"P/382//++svrP//6f//9l1+/vX58f3EKEi+p/tevP3/762+vrx/f87ff/+2X1//85edv3/7wu///82/ffvfH3//L3375o8Rftvzj"
+		"ewiMgYplQ8oayU0cDCEXwB2PP77/+D7om3LQih9f61fyuzn8KuIbIn4bdr5gfBiWVyHyeiVqzdIqAEJLwhp7v792kgBShAXwCtjl"
+		"dxOag7U0NP74DuyvAu8jDHHhLAJfppOu5fAlcaDgsaKaaqO+IfH+0VhA/CtxxcbkvyShEQCmYBO+cdKmSVoGxAo28SipBg/eXQ2Y"
+		"KkyothPPXRKHvuSIZuaiZvYPxVpmqT+2I6ZCVyS89gats5dJMN1Zu2XtHOBK8qF+kcH0codNQICzU1OBslgfGshnmICUDChVXYOE"
+		"iqVDGBrv/eewkr/mABNCmi37uiQwCGh6+G9Mm3rrgtKYPTrhu+SaxVcVpy3JyddIbpJ+QJvrKSQ9W9eCxkAzs17uJvIAyM3gamsf"
+		"2NZiWco1ziNteExwozay+tFv1b0sz73cADUeSYNc+0jGbNsH4AwSx5BBGo9hBXNKkLtgfkrUotbsBcm+7PqyvDTwxv4MdpYM3A5H"
+		"ajtcPMI0HkVQ49yo5pgW7SyW7cbzfTtL0tnkC8t7CbNowekSl5GpDb/tfmzvlpPGDYRL5bxygsUZuVXBo7flrx1lgdie4ATwA8uC"
+		"4nFsZryskkRnAnPpSSUOy5p3q8G3iWkCJgP1lhU5Te6rb/Sa+UOGNFoktKCRBcBnOPIgkDz8otMqGRU5tavRRADUhI/lUJyamH7c"
+		"O6kMq+FzLh0Hsva1xuauNDNS/SBgAI3Htf0/R2HiJiETtsbU3UjEWVVwpOCsItCLDcuAQyZpbWDfVdDAozmE9TwTIrSbtuxpfOTs"
+		"Mfl4UFbNaC7Qdj+ds2GzemxOao1hi5cCX/XJcd7G6tPmSX7MizHIaFqj+aAFz0AYiB+SIW0Dq17TXdXTcys9MB6+GK4IZJyu3ppi"
+		"KsAEHtViZOXhs0F+6fo3iysbcGkygfvFg0RoG89mrkJawTeRvTIpBfvX7VIEc2KlMeOlnW+mAnwUZHuzfK3IJMa4qC2pL54WMqZR"
+		"RnewLiwxHWSkfH5S8SyQQmq9zzTM4VFuWozklsaVED1ZsZHs2OI8gmB5hbWyrmTJghFikZ7NW1hSVmDIaiU+V59DdSRhjB18NCSj"
+		"Q28Srdn28yhJ8iuIhsVIiQJsmB7rIeFj/5jrnFCMprR/HNEqtcKEEXmGcva+loPxJfrX8wZRxRFwiopGYzHaNSJ2FTXdhwVbTf/8"
+		"TkaPUvBqF+ur1Ugai5oeWylXcujOFujOivOzcFT0E+nrrPBzQyGOFpA8PjbFATTCL/jRM5nayUjiQP961eZLevUcaYF4zFmqm42X"
+		"YCFvfMSlX0U4e6F522zrvLA9CLU0FRvOC3AuzsvHHJcNRdb8CJlCpcE84ladIY5S0mjQih9Be6drs85SEObtBLf0dQE/Lg2gHgxm"
+		"RWUC2ixAx0sybcJ0Uff9E2ZTPHo6I6ON+jbea9HRZfhJy7ICtyoG5KKKEWy0BBEESJo0WxI/HRceIE4RLN3KfFT4vIQJMJNqJCbx"
+		"G8HZ5dZOGmApBOuxjjk8emnwRDZSr92zrn3tmcieHZhoz8/IdMQTRCEbLJb/mhh6ytkILcCHLIskbGxlKOARxg1MOJVRTXSemHb1"
+		"jJDegUirF+4GA8623qfBxEYgxd56lRZMCbYLAfN4VMIwLSvN7jm6npQjaB6jvkt1+WCxgE2orB+sIRHVmKmr/Xjs31tZJ/u1ky3e"
+		"Hd2eCkhzF/M5otOeHWPzyJ3r5zlLf3Aqt6Wv+gU3PKZuaafWvlKZNeADT6vzhoelPnRSuNqxhaYwzZZXpM8Y8Lz5sMgyHvUSCT5p"
+		"G3QZhqhBy3OOzalAEUAr1X2ExRFKwkxlPUJqQc5aTTms52y/aGlx1wJ//u2RhYeNYezhJeySad3M6Y4i31xTK9Uyw4RmG1ZpKo+/"
+		"m+HOHzPuew6xDS7yoaQNhxeuJGVy84yu7iIXV0tvHJWAwn69bewFi79RqO/MbaXZnkfRKeoihUA19KkRsVw/uMW5dwEum167WgnY"
+		"qqBVpWvusBrtvu35I8OVhSkwvJmD0G/pXBY8bpKfGHAlVDA38psaMgiB948PqoxkZw9wY6dUTSpn91I/ay3A1w9mVJ5YlWmrpCVy"
+		"kZ4VcsrnkAmCtpQ3L81ojBU9JFY5rywAdXucCgFSWk9ibJmyYXEYURcPjXsmtUBkleiWDh5efRKYnxBA7pUfLZQEGBiFmPtAGKmf"
+		"4Rbc8a6Oed+1zEjI5i2zAqeeqBw335UAJ59spaHxGYRQTofid8OJWWA9AwEVS64sj4+43JAJZCrzQjq+f2A8bWKfH7Ykq2DHwI3K"
+		"czvH28ByNX8xOHJMOSUQ8ngUSWMfUe9O7REXYDTvGAXL0c2Q/f1AFJZh1FVUEh7PW5ody3WPFwxw3LRlZp401ZFU3PTUtIGOx8Te"
+		"XUkJbspUgSgdYNmmHzUonZV4UzCVxIbgJ6fiK2cTsombNSs9sZ5/h/n+FEq+lRazCU9S/pPYCpdJsc+k2CyM+BXG8Oh7TH5qhAIe"
+		"w8T9ela5HkHbH6/NB4DK9C0wWocaIyExjbrpQU3LHI2lT5x3xeuXxaNYbEOeirJrUscXwxfKfR2uClAVVgqAgUezHij366BYryt3"
+		"fiZbEc67RgAkC9tlsSiMcQa9KSFjVmoJDk+6Uy4lWSHQTKngZlZjll1BVObxFTuOmYaF949mE+LLRGtHRPqQHJ+LAOmHkHcEtf8R"
+		"2BnbaZ9xWIn3JDa1DwJJWPwDXdHcJxCUqrVaXSmFzIMuoe5vath9Le5lsNvVqe17tZnL5iSzaQdm+lJqYmlpUBhr09dEuplDrXNH"
+		"zJ5jZbhynqpCxGPnwr5hdf2uesubW11EQhaNV0PVZMDruO4GNpbraKdc7iAmr+JodvdnMFsKwyrIq3PPhDHTe2sIAJ4o0dq8EtNz"
+		"U3aPNNOgefHkl8W+adXETbFJXkVTZOGTYjb6Q6P9vlYUD/qV80mX28G2JhiJ6DMYirG5bhPSvze0VSymGNNpFZwKi66GTjpqgAAR"
+		"sZ3QEXRNmvK83M2cjOOBRsfS/D7Cj4aLwasNM1rVkH+9V/0EyPUy5COH8Q6EG5zuFL3Z0WDIlL+qoPtMuUIvBzuZwpRdx82j+HNl"
+		"ntYPviFkRoGu40vjTrufnYyOx8+sVXXailiDz00OYpX9cBKLx18bVbFAJK3ngEX367Pnx/uaWSuruQLXfAvyPYedhxC6NcBDjLXc"
+		"4z5LxPwC41FSCfOsrIutEuK6e06JaCiw3uW2TMwodwLJ1yxKkWNn05T3n4IoG11DCEp0bIeQwR4r8+2CCNnhowU/pbQyeu3NXRqT"
+		"SvA3/7ogVKXQ/oKYzgp0egKI2Y0wJWlMG5l0KQc6EoXyFAlCKtRh+IZIQiByCyXVDH5Q+kd9aw/N1XvBZh6jzy432lrz9z2H8QuJ"
+		"J4qxT7dhvoH93BZFwI8Os2oTsB85xVx3r5BJjjslgTTciVFizwKyradSqCYjPY6qugBPrW06si2V+dU7HNLulTn2jo+VNw0If/mp"
+		"p7liMbYJ8hmbVgAcP+mmD1SjBTy/fzSbowIatwAiCo1kM6UcXECMwmxsleiIuaU1ZiuQzZMYFk7+wnzLUC7nYJTCgjD7Vbuod3Ec"
+		"0ZkFfzXD8pTJVLjf9SSIGHub6GYmJSiajzfKCqAINPkn9DRXHVN6+2V2WtrbLidGc87fpONlcYufNDSWDfPzPBKIllqmI16Z3SYE"
+		"PGLFoxFNI13QngXf9WoLkJ8oUYBVSFBwcfCovAWMRWLNzgRzo5loOaNYmKUDLH4tDUbTsA0KE4W0i2xEs2YzKE1yFo/10WPrrtnU"
+		"MjJqf6oSEximFQN6Jh2tww88jsa588Pi3RtMYCWriaLxeHGl1RLfgbINCEIrg8akAi33Qk528quPHd6ZmgyuVdUsNQvoykf8BCG7"
+		"RGPdoYw8NG5Zb28HKSxnThc/W17BnA6Pk+XjRk0bCmo+gnx7LXZo46Z0sFxX4GETj6Tg5rRhDN1ykV6NeIgR0PFYJZydOvj2oRFr"
+		"ktB8QQVGm5EEtuiB1D/1GNbeazyZiW9zN9aSoriyZ3QlljG7eSUxZeKMrWGOTqUsh5yUO/fS4MjxpS3tbVQf1r2oEgWhC3vGziaa"
+		"k2B+eJSr9lXXLUbP1NiNcTsywMmUxT/MG0/ZjQP4EVigKd5xYuhB43GKrIiPD8Va0wi8FcdpVgLGbZjSWqVpVIE5WukOTIVYqgYL"
+		"IqujJYbeuCosDKF5Zegyq9EEYH5x/iQltNxRwEi21+zuU3rjAAKPI8i9KcgZb6U/3IJw7sadeUX5UQXng7LSfCtwHPFG4hJTmWNS"
+		"feuDeOApdPFQEXVd26MZEivbB+Au9RUecpy9TJXd+/sgCQdkaqTVlHlclWsK15mQKguD8eKT0QexmqSDaS2HrlUFTm3AomlMDohJ"
+		"PdT2XBGYa046BfPvZySs0eW1goCfRrGExzQYClgaQdCRl1I5QM4i8Gk9jDWlcLJ+WjQT2R122aa84sFrdy6HhZsMaEvlUilC0Tii"
+		"1bj0PD9hIdiYazFbnx/gl6ytTX38tagWOhPtpRmCDBiW58bT/ueO7fyuffKIuEI6a9/6ESz2cbm4mcCTJWHO9pFiEBEmR2MggdoW"
+		"KwsrjdMOgA2A69EDmvf3vs93u/nsD6wcf0MoB1ZBBO/yxcjahJpBjQVnUQcFg/KJ6daq/ExSWYnS2xsd0HjcX7kmjDhqzGkZWTHQ"
+		"osZc9TRwl+zUm0dlgf1j68jc2EBwI5UlkI+hCUk8SkPRCxVNaky4iyqmU1gU6E01OHaFp95tZ+68WgCD+ghNAmXHVxNqdg2I71KQ"
+		"32YCGvgHMFgVStvl9yK0qhFi3rg843XHAw4eI2jjO8G1w4UyniFX5yfmlea5HeMS7hfMG3Mr4p1bGFltU+SCctrVnMYm1qssgDgO"
+		"p+smgugbaPcVulWKmG/bggylElS02n19C9Gymr88h71DyAIwEThLHoREy+TS6Jksb4/Sfia47UWrQJ9lKvUszrCludpH3ZvEkNyv"
+		"i58B6mqIXYyhu7mPaJlYECFYugPd948rgs2fxb5Xw6rx4/rc5iOgmMajUpBh7ZrJRWN3AGDMO4mmoJtWzhp4FALE8Vja/bwF5CxD"
+		"r+d5aolmHTxpQvMwpGnGNHzYaEbEJ86L3v4CYwRuH2yT33s68b5qK5iV1Lb5um9q82pMBdY4ohDepuj4kLKiPHfudCrnoSImqyQ3"
+		"5bUTpqehDC2FG9N5kmNWwgsSi7MRnyGvyEIuhHYij9cip7YFNNSWhfjVBIpcBiKHz/ecFMz42Cn8IVOpLesa6585Gs9qxPWLi2xK"
+		"bLQIJh5l3RBtAoorun5+CxDizW0UEop+d9oItD+8aueMhND7+rDVrPVVMZm2reSoJxQuxUVXIzzVdABirXqeeWITzT8MbZw82r7s"
+		"jvtLmN5bqsEGL+miePHYvLVVF9svM1Knstan4WJ/w6ULkFP80shzgGwuZq9sTv4RqBE+8Q2DikO9LbLQWTuA1eRtemLzpFzmZTiX"
+		"g5nmYIHlyH70vlUL9Oic9/fQRW/TMsfAztaNblVGgorRbd4QS6EapiXFdLyTmYhgGU8TTN50fJ5WmNMx/aitVDdY1bb+2wgTADge"
+		"K3xHZuWSe28RGxtY0s0JaX80UdcHKVWFkJblXxoTQr9TSfPNroVoSRZ9lFU+zs3uYfAbKuCzl2L2lkJLmdhVcjQBQE0/CgUy+xtY"
+		"M7MD+RbA/b9lDaazpYwaCXyzD3F5k+jj7YlpPC6uKQcUnQXOel/eD8d5NRAJe1NjXJTNuYFtcd+bC3CW0orDeUFdoamOaUDqBVlR"
+		"7lUTJbai5gKAoA1ug52oVnqPa4IRA4Kt2wQUBrZSpYQf5ooCtHbmRNZaUqpqXf2xvDNi1QJsBcYF2Vdz2jWQ6CAz5U0a2OX2fchg"
+		"wMULwTTqs0NkN0i3/8UckHeNYkEliGmzq5Kuos7I3AIEvKe0Ys5I5T8eUwkZiZux8A4Wi+hjFzTpgh4e4x9X3uzKjwximey93dL+"
+		"G6wem0alDgk8CpERhRgeI25PsivPyrZlwCa8nZvI54mkwBZnirtRNGbPBmya4WkFaYR3bQgeFIhPNRF1eSFAzsw1ZbYMniQ/gXxa"
+		"z90CseJspCAoXyzqk+Ol6tyJTF2BjVc2I7oZX82m0JE+rRjJZzWCMh6vfcJQa2cC4VEWadqUfWJGqI6eVAOyAliuhylv8NdAaAG4"
+		"vbWKeC6X1fwl32KAlEzsrO7bFMxKVGNeerh/jr5lUdOem8ELi+MEgxXTsQkqRK1ykqyw7r1DXkFwRlVLfdxzlrUwTnyDMlcoAo2P"
+		"8qp+iyKAeuYj+HIN8mZYcpnA0Quvup8/oz12HCwn0ysBW3iANT0X+HisrDkuK8hinFSZf50Tys3aWY52RFDR/Yf/algKGllH8/tp"
+		"WvSJuXGEgLhcpitctzTtD6XnVo/rV28/gZrEVfw+OpKm5h044eBN2JdLGu+HpMcuYevN2Pi/J83EsG4u3sIk34oL0Iob5s3AKCKb"
+		"s4miXbA3Xqyj6yYHr/0/8cgjjdieZHB+T2kbzBxJ2u/exnruxORyXEUrc63tufTDE/itw9SYsjyot8gI+oM0lKXlRrUChXkbu2U8"
+		"56VZ+QlvWQ55hZCwqjgxYBWPO6DVRJom9c9Fwkx0fU9FA+GcbvaPFI4G7fVhwV8fl2z6Uf8KHKgMQ5hpo2/YxztaQ1gFBljm0xBF"
+		"kILA6RMepA0SqraeWKEMWTyGSO395u1tCJQLeSp4ZEa4WWbXfdx7KhvmjE30+vKZJ1vzyu841PYOCkcFMk/x9FW8tDFNLnVKrjG4"
+		"raTwvXcIpgTNfUlorK2/rSDJ828ZGBaINFs2HD2v6lCR/VOkO68Dx+y3e6nCUsEmbRmVADixBis2GU6IGyvB20LqVyv3gI4NsO9K"
+		"y+fuQxQYlMHz3pjGAkQCtuUkxAj1nnZ8QSXr3WdpQZSCH8TfP0oTUhZtyXVVSTambBNCswXQuNSUqWWE9wUgrsIj/x7kLkSr8pW+"
+		"M+/gg0erABa7EZXjszQbboxkbRaztDuL2ZAfBrbcjADY10MjdP6yYExuwgmbwwxwIC04BMY42cS8rNlkYJmry0Lare0uYvtbgry2"
+		"DWCymRlN7NEQ9h94xlxTI8I2ggAWJzc5w6PTNgMlUI0e7oSTgIp//klyLgVhkHB3mXgomFdVZbKcjGv+73OawzE=" },
+	{ "sample gzip, FEXTRA, FNAME, FCOMMENT, FHCRC", Plaintext::Sample, ContentEncoding::Gzip, true,
+		"H4sIHgDxU2UC/wYAQVACAGhpcHJvZmlsZS5qc29uAGNhY2hlZCBieSB0aGUgcHJveHkAzKmt1L1OwzAQB/BXMZ4L/sh3FLLASJd2"
+		"YOni1kcT1bGj2EGqqj4EO0/C2hcjaQsiHZEteTjp/Psvvjtg64TrLc6x2eEZbsBasYWhfKqEUqC3gLRxSIKDjQN5N/RYo3pXG43z"
+		"A+47NfRWzrU2J6RTo2YfNDjSduatVkCWDkRDkjiKGctS+nNG55rMKZ3hDmxrtB2Ti8o1qiwqELIsXO0UlAuz2YFDLyC2PaDlGILu"
+		"0bKtQUGHTp+NEr1Dpw+h5emrIJdHBbkQayP3A9QNV6KNEtY+rnCrxF7V1q1wuRB6BxI9m36twCL+zgdhjJbla61tjuhvPZ8vUEav"
+		"NTmT/2eDZOqywI+bhFOXx35cxtgUDjJPcJhO4Yh7gtNoCseRH5hzPoWT1BMcZVM4Y57gLJ7AjNLQ0zcOghuZJb4GhN7IgafRC2ly"
+		"I4d/h49cVgY5LyJ8PH4D1Gv41SYFAAA=" },
+	{ "empty gzip, level 6", Plaintext::Empty, ContentEncoding::Gzip, true,
+		"H4sIAAAAAAAAAwMAAAAAAAAAAAA=" },
+	{ "empty zlib, level 6", Plaintext::Empty, ContentEncoding::Deflate, true,
+		"eJwDAAAAAAE=" },
+};
@@ -0,0 +1,227 @@
+// ContentEncoding checks: decodes zlib-made gzip, zlib and raw deflate streams
+// (stored, fixed and dynamic blocks), round-trips EncodeContent, and feeds cut
+// off and corrupted streams that have to fail cleanly. Exits non-zero on a failure.
+//   SmurfTrackerCodecTest
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ContentEncoding.h"
+#include "Vectors.h"
+
+namespace {
+	int failures = 0;
+
+	void Check(bool ok, const std::string& what)
+	{
+		if (!ok) {
+			failures++;
+			std::cout << "FAILED " << what << std::endl;
+		}
+	}
+
+	std::string Base64Decode(std::string_view text)
+	{
+		std::string out;
+		uint32_t buffer = 0;
+		int bitCount = 0;
+		for (char c : text) {
+			int value;
+			if (c >= 'A' && c <= 'Z') value = c - 'A';
+			else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+			else if (c >= '0' && c <= '9') value = c - '0' + 52;
+			else if (c == '+') value = 62;
+			else if (c == '/') value = 63;
+			else continue; // padding
+			buffer = (buffer << 6) | static_cast<uint32_t>(value);
+			bitCount += 6;
+			if (bitCount >= 8) {
+				bitCount -= 8;
+				out += static_cast<char>((buffer >> bitCount) & 0xff);
+			}
+		}
+		return out;
+	}
+
+	// The same words in the same order as the generator of Vectors.h
+	std::string LobbyText()
+	{
+		const char* words[] = { "<td class=\"wins\">", "</td>", "Ranked Doubles ", "Season ", "MMR 1234", " ", "\n", "\xC3\xA9" };
+		std::string text;
+		uint64_t x = 12345;
+		while (text.size() < 36000) {
+			x = (x * 1103515245 + 12345) % 2147483648u;
+			text += words[(x >> 16) % 8];
+		}
+		return text;
+	}
+
+	std::string Plain(Plaintext plaintext)
+	{
+		switch (plaintext) {
+		case Plaintext::Sample:
+			return sampleText;
+		case Plaintext::Lobby:
+			return LobbyText();
+		default:
+			return {};
+		}
+	}
+
+	// Feeds the stream in chunks of chunkSize, output and status as ContentDecoder leaves them
+	ContentDecoder::Status FeedInChunks(std::string_view stream, ContentEncoding encoding, size_t chunkSize, std::string& output,
+		size_t maxOutputBytes = 64 * 1024 * 1024)
+	{
+		ContentDecoder decoder(encoding);
+		decoder.maxOutputBytes = maxOutputBytes;
+		output.clear();
+		ContentDecoder::Status status = decoder.State();
+		for (size_t i = 0; i < stream.size() && status == ContentDecoder::Status::NeedMore; i += chunkSize) {
+			status = decoder.Feed(stream.substr(i, chunkSize), output);
+		}
+		return status;
+	}
+
+	void DecodesKnownVectors()
+	{
+		Check(LobbyText().size() == lobbyTextLength, "lobby text built like the generator does");
+		for (const CodecVector& vector : codecVectors) {
+			std::string stream = Base64Decode(vector.base64);
+			std::string expected = Plain(vector.plaintext);
+
+			std::string output;
+			Check(DecodeContent(stream, vector.encoding, output) && output == expected, std::string(vector.name) + ": whole body");
+			for (size_t chunk : { 1, 7, 4096 }) {
+				ContentDecoder::Status status = FeedInChunks(stream, vector.encoding, chunk, output);
+				Check(status == ContentDecoder::Status::Done && output == expected,
+					std::string(vector.name) + ": fed in chunks of " + std::to_string(chunk));
+			}
+			if (vector.checksummed) {
+				Check(SniffContentEncoding(stream) == vector.encoding, std::string(vector.name) + ": sniffed");
+			}
+		}
+	}
+
+	void RoundTrips()
+	{
+		std::string noise;
+		uint32_t x = 1;
+		for (int i = 0; i < 100000; i++) {
+			x = x * 1664525 + 1013904223;
+			noise += static_cast<char>(x >> 24);
+		}
+		std::vector<std::pair<std::string, std::string>> bodies = {
+			{ "empty", "" },
+			{ "one byte", "a" },
+			{ "sample", sampleText },
+			{ "lobby", LobbyText() },
+			{ "noise", noise },
+			{ "zeros", std::string(70000, '\0') },
+		};
+		for (const auto& [name, body] : bodies) {
+			for (ContentEncoding encoding : { ContentEncoding::Gzip, ContentEncoding::Deflate }) {
+				std::string what = name + " as " + std::string(ContentEncodingName(encoding));
+				std::string encoded = EncodeContent(body, encoding);
+				std::string output;
+				Check(DecodeContent(encoded, encoding, output) && output == body, what + ": round trip");
+				Check(FeedInChunks(encoded, encoding, 3, output) == ContentDecoder::Status::Done && output == body,
+					what + ": round trip in chunks");
+				Check(SniffContentEncoding(encoded) == encoding, what + ": sniffed");
+			}
+		}
+	}
+
+	void RejectsCutOffStreams()
+	{
+		for (const CodecVector& vector : codecVectors) {
+			std::string stream = Base64Decode(vector.base64);
+			// Raw deflate has no trailer, its last byte can already complete the final block
+			size_t end = vector.checksummed ? stream.size() : stream.size() - 1;
+			for (size_t length = 0; length < end; length += stream.size() > 2000 ? 97 : 1) {
+				std::string output;
+				ContentDecoder::Status status = FeedInChunks(std::string_view(stream).substr(0, length), vector.encoding, 512, output);
+				if (status != ContentDecoder::Status::NeedMore || DecodeContent(stream.substr(0, length), vector.encoding, output)) {
+					Check(false, std::string(vector.name) + ": cut off after " + std::to_string(length) + " bytes");
+					break;
+				}
+			}
+		}
+	}
+
+	void RejectsCorruptStreams()
+	{
+		auto failsWith = [](std::string_view stream, ContentEncoding encoding, const std::string& what) {
+			std::string output;
+			Check(FeedInChunks(stream, encoding, stream.size() + 1, output) == ContentDecoder::Status::Error, what);
+		};
+		std::string gzip = Base64Decode(codecVectors[2].base64);
+		std::string zlib = Base64Decode(codecVectors[5].base64);
+
+		std::string badCrc = gzip;
+		badCrc[badCrc.size() - 8] ^= 0x01;
+		failsWith(badCrc, ContentEncoding::Gzip, "gzip with a wrong CRC");
+		std::string badSize = gzip;
+		badSize[badSize.size() - 4] ^= 0x01;
+		failsWith(badSize, ContentEncoding::Gzip, "gzip with a wrong size");
+		std::string badAdler = zlib;
+		badAdler.back() ^= 0x01;
+		failsWith(badAdler, ContentEncoding::Deflate, "zlib with a wrong Adler-32");
+		std::string badMagic = gzip;
+		badMagic[1] = '\x8c';
+		failsWith(badMagic, ContentEncoding::Gzip, "gzip with a wrong magic");
+
+		failsWith(std::string("\x78\xf9\x00\x00\x00\x01", 6), ContentEncoding::Deflate, "zlib asking for a preset dictionary");
+		// Two bytes, fewer could still turn out to be a zlib header
+		failsWith(std::string("\x07\x00", 2), ContentEncoding::Deflate, "block type 3");
+		failsWith(std::string("\x01\x05\x00\x00\x00hello", 10), ContentEncoding::Deflate, "stored length without its complement");
+		// Fixed codes: literal 'a', then length 3 at distance 2 with only one byte written
+		failsWith(std::string("\x4b\x04\x42\x00", 4), ContentEncoding::Deflate, "distance past the start");
+
+		std::string output;
+		std::string lobby = Base64Decode(codecVectors[9].base64);
+		Check(FeedInChunks(lobby, ContentEncoding::Gzip, 1000, output, 1000) == ContentDecoder::Status::Error,
+			"output past maxOutputBytes");
+
+		ContentDecoder decoder(ContentEncoding::Gzip);
+		decoder.Feed(badMagic, output);
+		Check(decoder.Feed(gzip, output) == ContentDecoder::Status::Error, "error sticks");
+
+		// Single flipped bytes: never a crash, and a checksummed stream never comes out wrong
+		uint32_t x = 7;
+		for (const CodecVector& vector : codecVectors) {
+			std::string stream = Base64Decode(vector.base64);
+			if (stream.empty() || !vector.checksummed) {
+				continue;
+			}
+			std::string expected = Plain(vector.plaintext);
+			// A broken zlib header is read as raw deflate, which has no checksum to catch the rest
+			size_t from = vector.encoding == ContentEncoding::Deflate ? 2 : 0;
+			for (int i = 0; i < 300; i++) {
+				x = x * 1664525 + 1013904223;
+				std::string corrupt = stream;
+				corrupt[from + (x >> 8) % (corrupt.size() - from)] ^= static_cast<char>(1 + (x >> 24) % 255);
+				if (FeedInChunks(corrupt, vector.encoding, 64, output) == ContentDecoder::Status::Done && output != expected) {
+					Check(false, std::string(vector.name) + ": corrupted stream passed its checksum");
+					break;
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	DecodesKnownVectors();
+	RoundTrips();
+	RejectsCutOffStreams();
+	RejectsCorruptStreams();
+
+	if (failures > 0) {
+		std::cout << failures << " checks failed" << std::endl;
+		return 1;
+	}
+	std::cout << "All content encoding checks passed" << std::endl;
+	return 0;
+}
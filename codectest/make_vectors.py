@@ -0,0 +1,132 @@
+# Writes Vectors.h: zlib-made streams of the sample reply and the lobby text
+# that codectest decodes. LobbyText() in main.cpp must build the same text.
+import base64
+import os
+import struct
+import zlib
+
+SAMPLE = ('{"status":"ok","message":"Challenge not detected!","solution":{"url":"https://rlstats.net/profile/Steam/76561198000000000",'
+          '"status":200,"response":"<html><head><title>Rocket League Stats - Spieler Ümlaut Ñandú</title></head><body>'
+          + ''.join('<tr><td class=\\"playlist\\">Ranked Doubles 2v2</td><td>Wins: %d</td><td>MMR %d</td></tr>' % (i * 37 % 1000, 900 + i * 13)
+                    for i in range(12))
+          + '</body></html>"}}').encode()
+
+LOBBY_WORDS = ['<td class="wins">', '</td>', 'Ranked Doubles ', 'Season ', 'MMR 1234', ' ', '\n', 'é']
+
+RAW, ZLIB, GZIP = -15, 15, 31
+ENCODINGS = {'gzip': 'ContentEncoding::Gzip', 'zlib': 'ContentEncoding::Deflate', 'raw': 'ContentEncoding::Deflate'}
+PLAINTEXTS = {'sample': 'Plaintext::Sample', 'lobby': 'Plaintext::Lobby', 'empty': 'Plaintext::Empty'}
+
+
+def lobby_text():
+    x = 12345
+    text = b''
+    while len(text) < 36000:
+        x = (x * 1103515245 + 12345) % 2**31
+        text += LOBBY_WORDS[(x >> 16) % len(LOBBY_WORDS)].encode()
+    return text
+
+
+def deflate(data, level, wbits, strategy=zlib.Z_DEFAULT_STRATEGY, mem_level=8):
+    compressor = zlib.compressobj(level, zlib.DEFLATED, wbits, mem_level, strategy)
+    return compressor.compress(data) + compressor.flush()
+
+
+def gzip_with_header_fields(data):
+    flags = 0x02 | 0x04 | 0x08 | 0x10  # FHCRC, FEXTRA, FNAME, FCOMMENT
+    head = b'\x1f\x8b\x08' + bytes([flags]) + struct.pack('<I', 1700000000) + b'\x02\xff'
+    head += struct.pack('<H', 6) + b'AP\x02\x00hi' + b'profile.json\x00' + b'cached by the proxy\x00'
+    head += struct.pack('<H', zlib.crc32(head) & 0xffff)
+    return head + deflate(data, 9, RAW) + struct.pack('<II', zlib.crc32(data), len(data))
+
+
+def vectors():
+    lobby = lobby_text()
+    found = []
+    for name, wbits in (('gzip', GZIP), ('zlib', ZLIB), ('raw', RAW)):
+        found.append(('sample', name, 'level 0', deflate(SAMPLE, 0, wbits)))
+        found.append(('sample', name, 'level 9, Z_FIXED', deflate(SAMPLE, 9, wbits, zlib.Z_FIXED)))
+        found.append(('sample', name, 'level 9', deflate(SAMPLE, 9, wbits)))
+    found.append(('lobby', 'gzip', 'level 9', deflate(lobby, 9, GZIP)))
+    found.append(('lobby', 'zlib', 'level 6, Z_FIXED', deflate(lobby, 6, ZLIB, zlib.Z_FIXED)))
+    found.append(('lobby', 'raw', 'level 9, memLevel 1', deflate(lobby, 9, RAW, mem_level=1)))
+    found.append(('lobby', 'zlib', 'level 1', deflate(lobby, 1, ZLIB)))
+    found.append(('sample', 'gzip', 'FEXTRA, FNAME, FCOMMENT, FHCRC', gzip_with_header_fields(SAMPLE)))
+    found.append(('empty', 'gzip', 'level 6', deflate(b'', 6, GZIP)))
+    found.append(('empty', 'zlib', 'level 6', deflate(b'', 6, ZLIB)))
+    return lobby, found
+
+
+def c_string(data, width=96):
+    lines = []
+    line = ''
+    for byte in data:
+        char = chr(byte)
+        if char in '\\"':
+            escaped = '\\' + char
+        elif 0x20 <= byte < 0x7f:
+            escaped = char
+        else:
+            escaped = '\\x%02X' % byte
+        # A hex escape would swallow a hex digit right after it
+        if len(line) >= 4 and line[-4:-2] == '\\x' and char in '0123456789abcdefABCDEF':
+            line += '""'
+        line += escaped
+        if len(line) >= width:
+            lines.append(line)
+            line = ''
+    if line:
+        lines.append(line)
+    return '\n'.join('\t"%s"' % line for line in lines)
+
+
+def base64_lines(data, width=100):
+    text = base64.b64encode(data).decode()
+    if not text:
+        return '\t\t""'
+    return '\n'.join('\t\t"%s"' % text[i:i + width] for i in range(0, len(text), width))
+
+
+def main():
+    lobby, found = vectors()
+    out = ['''#pragma once
+
+#include "ContentEncoding.h"
+
+// Streams produced by zlib %s through Python's zlib module (compressobj with
+// the levels, strategies and memLevels named below), base64 encoded. The gzip
+// one with header fields was assembled by hand around a zlib raw stream.
+// Lobby text is rebuilt by LobbyText() in main.cpp rather than stored.
+// Regenerate with python3 codectest/make_vectors.py.
+
+enum class Plaintext {
+	Empty,
+	Sample,
+	Lobby,
+};
+
+struct CodecVector {
+	const char* name;
+	Plaintext plaintext;
+	ContentEncoding encoding;
+	bool checksummed; // gzip and zlib, raw deflate carries no checksum
+	const char* base64;
+};
+
+// A FlareSolverr reply as the proxy caches it, non-ASCII names included
+inline constexpr char sampleText[] =''' % zlib.ZLIB_VERSION]
+    out.append(c_string(SAMPLE) + ';\n')
+    out.append('inline constexpr size_t lobbyTextLength = %d;\n' % len(lobby))
+    out.append('inline const CodecVector codecVectors[] = {')
+    for plaintext, wrapper, settings, stream in found:
+        out.append('\t{ "%s %s, %s", %s, %s, %s,\n%s },' % (
+            plaintext, wrapper, settings, PLAINTEXTS[plaintext], ENCODINGS[wrapper],
+            'false' if wrapper == 'raw' else 'true', base64_lines(stream)))
+    out.append('};')
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'Vectors.h')
+    with open(path, 'w', newline='\n') as header:
+        header.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
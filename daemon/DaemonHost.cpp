@@ -0,0 +1,45 @@
+#include "DaemonHost.h"
+
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+DaemonHost::DaemonHost(size_t httpThreads)
+	: httpPool(httpThreads)
+{
+}
+
+void DaemonHost::SendHttp(const HttpCall& call, std::function<void(int, std::string)> done)
+{
+	bool queued = httpPool.Submit([this, call, done]() {
+		std::string body;
+		int code = client.Send(call, body, call.timeout.count() > 0 ? call.timeout : httpTimeout);
+		done(code, std::move(body));
+		});
+	if (!queued) {
+		done(0, "Shutting down");
+	}
+}
+
+void DaemonHost::SetTimeout(std::function<void()> callback, float seconds)
+{
+	timers.After(std::chrono::milliseconds(static_cast<int>(seconds * 1000)), std::move(callback));
+}
+
+void DaemonHost::Log(const std::string& message)
+{
+	std::time_t now = std::time(nullptr);
+	std::tm local{};
+#ifdef _WIN32
+	localtime_s(&local, &now);
+#else
+	localtime_r(&now, &local);
+#endif
+	std::lock_guard<std::mutex> lock(logMutex);
+	std::cout << "[" << std::put_time(&local, "%Y-%m-%d %H:%M:%S") << "] " << message << std::endl;
+}
+
+void DaemonHost::Stop()
+{
+	httpPool.Stop();
+}
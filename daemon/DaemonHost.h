@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+#include "HttpClient.h"
+#include "StatsProvider.h"
+#include "TimerThread.h"
+#include "WorkerPool.h"
+
+// ProviderHost for the daemon: blocking HTTP calls on a small pool of their
+// own, timers and posted callbacks on one timer thread, log lines to stdout.
+class DaemonHost : public ProviderHost
+{
+public:
+	explicit DaemonHost(size_t httpThreads);
+
+	void SendHttp(const HttpCall& call, std::function<void(int, std::string)> done) override;
+	void SetTimeout(std::function<void()> callback, float seconds) override;
+	void Log(const std::string& message) override;
+
+	// Drops queued calls and waits for running ones, their callbacks still run
+	void Stop();
+
+	std::chrono::milliseconds httpTimeout{ 65000 };
+
+private:
+	HttpClient client;
+	WorkerPool httpPool;
+	TimerThread timers;
+	std::mutex logMutex;
+};
@@ -0,0 +1,249 @@
+#include "FlareSolverrProxy.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "ContentEncoding.h"
+
+namespace {
+	// FlareSolverr's maxTimeout default, plus room for the browser to start
+	constexpr std::chrono::milliseconds defaultMaxTimeout{ 60000 };
+	constexpr std::chrono::milliseconds timeoutMargin{ 10000 };
+	// Below this compressing costs more than the bytes it saves
+	constexpr size_t minCompressBytes = 1024;
+
+	std::chrono::milliseconds UpstreamTimeout(const nlohmann::json& command)
+	{
+		auto it = command.find("maxTimeout");
+		if (it != command.end() && it->is_number_integer() && it->get<long long>() > 0) {
+			return std::chrono::milliseconds(it->get<long long>()) + timeoutMargin;
+		}
+		return defaultMaxTimeout + timeoutMargin;
+	}
+
+	// Origin headers as FlareSolverr relays them in solution.headers, any case
+	std::string OriginHeader(const nlohmann::json& solution, std::string_view name)
+	{
+		auto headers = solution.find("headers");
+		if (headers == solution.end() || !headers->is_object()) {
+			return std::string();
+		}
+		for (const auto& [key, value] : headers->items()) {
+			if (value.is_string() && std::equal(key.begin(), key.end(), name.begin(), name.end(),
+				[](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b)); })) {
+				return value.get<std::string>();
+			}
+		}
+		return std::string();
+	}
+
+	std::string ErrorEnvelope(const std::string& message)
+	{
+		return nlohmann::json{ { "status", "error" }, { "message", message } }.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+	}
+}
+
+FlareSolverrProxy::FlareSolverrProxy(std::string upstream, ProxyCache& cache)
+	: upstream(std::move(upstream)), cache(cache)
+{
+}
+
+void FlareSolverrProxy::Handle(const HttpServerRequest& request, HttpResponseWriter& response)
+{
+	if (request.path == "/health") {
+		HandleHealth(response);
+		return;
+	}
+	if (request.path != "/v1" && request.path != "/v1/") {
+		response.Send(404, "text/plain", "Not found");
+		return;
+	}
+	if (request.method != "POST") {
+		response.Send(405, "text/plain", "Use POST");
+		return;
+	}
+
+	nlohmann::json command = nlohmann::json::parse(request.body, nullptr, false);
+	Reply reply;
+	// Only plain page loads are cacheable, sessions, POSTs and anything unparsable pass through
+	if (command.is_object() && command.value("cmd", "") == "request.get" && command.contains("url") && command["url"].is_string()) {
+		reply = Lookup(command["url"].get<std::string>(), command);
+	}
+	else {
+		reply = Forward(request.body, command.is_object() ? UpstreamTimeout(command) : defaultMaxTimeout + timeoutMargin);
+		reply.cacheStatus = "BYPASS";
+	}
+	SendReply(request, std::move(reply), response);
+}
+
+void FlareSolverrProxy::SendReply(const HttpServerRequest& request, Reply reply, HttpResponseWriter& response)
+{
+	auto accept = request.headers.find("accept-encoding");
+	ContentEncoding encoding = accept != request.headers.end() ? ChooseContentEncoding(accept->second) : ContentEncoding::Identity;
+	std::map<std::string, std::string> headers{ { "X-Cache", reply.cacheStatus }, { "Vary", "Accept-Encoding" } };
+
+	if (reply.cached && encoding == ContentEncoding::Gzip) {
+		headers["Content-Encoding"] = "gzip";
+		bytesSent += reply.cached->gzipped.size();
+		bytesSaved += reply.cached->plainSize - reply.cached->gzipped.size();
+		response.Send(reply.status, "application/json", reply.cached->gzipped, headers);
+		return;
+	}
+	if (reply.body.empty() && reply.cached && !DecodeContent(reply.cached->gzipped, ContentEncoding::Gzip, reply.body)) {
+		reply.status = 500;
+		reply.body = ErrorEnvelope("SmurfTracker proxy: cached reply is corrupt (" + reply.body + ")");
+	}
+	if (encoding != ContentEncoding::Identity && reply.body.size() >= minCompressBytes) {
+		std::string encoded = EncodeContent(reply.body, encoding);
+		headers["Content-Encoding"] = std::string(ContentEncodingName(encoding));
+		bytesSent += encoded.size();
+		bytesSaved += reply.body.size() - std::min(reply.body.size(), encoded.size());
+		response.Send(reply.status, "application/json", encoded, headers);
+		return;
+	}
+	bytesSent += reply.body.size();
+	response.Send(reply.status, "application/json", reply.body, headers);
+}
+
+void FlareSolverrProxy::HandleHealth(HttpResponseWriter& response)
+{
+	nlohmann::json health;
+	health["status"] = "ok";
+	health["upstream"] = upstream;
+	health["cachedUrls"] = cache.Size();
+	health["cacheBytes"] = cache.Bytes();
+	health["hits"] = hits.load();
+	health["misses"] = misses.load();
+	health["revalidated"] = revalidated.load();
+	health["staleServed"] = staleServed.load();
+	health["collapsed"] = collapsed.load();
+	health["bytesSent"] = bytesSent.load();
+	health["bytesSavedByCompression"] = bytesSaved.load();
+	response.Send(200, "application/json", health.dump());
+}
+
+FlareSolverrProxy::Reply FlareSolverrProxy::Forward(const std::string& body, std::chrono::milliseconds timeout)
+{
+	HttpCall call;
+	call.url = "http://" + upstream + "/v1";
+	call.verb = "POST";
+	call.headers["Content-Type"] = "application/json";
+	call.body = body;
+
+	Reply reply;
+	reply.status = client.Send(call, reply.body, timeout);
+	if (reply.status == 0) {
+		reply.status = 502;
+		reply.body = ErrorEnvelope("SmurfTracker proxy: " + reply.body);
+	}
+	return reply;
+}
+
+FlareSolverrProxy::Reply FlareSolverrProxy::Lookup(const std::string& url, const nlohmann::json& command)
+{
+	std::shared_ptr<const ProxyCache::Entry> entry = cache.Get(url);
+	if (entry && ProxyCache::Clock::now() < entry->freshUntil) {
+		hits++;
+		return FromCache(entry, "HIT");
+	}
+
+	std::shared_ptr<InFlight> flight;
+	bool leader = false;
+	{
+		std::lock_guard<std::mutex> lock(inFlightMutex);
+		std::shared_ptr<InFlight>& slot = inFlight[url];
+		if (!slot) {
+			slot = std::make_shared<InFlight>();
+			leader = true;
+		}
+		flight = slot;
+	}
+
+	if (!leader) {
+		collapsed++;
+		std::unique_lock<std::mutex> lock(flight->mutex);
+		flight->finished.wait(lock, [&flight] { return flight->done; });
+		return flight->reply;
+	}
+
+	Reply reply = Refresh(url, command, entry);
+	{
+		std::lock_guard<std::mutex> lock(inFlightMutex);
+		inFlight.erase(url);
+	}
+	{
+		std::lock_guard<std::mutex> lock(flight->mutex);
+		flight->reply = reply;
+		flight->done = true;
+	}
+	flight->finished.notify_all();
+	return reply;
+}
+
+FlareSolverrProxy::Reply FlareSolverrProxy::Refresh(const std::string& url, nlohmann::json command, const std::shared_ptr<const ProxyCache::Entry>& entry)
+{
+	// FlareSolverr builds that take request headers pass these on, the rest
+	// ignore them and answer in full, which is simply a refetch
+	bool conditional = entry && entry->HasValidator();
+	if (conditional) {
+		if (!entry->etag.empty()) {
+			command["headers"]["If-None-Match"] = entry->etag;
+		}
+		if (!entry->lastModified.empty()) {
+			command["headers"]["If-Modified-Since"] = entry->lastModified;
+		}
+	}
+
+	Reply reply = Forward(command.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace), UpstreamTimeout(command));
+	nlohmann::json parsed = reply.status == 200 ? nlohmann::json::parse(reply.body, nullptr, false) : nlohmann::json();
+	const nlohmann::json* solution = nullptr;
+	if (parsed.is_object() && parsed.value("status", "") == "ok") {
+		auto it = parsed.find("solution");
+		if (it != parsed.end() && it->is_object() && it->contains("status") && (*it)["status"].is_number_integer()) {
+			solution = &*it;
+		}
+	}
+
+	auto now = ProxyCache::Clock::now();
+	if (!solution) {
+		// Upstream or the challenge failed, an older answer beats none
+		if (entry && now < entry->storedAt + staleFor) {
+			staleServed++;
+			return FromCache(entry, "STALE");
+		}
+		reply.cacheStatus = "MISS";
+		return reply;
+	}
+
+	int originStatus = (*solution)["status"].get<int>();
+	if (originStatus == 304 && conditional) {
+		revalidated++;
+		cache.Renew(url, now + freshFor);
+		return FromCache(entry, "REVALIDATED");
+	}
+
+	misses++;
+	reply.cacheStatus = "MISS";
+	// Not-found pages are as stable as found ones, anything else is retried next time
+	if (originStatus == 200 || originStatus == 404) {
+		ProxyCache::Entry stored;
+		stored.gzipped = EncodeContent(reply.body, ContentEncoding::Gzip);
+		stored.plainSize = reply.body.size();
+		stored.etag = OriginHeader(*solution, "etag");
+		stored.lastModified = OriginHeader(*solution, "last-modified");
+		stored.storedAt = now;
+		stored.freshUntil = now + freshFor;
+		reply.cached = cache.Put(url, std::move(stored));
+	}
+	return reply;
+}
+
+FlareSolverrProxy::Reply FlareSolverrProxy::FromCache(const std::shared_ptr<const ProxyCache::Entry>& entry, const char* cacheStatus)
+{
+	// Decoded in SendReply only for a client that cannot take it gzipped
+	Reply reply;
+	reply.status = 200;
+	reply.cached = entry;
+	reply.cacheStatus = cacheStatus;
+	return reply;
+}
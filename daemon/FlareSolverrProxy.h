@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "HttpClient.h"
+#include "HttpServer.h"
+#include "json.hpp"
+#include "ProxyCache.h"
+
+// Caching proxy that speaks FlareSolverr's own protocol, so anything pointed
+// at a FlareSolverr endpoint (SmurfTracker_ip) can use it unchanged:
+//   POST /v1     request.get replies come from the cache by target URL, every
+//                other command goes straight through
+//   GET /health  cache size and hit counts
+// Fresh entries are answered without asking upstream. Stale ones with an ETag
+// or Last-Modified from the origin are revalidated, the rest fetched again,
+// and an entry still within staleFor is served when upstream fails. Identical
+// URLs requested while one is already on its way share that one call.
+// Replies are gzipped or deflated when the client's Accept-Encoding allows,
+// cached ones go out as stored.
+class FlareSolverrProxy
+{
+public:
+	FlareSolverrProxy(std::string upstream, ProxyCache& cache);
+
+	void Handle(const HttpServerRequest& request, HttpResponseWriter& response);
+
+	std::chrono::seconds freshFor{ 600 };
+	std::chrono::seconds staleFor{ 86400 };
+
+private:
+	struct Reply {
+		int status = 502;
+		std::string body; // empty when only the cached copy has it
+		std::shared_ptr<const ProxyCache::Entry> cached;
+		std::string cacheStatus; // X-Cache: HIT, MISS, REVALIDATED, STALE or BYPASS
+	};
+
+	// One upstream call for a URL, joined by every identical request meanwhile
+	struct InFlight {
+		std::mutex mutex;
+		std::condition_variable finished;
+		bool done = false;
+		Reply reply;
+	};
+
+	void HandleHealth(HttpResponseWriter& response);
+	void SendReply(const HttpServerRequest& request, Reply reply, HttpResponseWriter& response);
+	Reply Forward(const std::string& body, std::chrono::milliseconds timeout);
+	Reply Lookup(const std::string& url, const nlohmann::json& command);
+	Reply Refresh(const std::string& url, nlohmann::json command, const std::shared_ptr<const ProxyCache::Entry>& entry);
+	Reply FromCache(const std::shared_ptr<const ProxyCache::Entry>& entry, const char* cacheStatus);
+
+	std::string upstream;
+	ProxyCache& cache;
+	HttpClient client;
+	std::mutex inFlightMutex;
+	std::map<std::string, std::shared_ptr<InFlight>> inFlight;
+
+	std::atomic<uint64_t> hits = 0;
+	std::atomic<uint64_t> misses = 0;
+	std::atomic<uint64_t> revalidated = 0;
+	std::atomic<uint64_t> staleServed = 0;
+	std::atomic<uint64_t> collapsed = 0;
+	std::atomic<uint64_t> bytesSent = 0;
+	std::atomic<uint64_t> bytesSaved = 0; // by compression, against sending every body plain
+};
@@ -0,0 +1,246 @@
+#include "HttpClient.h"
+
+#include <cstdlib>
+
+#include "ContentEncoding.h"
+#include "HttpMessage.h"
+#include "SocketCompat.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <winhttp.h>
+#pragma comment(lib, "Winhttp.lib")
+
+namespace {
+	std::wstring Widen(const std::string& text)
+	{
+		if (text.empty()) {
+			return std::wstring();
+		}
+		int length = MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), nullptr, 0);
+		std::wstring wide(length, L'\0');
+		MultiByteToWideChar(CP_UTF8, 0, text.data(), static_cast<int>(text.size()), wide.data(), length);
+		return wide;
+	}
+
+	// Closes a WinHTTP handle on scope exit
+	struct InternetHandle {
+		HINTERNET handle = nullptr;
+		~InternetHandle() { if (handle) WinHttpCloseHandle(handle); }
+	};
+}
+
+HttpClient::HttpClient()
+{
+	session = WinHttpOpen(L"SmurfTrackerDaemon/1.0", WINHTTP_ACCESS_TYPE_AUTOMATIC_PROXY,
+		WINHTTP_NO_PROXY_NAME, WINHTTP_NO_PROXY_BYPASS, 0);
+}
+
+HttpClient::~HttpClient()
+{
+	if (session) {
+		WinHttpCloseHandle(session);
+	}
+}
+
+int HttpClient::Send(const HttpCall& call, std::string& body, std::chrono::milliseconds timeout)
+{
+	body.clear();
+	if (!session) {
+		body = "WinHTTP is not available";
+		return 0;
+	}
+
+	std::wstring url = Widen(call.url);
+	URL_COMPONENTS parts{};
+	parts.dwStructSize = sizeof(parts);
+	parts.dwHostNameLength = static_cast<DWORD>(-1);
+	parts.dwUrlPathLength = static_cast<DWORD>(-1);
+	parts.dwExtraInfoLength = static_cast<DWORD>(-1);
+	if (!WinHttpCrackUrl(url.c_str(), 0, 0, &parts)) {
+		body = "Invalid URL: " + call.url;
+		return 0;
+	}
+	std::wstring host(parts.lpszHostName, parts.dwHostNameLength);
+	std::wstring path(parts.lpszUrlPath, parts.dwUrlPathLength + parts.dwExtraInfoLength);
+	if (path.empty()) {
+		path = L"/";
+	}
+
+	InternetHandle connection{ WinHttpConnect(session, host.c_str(), parts.nPort, 0) };
+	if (!connection.handle) {
+		body = "Cannot connect to " + call.url;
+		return 0;
+	}
+	DWORD flags = parts.nScheme == INTERNET_SCHEME_HTTPS ? WINHTTP_FLAG_SECURE : 0;
+	InternetHandle request{ WinHttpOpenRequest(connection.handle, Widen(call.verb).c_str(), path.c_str(),
+		nullptr, WINHTTP_NO_REFERER, WINHTTP_DEFAULT_ACCEPT_TYPES, flags) };
+	if (!request.handle) {
+		body = "Cannot open request to " + call.url;
+		return 0;
+	}
+	int timeoutMs = static_cast<int>(timeout.count());
+	WinHttpSetTimeouts(request.handle, timeoutMs, timeoutMs, timeoutMs, timeoutMs);
+#ifdef WINHTTP_OPTION_DECOMPRESSION
+	// Windows 8.1 and later send Accept-Encoding and inflate while reading, older ones just get plain bodies
+	DWORD decompression = WINHTTP_DECOMPRESSION_FLAG_ALL;
+	WinHttpSetOption(request.handle, WINHTTP_OPTION_DECOMPRESSION, &decompression, sizeof(decompression));
+#endif
+
+	std::wstring headers;
+	for (const auto& [name, value] : call.headers) {
+		headers += Widen(name + ": " + value + "\r\n");
+	}
+	BOOL sent = WinHttpSendRequest(request.handle,
+		headers.empty() ? WINHTTP_NO_ADDITIONAL_HEADERS : headers.c_str(), static_cast<DWORD>(headers.size()),
+		call.body.empty() ? WINHTTP_NO_REQUEST_DATA : const_cast<char*>(call.body.data()),
+		static_cast<DWORD>(call.body.size()), static_cast<DWORD>(call.body.size()), 0);
+	if (!sent || !WinHttpReceiveResponse(request.handle, nullptr)) {
+		body = "Request to " + call.url + " failed with error " + std::to_string(GetLastError());
+		return 0;
+	}
+
+	DWORD status = 0;
+	DWORD statusSize = sizeof(status);
+	WinHttpQueryHeaders(request.handle, WINHTTP_QUERY_STATUS_CODE | WINHTTP_QUERY_FLAG_NUMBER,
+		WINHTTP_HEADER_NAME_BY_INDEX, &status, &statusSize, WINHTTP_NO_HEADER_INDEX);
+
+	DWORD available = 0;
+	while (WinHttpQueryDataAvailable(request.handle, &available) && available > 0) {
+		size_t offset = body.size();
+		body.resize(offset + available);
+		DWORD read = 0;
+		if (!WinHttpReadData(request.handle, body.data() + offset, available, &read)) {
+			body.resize(offset);
+			break;
+		}
+		body.resize(offset + read);
+	}
+	return static_cast<int>(status);
+}
+#else
+HttpClient::HttpClient()
+{
+}
+
+HttpClient::~HttpClient()
+{
+}
+
+int HttpClient::Send(const HttpCall& call, std::string& body, std::chrono::milliseconds timeout)
+{
+	body.clear();
+	constexpr std::string_view scheme = "http://";
+	if (call.url.compare(0, scheme.size(), scheme) != 0) {
+		body = "Only http:// URLs are supported outside Windows: " + call.url;
+		return 0;
+	}
+
+	size_t hostStart = scheme.size();
+	size_t pathStart = call.url.find('/', hostStart);
+	std::string authority = call.url.substr(hostStart, pathStart - hostStart);
+	std::string path = pathStart != std::string::npos ? call.url.substr(pathStart) : "/";
+
+	std::string host;
+	std::string port;
+	SplitHostPort(authority, "80", host, port);
+	std::string error;
+	SocketHandle connection = ConnectTcp(host, port, error);
+	if (connection == invalidSocket) {
+		body = error;
+		return 0;
+	}
+	SetReceiveTimeout(connection, static_cast<int>(timeout.count()));
+
+	std::string head = call.verb + " " + path + " HTTP/1.1\r\nHost: " + authority + "\r\nConnection: close\r\n";
+	if (!call.headers.count("Accept-Encoding")) {
+		head += "Accept-Encoding: " + std::string(acceptEncodingHeader) + "\r\n";
+	}
+	for (const auto& [name, value] : call.headers) {
+		head += name + ": " + value + "\r\n";
+	}
+	if (!call.body.empty() || call.verb == "POST") {
+		head += "Content-Length: " + std::to_string(call.body.size()) + "\r\n";
+	}
+	head += "\r\n";
+
+	int status = 0;
+	if (SendAll(connection, head) && SendAll(connection, call.body)) {
+		std::string buffer;
+		HttpMessage response;
+		if (ReadHttpHead(connection, buffer, response) == ReadStatus::Ok) {
+			// "HTTP/1.1 200 OK"
+			size_t codeStart = response.startLine.find(' ');
+			if (codeStart != std::string::npos) {
+				status = std::atoi(response.startLine.c_str() + codeStart + 1);
+			}
+			if (!ReadBody(connection, buffer, response, body)) {
+				status = 0;
+				body = "Bad response from " + authority + ": " + body;
+			}
+		}
+		else {
+			body = "Invalid or no response from " + authority;
+		}
+	}
+	else {
+		body = "Cannot send request to " + authority;
+	}
+	CloseSocket(connection);
+	return status;
+}
+
+bool HttpClient::ReadBody(SocketHandle connection, std::string& buffer, const HttpMessage& response, std::string& body)
+{
+	// Compressed bodies are inflated piece by piece as they come off the socket
+	ContentEncoding encoding = ParseContentEncoding(response.Header("content-encoding"));
+	ContentDecoder decoder(encoding);
+	decoder.maxOutputBytes = maxBodyBytes;
+	auto fail = [&body](std::string reason) {
+		body = std::move(reason);
+		return false;
+	};
+	auto feed = [&](std::string_view data) {
+		if (encoding == ContentEncoding::Identity && body.size() + data.size() > maxBodyBytes) {
+			return fail("body is larger than " + std::to_string(maxBodyBytes) + " bytes");
+		}
+		return decoder.Feed(data, body) != ContentDecoder::Status::Error || fail(decoder.ErrorText());
+	};
+	auto finish = [&] {
+		return encoding == ContentEncoding::Identity || decoder.State() == ContentDecoder::Status::Done || fail("compressed body is cut off");
+	};
+
+	std::string data;
+	if (IsChunked(response)) {
+		for (;;) {
+			if (ReadHttpChunk(connection, buffer, data, maxBodyBytes) != ReadStatus::Ok) {
+				return fail("body is cut off");
+			}
+			if (data.empty()) {
+				return finish();
+			}
+			if (!feed(data)) {
+				return false;
+			}
+		}
+	}
+
+	std::string lengthHeader = response.Header("content-length");
+	bool sized = !lengthHeader.empty();
+	size_t remaining = sized ? std::strtoull(lengthHeader.c_str(), nullptr, 10) : 0;
+	while (!sized || remaining > 0) {
+		if (ReadHttpSome(connection, buffer, data) != ReadStatus::Ok) {
+			// The end of an unframed body, or a sized one cut short
+			return sized ? fail("body is cut off") : finish();
+		}
+		if (sized && data.size() > remaining) {
+			data.resize(remaining);
+		}
+		remaining -= sized ? data.size() : 0;
+		if (!feed(data)) {
+			return false;
+		}
+	}
+	return finish();
+}
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "StatsProvider.h"
+
+#ifndef _WIN32
+#include "HttpMessage.h"
+#endif
+
+// Blocking HTTP client for the daemon's provider calls. WinHTTP on Windows
+// (http and https, system proxy settings); elsewhere plain http over a socket,
+// which is all a FlareSolverr endpoint needs. Either way gzip and deflate
+// replies are asked for and handed back decoded.
+class HttpClient
+{
+public:
+	HttpClient();
+	~HttpClient();
+
+	HttpClient(const HttpClient&) = delete;
+	HttpClient& operator=(const HttpClient&) = delete;
+
+	// Returns the status code, 0 when the server could not be reached (body then holds the reason)
+	int Send(const HttpCall& call, std::string& body, std::chrono::milliseconds timeout);
+
+private:
+#ifdef _WIN32
+	void* session = nullptr; // HINTERNET
+#else
+	// False when the body is cut off or does not decode
+	bool ReadBody(SocketHandle connection, std::string& buffer, const HttpMessage& response, std::string& body);
+#endif
+
+	static constexpr size_t maxBodyBytes = 64 * 1024 * 1024;
+};
@@ -0,0 +1,187 @@
+#include "HttpServer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+#include "HttpMessage.h"
+
+bool HttpResponseWriter::Send(int status, std::string_view contentType, std::string_view body,
+	const std::map<std::string, std::string>& extraHeaders)
+{
+	sent = true;
+	std::string head = "HTTP/1.1 " + std::to_string(status) + " " + StatusText(status) + "\r\n"
+		"Content-Type: " + std::string(contentType) + "\r\n";
+	for (const auto& [name, value] : extraHeaders) {
+		head += name + ": " + value + "\r\n";
+	}
+	head += "Content-Length: " + std::to_string(body.size()) + "\r\n"
+		"Connection: " + (keepAlive ? "keep-alive" : "close") + "\r\n\r\n";
+	return SendAll(socket, head) && SendAll(socket, body);
+}
+
+bool HttpResponseWriter::BeginStream(int status, std::string_view contentType)
+{
+	sent = true;
+	std::string head = "HTTP/1.1 " + std::to_string(status) + " " + StatusText(status) + "\r\n"
+		"Content-Type: " + std::string(contentType) + "\r\n"
+		"Cache-Control: no-cache\r\n"
+		"Transfer-Encoding: chunked\r\n"
+		"Connection: " + (keepAlive ? "keep-alive" : "close") + "\r\n\r\n";
+	return SendAll(socket, head);
+}
+
+bool HttpResponseWriter::WriteChunk(std::string_view data)
+{
+	if (data.empty()) {
+		return true; // an empty chunk would end the body
+	}
+	return SendAll(socket, EncodeHttpChunk(data));
+}
+
+bool HttpResponseWriter::EndStream()
+{
+	return SendAll(socket, EncodeHttpChunk({}));
+}
+
+HttpServer::HttpServer(HttpHandler handler) : handler(std::move(handler))
+{
+}
+
+HttpServer::~HttpServer()
+{
+	Stop();
+}
+
+bool HttpServer::Listen(const std::string& bindAddress, uint16_t port, std::string& error)
+{
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	hints.ai_flags = AI_PASSIVE;
+	addrinfo* addresses = nullptr;
+	if (getaddrinfo(bindAddress.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0 || addresses == nullptr) {
+		error = "Cannot resolve bind address " + bindAddress;
+		return false;
+	}
+
+	listener = socket(addresses->ai_family, addresses->ai_socktype, addresses->ai_protocol);
+	if (listener == invalidSocket) {
+		freeaddrinfo(addresses);
+		error = "Cannot create socket";
+		return false;
+	}
+	int reuse = 1;
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+	bool bound = bind(listener, addresses->ai_addr, static_cast<int>(addresses->ai_addrlen)) == 0 && listen(listener, SOMAXCONN) == 0;
+	freeaddrinfo(addresses);
+	if (!bound) {
+		CloseSocket(listener);
+		listener = invalidSocket;
+		error = "Cannot listen on " + bindAddress + ":" + std::to_string(port);
+		return false;
+	}
+
+	acceptThread = std::thread([this] { AcceptLoop(); });
+	return true;
+}
+
+void HttpServer::Stop()
+{
+	if (stopping.exchange(true)) {
+		return;
+	}
+	if (listener != invalidSocket) {
+		// Unblocks accept, closing alone does not on every platform
+		ShutdownSocket(listener);
+		CloseSocket(listener);
+	}
+	if (acceptThread.joinable()) {
+		acceptThread.join();
+	}
+
+	std::unique_lock<std::mutex> lock(connectionsMutex);
+	for (SocketHandle connection : connections) {
+		ShutdownSocket(connection);
+	}
+	connectionsClosed.wait(lock, [this] { return connections.empty(); });
+}
+
+void HttpServer::AcceptLoop()
+{
+	// Out of descriptors (EMFILE) or memory accept fails at once until connections close
+	std::chrono::milliseconds backoff(0);
+	while (!stopping) {
+		SocketHandle connection = accept(listener, nullptr, nullptr);
+		if (connection == invalidSocket) {
+			if (stopping || AcceptAborted()) {
+				continue; // stopping, or a client that went away during the handshake
+			}
+			backoff = std::clamp(backoff * 2, std::chrono::milliseconds(10), std::chrono::milliseconds(500));
+			std::this_thread::sleep_for(backoff);
+			continue;
+		}
+		backoff = std::chrono::milliseconds(0);
+
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		if (stopping) {
+			CloseSocket(connection);
+			break;
+		}
+		connections.insert(connection);
+		std::thread([this, connection] { Serve(connection); }).detach();
+	}
+}
+
+void HttpServer::Serve(SocketHandle connection)
+{
+	SetReceiveTimeout(connection, idleTimeoutMs);
+	int noDelay = 1;
+	setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+	std::string buffer;
+	bool keepAlive = true;
+	while (keepAlive && !stopping) {
+		HttpMessage message;
+		ReadStatus status = ReadHttpMessage(connection, buffer, message, maxRequestBytes, false);
+		if (status == ReadStatus::TooLarge) {
+			HttpResponseWriter(connection, false).Send(413, "text/plain", "Request too large");
+			break;
+		}
+		if (status != ReadStatus::Ok) {
+			break;
+		}
+
+		HttpServerRequest request;
+		size_t methodEnd = message.startLine.find(' ');
+		size_t targetEnd = message.startLine.find(' ', methodEnd + 1);
+		if (methodEnd == std::string::npos || targetEnd == std::string::npos) {
+			HttpResponseWriter(connection, false).Send(400, "text/plain", "Malformed request line");
+			break;
+		}
+		request.method = message.startLine.substr(0, methodEnd);
+		std::string target = message.startLine.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+		size_t queryStart = target.find('?');
+		request.path = target.substr(0, queryStart);
+		request.query = queryStart != std::string::npos ? target.substr(queryStart + 1) : "";
+		request.headers = std::move(message.headers);
+		request.body = std::move(message.body);
+
+		std::string connectionHeader = request.headers["connection"];
+		std::transform(connectionHeader.begin(), connectionHeader.end(), connectionHeader.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		bool http10 = message.startLine.compare(targetEnd + 1, std::string::npos, "HTTP/1.0") == 0;
+		keepAlive = http10 ? connectionHeader == "keep-alive" : connectionHeader != "close";
+
+		HttpResponseWriter writer(connection, keepAlive);
+		handler(request, writer);
+		if (!writer.Sent()) {
+			writer.Send(500, "text/plain", "No response");
+		}
+		keepAlive = writer.KeepAlive();
+	}
+
+	CloseSocket(connection);
+	std::lock_guard<std::mutex> lock(connectionsMutex);
+	connections.erase(connection);
+	connectionsClosed.notify_all();
+}
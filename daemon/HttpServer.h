@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "SocketCompat.h"
+
+struct HttpServerRequest {
+	std::string method;
+	std::string path; // without the query string
+	std::string query;
+	std::map<std::string, std::string> headers; // names lower-cased
+	std::string body;
+};
+
+// Answers one request, either with Send or with a chunked stream
+// (BeginStream, any number of WriteChunk, EndStream). Each returns false once
+// the client has gone away.
+class HttpResponseWriter
+{
+public:
+	HttpResponseWriter(SocketHandle socket, bool keepAlive) : socket(socket), keepAlive(keepAlive) {}
+
+	// extraHeaders are sent as given, after Content-Type
+	bool Send(int status, std::string_view contentType, std::string_view body,
+		const std::map<std::string, std::string>& extraHeaders = {});
+
+	bool BeginStream(int status, std::string_view contentType);
+	bool WriteChunk(std::string_view data);
+	bool EndStream();
+
+	bool Sent() const { return sent; }
+	bool KeepAlive() const { return keepAlive; }
+
+private:
+	SocketHandle socket;
+	bool keepAlive;
+	bool sent = false;
+};
+
+// Runs on the connection's own thread and may block
+using HttpHandler = std::function<void(const HttpServerRequest&, HttpResponseWriter&)>;
+
+// Minimal HTTP/1.1 server for a handful of local clients: one thread per
+// connection, keep-alive, Content-Length and chunked request bodies.
+class HttpServer
+{
+public:
+	explicit HttpServer(HttpHandler handler);
+	~HttpServer();
+
+	// bindAddress is an IPv4 or IPv6 literal or host name, "0.0.0.0" or "::" for the LAN
+	bool Listen(const std::string& bindAddress, uint16_t port, std::string& error);
+
+	// Closes the listener and every open connection, waits for their threads
+	void Stop();
+
+	static constexpr size_t maxRequestBytes = 1024 * 1024;
+	static constexpr int idleTimeoutMs = 30000;
+
+private:
+	void AcceptLoop();
+	void Serve(SocketHandle connection);
+
+	HttpHandler handler;
+	SocketHandle listener = invalidSocket;
+	std::atomic<bool> stopping = false;
+	std::thread acceptThread;
+	std::mutex connectionsMutex;
+	std::condition_variable connectionsClosed;
+	std::set<SocketHandle> connections;
+};
@@ -0,0 +1,184 @@
+#include "LobbyService.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+#include "ContentEncoding.h"
+#include "json.hpp"
+#include "LobbyProtocol.h"
+
+LobbyService::LobbyService(LookupPipeline& pipeline, StatsCache& cache)
+	: pipeline(pipeline), cache(cache)
+{
+}
+
+void LobbyService::Handle(const HttpServerRequest& request, HttpResponseWriter& response)
+{
+	if (request.path == "/lobby") {
+		if (request.method != "POST") {
+			response.Send(405, "text/plain", "Use POST");
+			return;
+		}
+		HandleLobby(request, response);
+	}
+	else if (request.path == "/health") {
+		HandleHealth(response);
+	}
+	else {
+		response.Send(404, "text/plain", "Not found");
+	}
+}
+
+void LobbyService::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(resultsMutex);
+		stopping = true;
+	}
+	resultArrived.notify_all();
+}
+
+void LobbyService::HandleLobby(const HttpServerRequest& request, HttpResponseWriter& response)
+{
+	auto header = [&request](const char* name) {
+		auto it = request.headers.find(name);
+		return it != request.headers.end() ? it->second : std::string();
+		};
+	WireFormat requestFormat = header("content-type").find(msgpackContentType) != std::string::npos ? WireFormat::Msgpack : WireFormat::Json;
+
+	LobbyRequest lobby;
+	std::string error;
+	if (!DecodeLobbyRequest(request.body, lobby, error, requestFormat)) {
+		response.Send(400, "text/plain", error);
+		return;
+	}
+	if (lobby.players.size() > maxPlayers) {
+		response.Send(400, "text/plain", "At most " + std::to_string(maxPlayers) + " players per lobby");
+		return;
+	}
+	lobbiesServed++;
+
+	std::chrono::milliseconds timeout = lobby.timeout.count() > 0 ? std::min(lobby.timeout, maxTimeout) : defaultTimeout;
+	auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	// Results land by index, the client's tags are put back when answering
+	auto state = std::make_shared<LobbyState>();
+	state->results.resize(lobby.players.size());
+	state->remaining = lobby.players.size();
+	std::vector<ProviderRequest> requests = lobby.players;
+	for (size_t i = 0; i < requests.size(); i++) {
+		requests[i].tag = i;
+		requests[i].deadline = deadline;
+	}
+
+	// No cancel token: once the client has its answer, lookups still queued are
+	// worth finishing for the next lobby, or expire at the deadline
+	pipeline.LookupLobby(requests, [this, state](const LookupResult& result) {
+		{
+			std::lock_guard<std::mutex> lock(resultsMutex);
+			std::optional<LookupResult>& slot = state->results[result.tag];
+			if (!slot) {
+				state->remaining--;
+			}
+			// A revalidated value replaces the stale one if it is in before the answer goes out
+			slot = result;
+			state->arrived.push_back(result.tag);
+		}
+		resultArrived.notify_all();
+		});
+
+	// Restores the client's name and tag, players without a result get a timeout
+	auto forClient = [&](size_t index) {
+		LookupResult result;
+		if (state->results[index]) {
+			result = *state->results[index];
+		}
+		else {
+			result.wins = "Timeout";
+			result.error = "Lookup did not finish within " + std::to_string(timeout.count()) + " ms";
+		}
+		result.playerName = lobby.players[index].playerName;
+		result.tag = lobby.players[index].tag;
+		return result;
+		};
+
+	// The compact formats only when asked for, everyone else gets JSON
+	std::string accept = header("accept");
+	if (accept.find(msgpackStreamContentType) != std::string::npos) {
+		StreamLobby(*state, deadline, forClient, WireFormat::Msgpack, response);
+		return;
+	}
+	if (accept.find(eventStreamContentType) != std::string::npos) {
+		StreamLobby(*state, deadline, forClient, WireFormat::Json, response);
+		return;
+	}
+	WireFormat answerFormat = accept.find(msgpackContentType) != std::string::npos ? WireFormat::Msgpack : WireFormat::Json;
+
+	std::vector<LookupResult> answer;
+	{
+		std::unique_lock<std::mutex> lock(resultsMutex);
+		resultArrived.wait_until(lock, deadline, [&] { return state->remaining == 0 || stopping; });
+		for (size_t i = 0; i < state->results.size(); i++) {
+			answer.push_back(forClient(i));
+		}
+	}
+	std::string body = EncodeLobbyResults(answer, answerFormat);
+	// Streams stay plain, their frames are too small to gain anything one at a time
+	ContentEncoding encoding = ChooseContentEncoding(header("accept-encoding"));
+	std::map<std::string, std::string> extraHeaders;
+	if (encoding != ContentEncoding::Identity && body.size() >= minCompressBytes) {
+		body = EncodeContent(body, encoding);
+		extraHeaders["Content-Encoding"] = std::string(ContentEncodingName(encoding));
+	}
+	response.Send(200, answerFormat == WireFormat::Msgpack ? msgpackContentType : jsonContentType, body, extraHeaders);
+}
+
+void LobbyService::StreamLobby(LobbyState& state, std::chrono::steady_clock::time_point deadline,
+	const std::function<LookupResult(size_t)>& forClient, WireFormat format, HttpResponseWriter& response)
+{
+	if (!response.BeginStream(200, format == WireFormat::Msgpack ? msgpackStreamContentType : eventStreamContentType)) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(resultsMutex);
+	while (true) {
+		resultArrived.wait_until(lock, deadline, [&] { return !state.arrived.empty() || state.remaining == 0 || stopping; });
+		bool finished = state.remaining == 0 || stopping || std::chrono::steady_clock::now() >= deadline;
+
+		std::string events;
+		for (size_t index : state.arrived) {
+			events += EncodeLobbyEvent(forClient(index), format);
+		}
+		state.arrived.clear();
+		if (finished) {
+			for (size_t i = 0; i < state.results.size(); i++) {
+				if (!state.results[i]) {
+					events += EncodeLobbyEvent(forClient(i), format);
+				}
+			}
+			events += EncodeLobbyDone(format);
+		}
+
+		// Write without holding up other lobbies' results
+		lock.unlock();
+		if (!response.WriteChunk(events)) {
+			return; // client went away, its lookups still finish into the cache
+		}
+		if (finished) {
+			response.EndStream();
+			return;
+		}
+		lock.lock();
+	}
+}
+
+void LobbyService::HandleHealth(HttpResponseWriter& response)
+{
+	nlohmann::json data;
+	data["status"] = "ok";
+	data["cachedPlayers"] = cache.Size();
+	data["pendingLookups"] = pipeline.Pending();
+	data["lobbiesServed"] = lobbiesServed.load();
+	response.Send(200, "application/json", data.dump());
+}
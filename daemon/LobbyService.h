@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "HttpServer.h"
+#include "LobbyProtocol.h"
+#include "LookupPipeline.h"
+#include "StatsCache.h"
+
+// The daemon's endpoints on top of one shared LookupPipeline:
+//   POST /lobby  every player of a match in, every result out (see LobbyProtocol.h),
+//                with Accept: text/event-stream each result as soon as it resolves,
+//                MessagePack when asked for (see LobbyProtocol.h)
+//   GET /health  liveness plus cache and queue sizes
+// Requests from any number of clients share the pipeline's cache, in-flight
+// dedupe and pacing, so they also share one rate budget towards the providers.
+class LobbyService
+{
+public:
+	LobbyService(LookupPipeline& pipeline, StatsCache& cache);
+
+	void Handle(const HttpServerRequest& request, HttpResponseWriter& response);
+
+	// Wakes lobbies still waiting, they answer with what they have. The pipeline
+	// must be cancelled before the service goes away.
+	void Stop();
+
+	std::chrono::milliseconds defaultTimeout{ 60000 };
+	std::chrono::milliseconds maxTimeout{ 120000 };
+	static constexpr size_t maxPlayers = 16;
+	// Batch answers this size and up are compressed when the client accepts it
+	static constexpr size_t minCompressBytes = 1024;
+
+private:
+	struct LobbyState {
+		std::vector<std::optional<LookupResult>> results; // by player index
+		std::deque<size_t> arrived; // indices with a result not yet streamed
+		size_t remaining = 0;       // players without any result yet
+	};
+
+	void HandleLobby(const HttpServerRequest& request, HttpResponseWriter& response);
+	void StreamLobby(LobbyState& state, std::chrono::steady_clock::time_point deadline,
+		const std::function<LookupResult(size_t)>& forClient, WireFormat format, HttpResponseWriter& response);
+	void HandleHealth(HttpResponseWriter& response);
+
+	LookupPipeline& pipeline;
+	StatsCache& cache;
+	std::mutex resultsMutex; // guards every waiting lobby's LobbyState
+	std::condition_variable resultArrived;
+	bool stopping = false;
+	std::atomic<uint64_t> lobbiesServed = 0;
+};
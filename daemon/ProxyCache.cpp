@@ -0,0 +1,75 @@
+#include "ProxyCache.h"
+
+namespace {
+	size_t EntryBytes(const std::string& url, const ProxyCache::Entry& entry)
+	{
+		return url.size() + entry.gzipped.size() + entry.etag.size() + entry.lastModified.size();
+	}
+}
+
+std::shared_ptr<const ProxyCache::Entry> ProxyCache::Get(const std::string& url)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = entries.find(url);
+	if (it == entries.end()) {
+		return nullptr;
+	}
+	uses.splice(uses.begin(), uses, it->second.use);
+	return it->second.entry;
+}
+
+std::shared_ptr<const ProxyCache::Entry> ProxyCache::Put(const std::string& url, Entry entry)
+{
+	auto stored = std::make_shared<const Entry>(std::move(entry));
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = entries.find(url);
+	if (it != entries.end()) {
+		bytes -= EntryBytes(url, *it->second.entry);
+		uses.splice(uses.begin(), uses, it->second.use);
+		it->second.entry = stored;
+	}
+	else {
+		uses.push_front(url);
+		entries.emplace(url, Slot{ stored, uses.begin() });
+	}
+	bytes += EntryBytes(url, *stored);
+	EvictLocked();
+	return stored;
+}
+
+void ProxyCache::Renew(const std::string& url, Clock::time_point freshUntil)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	auto it = entries.find(url);
+	if (it == entries.end()) {
+		return;
+	}
+	// Copy rather than mutate, a reader may still hold the old one
+	Entry renewed = *it->second.entry;
+	renewed.storedAt = Clock::now();
+	renewed.freshUntil = freshUntil;
+	it->second.entry = std::make_shared<const Entry>(std::move(renewed));
+}
+
+size_t ProxyCache::Size()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return entries.size();
+}
+
+size_t ProxyCache::Bytes()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return bytes;
+}
+
+void ProxyCache::EvictLocked()
+{
+	// Always keep the newest entry, even if it alone is over the limit
+	while (bytes > maxBytes && uses.size() > 1) {
+		auto it = entries.find(uses.back());
+		bytes -= EntryBytes(it->first, *it->second.entry);
+		entries.erase(it);
+		uses.pop_back();
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Upstream replies by target URL for the caching proxy. Bodies are kept
+// gzipped, ready to go out as they are to clients that accept gzip, and the
+// least recently used entries go once the total passes maxBytes. Entries are
+// immutable once stored, readers keep theirs alive through the shared_ptr
+// while a newer one replaces it.
+class ProxyCache
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry {
+		std::string gzipped;
+		size_t plainSize = 0;
+		std::string etag;         // validators from the origin's reply, empty when it sent none
+		std::string lastModified;
+		Clock::time_point storedAt;
+		Clock::time_point freshUntil; // served without asking upstream until then
+
+		bool HasValidator() const { return !etag.empty() || !lastModified.empty(); }
+	};
+
+	explicit ProxyCache(size_t maxBytes) : maxBytes(maxBytes) {}
+
+	// nullptr when absent, counts as a use for eviction
+	std::shared_ptr<const Entry> Get(const std::string& url);
+	// Returns the entry as stored
+	std::shared_ptr<const Entry> Put(const std::string& url, Entry entry);
+	// The origin confirmed the entry is unchanged (304)
+	void Renew(const std::string& url, Clock::time_point freshUntil);
+
+	size_t Size();
+	size_t Bytes();
+
+private:
+	struct Slot {
+		std::shared_ptr<const Entry> entry;
+		std::list<std::string>::iterator use;
+	};
+
+	void EvictLocked();
+
+	size_t maxBytes;
+	std::mutex mutex;
+	std::unordered_map<std::string, Slot> entries;
+	std::list<std::string> uses; // most recent first
+	size_t bytes = 0;
+};
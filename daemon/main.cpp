@@ -0,0 +1,357 @@
+// SmurfTracker lookup daemon: one shared cache, queue and rate budget for every
+// game client on the machine or LAN. The plugin sends each match's players to
+// POST /lobby instead of looking them up one by one (SmurfTracker_daemon).
+// "SmurfTrackerDaemon proxy" runs the caching FlareSolverr proxy instead.
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DaemonHost.h"
+#include "FlareSolverrProxy.h"
+#include "HttpServer.h"
+#include "LobbyService.h"
+#include "LookupPipeline.h"
+#include "ProxyCache.h"
+#include "Providers.h"
+#include "SocketCompat.h"
+#include "StatsCache.h"
+
+namespace {
+	std::atomic<bool> stopRequested = false;
+
+	void OnSignal(int)
+	{
+		stopRequested = true;
+	}
+
+	struct DaemonOptions {
+		std::string bindAddress = "127.0.0.1";
+		uint16_t port = 8192;
+		std::string providers = "flaresolverr";
+		std::string flaresolverr = "127.0.0.1:8191";
+		size_t sessions = 2;
+		size_t perEndpoint = 2;
+		size_t concurrency = 0; // every FlareSolverr instance at its limit
+		float spacingSeconds = 0.5f;
+		bool hedging = true;
+		std::string trackerUrl;
+		std::string trackerWinsPointer = "/wins";
+		std::string localStatsFile;
+		std::string cacheFile = "SmurfTrackerDaemon_cache.json";
+		int softTtlMinutes = 30;
+		int hardTtlMinutes = 10080;
+		int negativeTtlMinutes = 10;
+	};
+
+	void PrintUsage()
+	{
+		std::cout <<
+			"Usage: SmurfTrackerDaemon [options]\n"
+			"  --bind <address>          listen address, 0.0.0.0 or :: to serve the LAN (127.0.0.1)\n"
+			"  --port <port>             listen port (8192)\n"
+			"  --providers <list>        comma separated, primary first (flaresolverr)\n"
+			"  --flaresolverr <list>     comma separated FlareSolverr host:port, balanced (127.0.0.1:8191)\n"
+			"  --sessions <n>            browser sessions kept warm per FlareSolverr instance (2)\n"
+			"  --per-endpoint <n>        requests at once per FlareSolverr instance (2)\n"
+			"  --concurrency <n>         lookups in flight at once (instances x --per-endpoint)\n"
+			"  --spacing <seconds>       pause after each lookup (0.5)\n"
+			"  --no-hedging              never ask a second provider early\n"
+			"  --tracker-url <url>       tracker provider URL with {platform} and {name}\n"
+			"  --tracker-wins-pointer <p> JSON pointer to the wins in a tracker reply (/wins)\n"
+			"  --local-stats-file <path> localfile provider file\n"
+			"  --cache <path>            cache file (SmurfTrackerDaemon_cache.json)\n"
+			"  --soft-ttl <minutes>      refresh cached wins after (30)\n"
+			"  --hard-ttl <minutes>      forget cached wins after (10080)\n"
+			"  --negative-ttl <minutes>  retry failed lookups after (10)\n"
+			"\n"
+			"Usage: SmurfTrackerDaemon proxy [options]\n"
+			"  --bind <address>          listen address (127.0.0.1)\n"
+			"  --port <port>             listen port, 8191 to stand in for FlareSolverr (8191)\n"
+			"  --upstream <host:port>    the real FlareSolverr instance (127.0.0.1:8190)\n"
+			"  --fresh <seconds>         answer from the cache without asking upstream for (600)\n"
+			"  --stale <seconds>         answer from the cache when upstream fails for (86400)\n"
+			"  --max-mb <n>              compressed cache size limit (64)\n";
+	}
+
+	struct ProxyOptions {
+		std::string bindAddress = "127.0.0.1";
+		uint16_t port = 8191;
+		std::string upstream = "127.0.0.1:8190";
+		int freshSeconds = 600;
+		int staleSeconds = 86400;
+		int maxMegabytes = 64;
+	};
+
+	bool ParseProxyOptions(int argc, char** argv, ProxyOptions& options)
+	{
+		std::map<std::string, int*> integers = {
+			{ "--fresh", &options.freshSeconds }, { "--stale", &options.staleSeconds },
+			{ "--max-mb", &options.maxMegabytes },
+		};
+
+		try {
+			for (int i = 2; i + 1 < argc; i += 2) {
+				std::string name = argv[i];
+				std::string value = argv[i + 1];
+				if (auto it = integers.find(name); it != integers.end()) {
+					*it->second = std::stoi(value);
+				}
+				else if (name == "--bind") {
+					options.bindAddress = value;
+				}
+				else if (name == "--upstream") {
+					options.upstream = value;
+				}
+				else if (name == "--port") {
+					options.port = static_cast<uint16_t>(std::stoul(value));
+				}
+				else {
+					return false;
+				}
+			}
+		}
+		catch (const std::exception&) {
+			return false;
+		}
+		return argc % 2 == 0; // every option has a value
+	}
+
+	bool ParseOptions(int argc, char** argv, DaemonOptions& options)
+	{
+		std::map<std::string, std::string*> strings = {
+			{ "--bind", &options.bindAddress }, { "--providers", &options.providers },
+			{ "--flaresolverr", &options.flaresolverr }, { "--tracker-url", &options.trackerUrl },
+			{ "--tracker-wins-pointer", &options.trackerWinsPointer }, { "--local-stats-file", &options.localStatsFile },
+			{ "--cache", &options.cacheFile },
+		};
+		std::map<std::string, int*> integers = {
+			{ "--soft-ttl", &options.softTtlMinutes }, { "--hard-ttl", &options.hardTtlMinutes },
+			{ "--negative-ttl", &options.negativeTtlMinutes },
+		};
+
+		try {
+			for (int i = 1; i < argc; i++) {
+				std::string name = argv[i];
+				if (name == "--no-hedging") {
+					options.hedging = false;
+					continue;
+				}
+				if (i + 1 >= argc) {
+					return false;
+				}
+				std::string value = argv[++i];
+				if (auto it = strings.find(name); it != strings.end()) {
+					*it->second = value;
+				}
+				else if (auto it = integers.find(name); it != integers.end()) {
+					*it->second = std::stoi(value);
+				}
+				else if (name == "--port") {
+					options.port = static_cast<uint16_t>(std::stoul(value));
+				}
+				else if (name == "--sessions") {
+					options.sessions = std::stoul(value);
+				}
+				else if (name == "--per-endpoint") {
+					options.perEndpoint = std::max<size_t>(std::stoul(value), 1);
+				}
+				else if (name == "--concurrency") {
+					options.concurrency = std::max<size_t>(std::stoul(value), 1);
+				}
+				else if (name == "--spacing") {
+					options.spacingSeconds = std::stof(value);
+				}
+				else {
+					return false;
+				}
+			}
+		}
+		catch (const std::exception&) {
+			return false;
+		}
+		return true;
+	}
+
+	// Sessions that could be created by endpoint, the rest of the requests go without one
+	std::map<std::string, std::vector<std::string>> CreateSessions(DaemonHost& host, const DaemonOptions& options,
+		const std::vector<std::string>& endpoints)
+	{
+		std::map<std::string, std::vector<std::string>> sessions;
+		if (options.providers.find("flaresolverr") == std::string::npos) {
+			return sessions;
+		}
+		HttpClient client;
+		for (const std::string& endpoint : endpoints) {
+			for (size_t i = 0; i < options.sessions; i++) {
+				std::string name = "smurftracker-" + std::to_string(i);
+				std::string body;
+				int code = client.Send(FlareSolverrProvider::SessionCall(endpoint, "sessions.create", name), body, std::chrono::seconds(60));
+				if (code != 200) {
+					host.Log("Could not create FlareSolverr session " + name + " on " + endpoint + " (" + std::to_string(code) + "), continuing without it");
+					continue;
+				}
+				sessions[endpoint].push_back(name);
+			}
+		}
+		return sessions;
+	}
+
+	void DestroySessions(const std::map<std::string, std::vector<std::string>>& sessions)
+	{
+		HttpClient client;
+		for (const auto& [endpoint, names] : sessions) {
+			for (const std::string& name : names) {
+				std::string body;
+				client.Send(FlareSolverrProvider::SessionCall(endpoint, "sessions.destroy", name), body, std::chrono::seconds(10));
+			}
+		}
+	}
+
+	int RunProxy(int argc, char** argv)
+	{
+		ProxyOptions options;
+		if (!ParseProxyOptions(argc, argv, options)) {
+			PrintUsage();
+			return 2;
+		}
+
+		[[maybe_unused]] SocketLibrary sockets;
+		DaemonHost host(1); // for its log, the proxy makes its calls itself
+		ProxyCache cache(static_cast<size_t>(std::max(options.maxMegabytes, 1)) * 1024 * 1024);
+		FlareSolverrProxy proxy(options.upstream, cache);
+		proxy.freshFor = std::chrono::seconds(options.freshSeconds);
+		proxy.staleFor = std::chrono::seconds(options.staleSeconds);
+
+		HttpServer server([&proxy](const HttpServerRequest& request, HttpResponseWriter& response) {
+			proxy.Handle(request, response);
+			});
+		std::string error;
+		if (!server.Listen(options.bindAddress, options.port, error)) {
+			host.Log(error);
+			return 1;
+		}
+		host.Log("Caching FlareSolverr proxy on " + options.bindAddress + ":" + std::to_string(options.port) + " for " + options.upstream);
+
+		std::signal(SIGINT, OnSignal);
+		std::signal(SIGTERM, OnSignal);
+		while (!stopRequested) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		}
+
+		host.Log("Shutting down");
+		server.Stop();
+		host.Stop();
+		return 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && std::string(argv[1]) == "proxy") {
+		return RunProxy(argc, argv);
+	}
+
+	DaemonOptions options;
+	if (!ParseOptions(argc, argv, options)) {
+		PrintUsage();
+		return 2;
+	}
+
+	std::vector<std::string> endpoints = ParseEndpointList(options.flaresolverr, 8191);
+	if (options.concurrency == 0) {
+		options.concurrency = std::max<size_t>(endpoints.size(), 1) * options.perEndpoint;
+	}
+
+	[[maybe_unused]] SocketLibrary sockets;
+	DaemonHost host(options.concurrency + 1); // one spare for the hedge
+	WorkerPool parsePool;
+
+	StatsCache cache(std::chrono::minutes(options.softTtlMinutes), std::chrono::minutes(options.hardTtlMinutes));
+	cache.SetNegativeTtl(std::chrono::minutes(options.negativeTtlMinutes));
+	std::string error;
+	if (!cache.Load(options.cacheFile, error)) {
+		host.Log(error);
+	}
+	host.Log("Loaded " + std::to_string(cache.Size()) + " cached players from " + options.cacheFile);
+
+	std::map<std::string, std::vector<std::string>> sessions = CreateSessions(host, options, endpoints);
+	size_t sessionCount = 0;
+	for (const auto& [endpoint, names] : sessions) {
+		sessionCount += names.size();
+	}
+
+	std::map<std::string, ProviderConfig> configs;
+	configs["flaresolverr"].endpoints = endpoints;
+	configs["flaresolverr"].perEndpointLimit = options.perEndpoint;
+	configs["flaresolverr"].sessions = sessions;
+	configs["tracker"].urlTemplate = options.trackerUrl;
+	configs["tracker"].winsPointer = options.trackerWinsPointer;
+	configs["localfile"].filePath = options.localStatsFile;
+
+	ProviderRegistry registry;
+	RegisterBuiltinProviders(registry);
+	std::vector<std::shared_ptr<StatsProvider>> chain = registry.BuildChain(options.providers, host, configs);
+	std::shared_ptr<FlareSolverrProvider> flareSolverr;
+	for (const std::shared_ptr<StatsProvider>& provider : chain) {
+		if (auto candidate = std::dynamic_pointer_cast<FlareSolverrProvider>(provider)) {
+			flareSolverr = candidate;
+		}
+	}
+	host.Log("Stats providers: " + options.providers + " (" + std::to_string(chain.size()) + " active, "
+		+ std::to_string(endpoints.size()) + " FlareSolverr instances, " + std::to_string(sessionCount) + " sessions)");
+
+	LookupPipeline pipeline(host, parsePool, cache);
+	pipeline.SetChain(std::move(chain));
+	pipeline.SetHedging(options.hedging);
+	pipeline.SetPacing(options.spacingSeconds, options.concurrency);
+
+	LobbyService service(pipeline, cache);
+	HttpServer server([&service](const HttpServerRequest& request, HttpResponseWriter& response) {
+		service.Handle(request, response);
+		});
+	if (!server.Listen(options.bindAddress, options.port, error)) {
+		host.Log(error);
+		DestroySessions(sessions);
+		return 1;
+	}
+	host.Log("Listening on " + options.bindAddress + ":" + std::to_string(options.port));
+
+	std::signal(SIGINT, OnSignal);
+	std::signal(SIGTERM, OnSignal);
+
+	// Save now and then so a crash loses little, check on FlareSolverr so dead
+	// instances leave rotation before a lobby needs them
+	constexpr auto saveInterval = std::chrono::minutes(5);
+	constexpr auto probeInterval = std::chrono::seconds(30);
+	auto nextSave = std::chrono::steady_clock::now() + saveInterval;
+	auto nextProbe = std::chrono::steady_clock::now();
+	while (!stopRequested) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(200));
+		if (flareSolverr && std::chrono::steady_clock::now() >= nextProbe) {
+			flareSolverr->Probe();
+			nextProbe += probeInterval;
+		}
+		if (std::chrono::steady_clock::now() >= nextSave) {
+			if (!cache.Save(options.cacheFile, error)) {
+				host.Log(error);
+			}
+			nextSave += saveInterval;
+		}
+	}
+
+	host.Log("Shutting down");
+	service.Stop();
+	server.Stop();
+	pipeline.CancelAll();
+	host.Stop();
+	parsePool.Stop();
+	if (!cache.Save(options.cacheFile, error)) {
+		host.Log(error);
+	}
+	DestroySessions(sessions);
+	return 0;
+}
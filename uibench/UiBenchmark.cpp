@@ -0,0 +1,180 @@
+#include "UiBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+
+#include "OverlayTable.h"
+
+namespace
+{
+	uint64_t allocations = 0;
+	uint64_t allocatedBytes = 0;
+
+	void* ImGuiAlloc(size_t size, void*)
+	{
+		CountAllocation(size);
+		return std::malloc(size);
+	}
+
+	void ImGuiFree(void* pointer, void*)
+	{
+		std::free(pointer);
+	}
+
+	// Names of every length the overlay meets, from short handles to the 32 character limit
+	const char* fakeNames[] = {
+		"Jstn.", "GarrettG", "Squishy Muffinz", "Kaydop", "xX_Ch4mp_Sm0rf_Xx", "ApparentlyJack",
+		"Zen", "AyyJayy", "a very long display name here", "Vatira", "Monkey Moon", "M0nkeyM00n_smurf2",
+		"Firstkiller", "dappur", "Atow.", "rise.",
+	};
+
+	std::vector<OverlayTeamInput> FakeTeams(size_t blue, size_t orange, size_t tick)
+	{
+		std::vector<OverlayTeamInput> teams;
+		size_t player = 0;
+		auto addTeam = [&](size_t size, const char* title, ImU32 color) {
+			OverlayTeamInput& team = teams.emplace_back();
+			team.title = title;
+			team.color = color;
+			for (size_t i = 0; i < size; i++, player++) {
+				OverlayPlayer& row = team.players.emplace_back();
+				row.key = player;
+				row.name = fakeNames[player % std::size(fakeNames)];
+				// Only a few scores move per tick, like goals and saves in a match
+				row.score = static_cast<int>(player % 3 == tick % 3 ? tick * 100 % 1200 : player * 10);
+				row.mmr = std::to_string(900 + player * 97 % 900);
+				row.wins = std::to_string(150 + player * 613 % 5000);
+				row.encounters = player % 3 == 0 ? 2 : 1;
+			}
+			};
+		addTeam(blue, "Blue", IM_COL32(0, 0, 255, 255));
+		addTeam(orange, "Orange", IM_COL32(255, 165, 0, 255));
+		return teams;
+	}
+}
+
+void CountAllocation(size_t bytes)
+{
+	allocations++;
+	allocatedBytes += bytes;
+}
+
+HeadlessImGui::HeadlessImGui(ImVec2 displaySize)
+	: previous(ImGui::GetCurrentContext())
+{
+	ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+	context = ImGui::CreateContext();
+	ImGuiIO& io = ImGui::GetIO();
+	io.DisplaySize = displaySize;
+	io.DeltaTime = 1.0f / 60.0f;
+	io.IniFilename = nullptr;
+
+	// The atlas has to be built for text to be laid out, any non-null texture id stands in for the upload
+	unsigned char* pixels;
+	int width;
+	int height;
+	io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+	io.Fonts->TexID = reinterpret_cast<ImTextureID>(static_cast<intptr_t>(1));
+}
+
+HeadlessImGui::~HeadlessImGui()
+{
+	ImGui::DestroyContext(context);
+	ImGui::SetCurrentContext(previous);
+}
+
+ImDrawData* HeadlessImGui::Frame(const std::function<void()>& draw)
+{
+	ImGui::SetCurrentContext(context);
+	ImGui::NewFrame();
+	draw();
+	ImGui::Render();
+	return ImGui::GetDrawData();
+}
+
+std::string UiBenchmarkReport::ToString() const
+{
+	std::ostringstream out;
+	out.precision(2);
+	out << std::fixed
+		<< name << ": " << frames << " frames"
+		<< " | " << meanUs << "us/frame p99 " << p99Us << "us"
+		<< " | " << allocationsPerFrame << " allocs/frame " << bytesPerFrame << " B/frame"
+		<< " | " << vertices << " vtx " << indices << " idx " << drawLists << " lists " << drawCalls << " draw calls";
+	return out.str();
+}
+
+UiBenchmarkReport RunUiBenchmark(const std::string& name, size_t frames, const std::function<void(size_t frame)>& draw, size_t warmup)
+{
+	UiBenchmarkReport report;
+	report.name = name;
+	report.frames = frames;
+
+	HeadlessImGui imgui;
+	ImDrawData* drawData = nullptr;
+	for (size_t frame = 0; frame < warmup; frame++) {
+		drawData = imgui.Frame([&]() { draw(frame); });
+	}
+
+	std::vector<double> times;
+	times.reserve(frames);
+	uint64_t allocationsBefore = allocations;
+	uint64_t bytesBefore = allocatedBytes;
+	for (size_t frame = 0; frame < frames; frame++) {
+		auto start = std::chrono::steady_clock::now();
+		size_t index = warmup + frame; // two captures fit std::function's inline buffer, the harness allocates nothing per frame
+		drawData = imgui.Frame([&draw, index]() { draw(index); });
+		times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	if (frames > 0) {
+		double total = 0;
+		for (double time : times) {
+			total += time;
+		}
+		report.meanUs = total / frames;
+		std::sort(times.begin(), times.end());
+		report.p99Us = times[std::min(frames - 1, frames * 99 / 100)];
+		report.allocationsPerFrame = static_cast<double>(allocations - allocationsBefore) / frames;
+		report.bytesPerFrame = static_cast<double>(allocatedBytes - bytesBefore) / frames;
+	}
+	if (drawData != nullptr) {
+		report.vertices = drawData->TotalVtxCount;
+		report.indices = drawData->TotalIdxCount;
+		report.drawLists = drawData->CmdListsCount;
+		for (int i = 0; i < drawData->CmdListsCount; i++) {
+			report.drawCalls += drawData->CmdLists[i]->CmdBuffer.Size;
+		}
+	}
+	return report;
+}
+
+UiBenchmarkReport RunOverlayBenchmark(const OverlayBenchmarkOptions& options)
+{
+	std::vector<OverlayColumn> columns = ParseOverlayColumns(defaultOverlayColumns);
+	std::string header = "Connected Players: " + std::to_string(options.blue + options.orange);
+	OverlayTable table;
+	ImGuiOverlay overlay;
+	overlay.cacheEnabled = options.cache;
+	overlay.SetModel(table.Model());
+	size_t tick = 0;
+	table.Update(columns, header, FakeTeams(options.blue, options.orange, tick));
+
+	std::string name = "overlay " + std::to_string(options.blue) + "v" + std::to_string(options.orange)
+		+ (options.cache ? " cached" : " direct")
+		+ (options.scoreEvery ? ", scores every " + std::to_string(options.scoreEvery) + " frames" : "");
+	UiBenchmarkReport report = RunUiBenchmark(name, options.frames, [&](size_t frame) {
+		// Stands in for a new roster version reaching RenderWindow
+		if (options.scoreEvery && frame % options.scoreEvery == 0) {
+			if (table.Update(columns, header, FakeTeams(options.blue, options.orange, ++tick))) {
+				overlay.Invalidate();
+			}
+		}
+		ImGui::Begin("SmurfTracker overlay", nullptr, overlayWindowFlags);
+		overlay.DrawWindow();
+		ImGui::End();
+		});
+	return report;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "IMGUI/imgui.h"
+
+// Every allocation made while a benchmark runs, ImGui's through its allocator
+// hooks and the rest through the harness's operator new
+void CountAllocation(size_t bytes);
+
+// An ImGui context with a font atlas but no renderer: frames are built down to
+// ImDrawData and dropped, so UI code can be measured without a DX11 device.
+class HeadlessImGui
+{
+public:
+	explicit HeadlessImGui(ImVec2 displaySize = ImVec2(1920, 1080));
+	~HeadlessImGui();
+
+	HeadlessImGui(const HeadlessImGui&) = delete;
+	HeadlessImGui& operator=(const HeadlessImGui&) = delete;
+
+	// NewFrame, draw, Render
+	ImDrawData* Frame(const std::function<void()>& draw);
+
+private:
+	ImGuiContext* context;
+	ImGuiContext* previous;
+};
+
+struct UiBenchmarkReport {
+	std::string name;
+	size_t frames = 0;
+	double meanUs = 0; // CPU time per frame, NewFrame to Render
+	double p99Us = 0;
+	double allocationsPerFrame = 0;
+	double bytesPerFrame = 0;
+	// Of the last frame
+	int vertices = 0;
+	int indices = 0;
+	int drawLists = 0;
+	int drawCalls = 0;
+
+	std::string ToString() const;
+};
+
+// Runs draw for frames frames after warmup frames that are not measured
+UiBenchmarkReport RunUiBenchmark(const std::string& name, size_t frames, const std::function<void(size_t frame)>& draw, size_t warmup = 60);
+
+struct OverlayBenchmarkOptions {
+	size_t frames = 5000;
+	size_t blue = 4;
+	size_t orange = 4;
+	bool cache = true;
+	size_t scoreEvery = 0; // frames between score changes that rebuild the model, 0 never
+};
+
+// The overlay window the plugin opens with the scoreboard, fed a fake roster
+UiBenchmarkReport RunOverlayBenchmark(const OverlayBenchmarkOptions& options);
@@ -0,0 +1,68 @@
+// Headless UI benchmark: builds the plugin's ImGui overlay frame by frame with
+// no renderer and reports CPU time, allocations and draw data per frame, so UI
+// changes can be measured on Linux without the game or a DX11 device.
+//   SmurfTrackerUiBench [frames]
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "UiBenchmark.h"
+
+// Counts the harness's own allocations (model strings, ImGuiOverlay buffers) next to ImGui's
+void* operator new(size_t size)
+{
+	CountAllocation(size);
+	if (void* pointer = std::malloc(size ? size : 1)) {
+		return pointer;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+	std::free(pointer);
+}
+
+int main(int argc, char** argv)
+{
+	OverlayBenchmarkOptions base;
+	if (argc > 1) {
+		try {
+			base.frames = std::stoul(argv[1]);
+		}
+		catch (const std::exception&) {
+			std::cerr << "Usage: SmurfTrackerUiBench [frames]" << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<OverlayBenchmarkOptions> runs;
+	for (auto [blue, orange] : { std::pair<size_t, size_t>{ 1, 1 }, { 3, 3 }, { 4, 4 }, { 8, 8 } }) {
+		for (bool cache : { false, true }) {
+			OverlayBenchmarkOptions options = base;
+			options.blue = blue;
+			options.orange = orange;
+			options.cache = cache;
+			runs.push_back(options);
+		}
+	}
+	// Live scores: a new model about twice a second at 60 fps
+	for (bool cache : { false, true }) {
+		OverlayBenchmarkOptions options = base;
+		options.cache = cache;
+		options.scoreEvery = 30;
+		runs.push_back(options);
+	}
+
+	for (const OverlayBenchmarkOptions& options : runs) {
+		std::cout << RunOverlayBenchmark(options).ToString() << std::endl;
+	}
+	return 0;
+}
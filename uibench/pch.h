@@ -0,0 +1,4 @@
+#pragma once
+
+// The vendored ImGui sources start with #include "pch.h". This stands in for
+// the plugin's precompiled header so they build without the BakkesMod SDK.
@@ -1,21 +1,285 @@
 #include "url_encode.h"
-#include <sstream>
-#include <iomanip>
-#include <cctype>
-#include "pch.h"
-
-std::string urlEncode(const std::string& value) {
-    std::ostringstream escaped;
-    escaped.fill('0');
-    escaped << std::hex;
-    for (auto i = value.begin(); i != value.end(); ++i) {
-        std::string::value_type c = (*i);
-        if (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
-            escaped << c;
+
+#include <array>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#pragma comment(lib, "Normaliz.lib")
+#else
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "NfcTables.h"
+#endif
+
+namespace {
+    constexpr std::array<bool, 256> unreservedTable = [] {
+        std::array<bool, 256> table{};
+        for (int c = 'A'; c <= 'Z'; c++) table[c] = true;
+        for (int c = 'a'; c <= 'z'; c++) table[c] = true;
+        for (int c = '0'; c <= '9'; c++) table[c] = true;
+        table['-'] = table['_'] = table['.'] = table['~'] = true;
+        return table;
+    }();
+
+    constexpr char hexDigits[] = "0123456789ABCDEF";
+
+    // Length of the valid UTF-8 sequence starting at i, or 0 if it is invalid
+    size_t utf8SequenceLength(std::string_view value, size_t i) {
+        unsigned char lead = static_cast<unsigned char>(value[i]);
+        if (lead < 0x80) return 1;
+
+        size_t length;
+        unsigned char min = 0x80, max = 0xBF; // allowed range of the second byte
+        if (lead >= 0xC2 && lead <= 0xDF) { length = 2; }
+        else if (lead == 0xE0) { length = 3; min = 0xA0; }         // no overlongs
+        else if (lead >= 0xE1 && lead <= 0xEC) { length = 3; }
+        else if (lead == 0xED) { length = 3; max = 0x9F; }         // no surrogates
+        else if (lead >= 0xEE && lead <= 0xEF) { length = 3; }
+        else if (lead == 0xF0) { length = 4; min = 0x90; }         // no overlongs
+        else if (lead >= 0xF1 && lead <= 0xF3) { length = 4; }
+        else if (lead == 0xF4) { length = 4; max = 0x8F; }         // nothing above U+10FFFF
+        else return 0;
+
+        if (i + length > value.size()) return 0;
+        unsigned char second = static_cast<unsigned char>(value[i + 1]);
+        if (second < min || second > max) return 0;
+        for (size_t k = 2; k < length; k++) {
+            unsigned char next = static_cast<unsigned char>(value[i + k]);
+            if (next < 0x80 || next > 0xBF) return 0;
+        }
+        return length;
+    }
+
+    bool isAscii(std::string_view value) {
+        for (char c : value) {
+            if (static_cast<unsigned char>(c) >= 0x80) return false;
+        }
+        return true;
+    }
+
+#ifdef _WIN32
+    std::string normalizeNfc(const std::string& value) {
+        int wideLength = MultiByteToWideChar(CP_UTF8, 0, value.data(), static_cast<int>(value.size()), nullptr, 0);
+        if (wideLength <= 0) return value;
+        std::wstring wide(wideLength, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, value.data(), static_cast<int>(value.size()), wide.data(), wideLength);
+
+        // The estimate can be too small, NormalizeString then asks for a bigger buffer
+        int normalizedLength = NormalizeString(NormalizationC, wide.data(), wideLength, nullptr, 0);
+        std::wstring normalized;
+        for (int attempt = 0; attempt < 3 && normalizedLength > 0; attempt++) {
+            normalized.resize(normalizedLength);
+            normalizedLength = NormalizeString(NormalizationC, wide.data(), wideLength, normalized.data(), normalizedLength);
+            if (normalizedLength > 0) {
+                normalized.resize(normalizedLength);
+                break;
+            }
+            if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) return value;
+            normalizedLength = -normalizedLength;
+        }
+        if (normalizedLength <= 0) return value;
+
+        int utf8Length = WideCharToMultiByte(CP_UTF8, 0, normalized.data(), normalizedLength, nullptr, 0, nullptr, nullptr);
+        if (utf8Length <= 0) return value;
+        std::string result(utf8Length, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, normalized.data(), normalizedLength, result.data(), utf8Length, nullptr, nullptr);
+        return result;
+    }
+#else
+    // The daemon keys its cache and in-flight lookups by the normalized name as
+    // well, so other builds compose from the Unicode tables themselves
+    constexpr uint32_t hangulSBase = 0xAC00, hangulLBase = 0x1100, hangulVBase = 0x1161, hangulTBase = 0x11A7;
+    constexpr uint32_t hangulLCount = 19, hangulVCount = 21, hangulTCount = 28;
+    constexpr uint32_t hangulNCount = hangulVCount * hangulTCount, hangulSCount = hangulLCount * hangulNCount;
+
+    uint8_t combiningClass(uint32_t codePoint) {
+        auto it = std::upper_bound(std::begin(nfcCombiningClasses), std::end(nfcCombiningClasses), codePoint,
+            [](uint32_t cp, const NfcCombiningClass& range) { return cp < range.from; });
+        if (it == std::begin(nfcCombiningClasses)) return 0;
+        --it;
+        return codePoint <= it->to ? it->combiningClass : 0;
+    }
+
+    void decompose(uint32_t codePoint, std::vector<uint32_t>& out) {
+        if (codePoint >= hangulSBase && codePoint < hangulSBase + hangulSCount) {
+            uint32_t index = codePoint - hangulSBase;
+            out.push_back(hangulLBase + index / hangulNCount);
+            out.push_back(hangulVBase + (index % hangulNCount) / hangulTCount);
+            if (index % hangulTCount != 0) out.push_back(hangulTBase + index % hangulTCount);
+            return;
+        }
+        auto it = std::lower_bound(std::begin(nfcDecompositions), std::end(nfcDecompositions), codePoint,
+            [](const NfcDecomposition& entry, uint32_t cp) { return entry.codePoint < cp; });
+        if (it == std::end(nfcDecompositions) || it->codePoint != codePoint) {
+            out.push_back(codePoint);
+            return;
+        }
+        decompose(it->first, out); // the first half may decompose further, the second never does
+        if (it->second != 0) out.push_back(it->second);
+    }
+
+    // The primary composite of first and second, or 0
+    uint32_t compose(uint32_t first, uint32_t second) {
+        if (first >= hangulLBase && first < hangulLBase + hangulLCount
+            && second >= hangulVBase && second < hangulVBase + hangulVCount) {
+            return hangulSBase + ((first - hangulLBase) * hangulVCount + second - hangulVBase) * hangulTCount;
+        }
+        if (first >= hangulSBase && first < hangulSBase + hangulSCount && (first - hangulSBase) % hangulTCount == 0
+            && second > hangulTBase && second < hangulTBase + hangulTCount) {
+            return first + second - hangulTBase;
+        }
+        auto it = std::lower_bound(std::begin(nfcCompositions), std::end(nfcCompositions), std::make_pair(first, second),
+            [](const NfcComposition& entry, const std::pair<uint32_t, uint32_t>& pair) {
+                return entry.first != pair.first ? entry.first < pair.first : entry.second < pair.second;
+            });
+        if (it == std::end(nfcCompositions) || it->first != first || it->second != second) return 0;
+        return it->composite;
+    }
+
+    uint32_t decodeUtf8(const std::string& value, size_t& i) {
+        unsigned char lead = static_cast<unsigned char>(value[i]);
+        size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+        uint32_t codePoint = length == 1 ? lead : lead & (0x7F >> length);
+        for (size_t k = 1; k < length; k++) {
+            codePoint = (codePoint << 6) | (static_cast<unsigned char>(value[i + k]) & 0x3F);
+        }
+        i += length;
+        return codePoint;
+    }
+
+    void encodeUtf8(uint32_t codePoint, std::string& out) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
         }
         else {
-            escaped << '%' << std::setw(2) << int((unsigned char)c);
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    // Expects valid UTF-8: full canonical decomposition, canonical ordering, then composition
+    std::string normalizeNfc(const std::string& value) {
+        std::vector<uint32_t> codePoints;
+        codePoints.reserve(value.size());
+        for (size_t i = 0; i < value.size();) {
+            decompose(decodeUtf8(value, i), codePoints);
+        }
+
+        // Marks between two starters are ordered by combining class, equal classes keep their order
+        for (size_t i = 0; i < codePoints.size();) {
+            if (combiningClass(codePoints[i]) == 0) { i++; continue; }
+            size_t end = i;
+            while (end < codePoints.size() && combiningClass(codePoints[end]) != 0) end++;
+            std::stable_sort(codePoints.begin() + i, codePoints.begin() + end,
+                [](uint32_t a, uint32_t b) { return combiningClass(a) < combiningClass(b); });
+            i = end;
+        }
+
+        // A mark joins the last starter unless a mark of the same or a higher class
+        // (or a starter) stands between them
+        size_t starter = std::string::npos;
+        int lastClass = -1;
+        size_t write = 0;
+        for (size_t read = 0; read < codePoints.size(); read++) {
+            uint32_t codePoint = codePoints[read];
+            int currentClass = combiningClass(codePoint);
+            if (starter != std::string::npos && (lastClass < currentClass || (lastClass == 0 && write == starter + 1))) {
+                if (uint32_t composite = compose(codePoints[starter], codePoint)) {
+                    codePoints[starter] = composite;
+                    continue;
+                }
+            }
+            if (currentClass == 0) {
+                starter = write;
+            }
+            lastClass = currentClass;
+            codePoints[write++] = codePoint;
+        }
+        codePoints.resize(write);
+
+        std::string result;
+        result.reserve(value.size());
+        for (uint32_t codePoint : codePoints) {
+            encodeUtf8(codePoint, result);
+        }
+        return result;
+    }
+#endif
+}
+
+size_t urlEncodedLength(std::string_view value) {
+    size_t length = value.size();
+    for (char c : value) {
+        if (!unreservedTable[static_cast<unsigned char>(c)]) length += 2;
+    }
+    return length;
+}
+
+void urlEncodeAppend(std::string& out, std::string_view value) {
+    size_t start = out.size();
+    out.resize(start + urlEncodedLength(value));
+    char* write = out.data() + start;
+    for (char c : value) {
+        unsigned char byte = static_cast<unsigned char>(c);
+        if (unreservedTable[byte]) {
+            *write++ = c;
+        }
+        else {
+            *write++ = '%';
+            *write++ = hexDigits[byte >> 4];
+            *write++ = hexDigits[byte & 0x0F];
+        }
+    }
+}
+
+std::string urlEncode(std::string_view value) {
+    std::string escaped;
+    urlEncodeAppend(escaped, value);
+    return escaped;
+}
+
+bool isValidUtf8(std::string_view value) {
+    for (size_t i = 0; i < value.size();) {
+        size_t length = utf8SequenceLength(value, i);
+        if (length == 0) return false;
+        i += length;
+    }
+    return true;
+}
+
+std::string normalizeUtf8(std::string_view value) {
+    if (isAscii(value)) {
+        return std::string(value); // already NFC
+    }
+
+    std::string valid;
+    valid.reserve(value.size());
+    for (size_t i = 0; i < value.size();) {
+        size_t length = utf8SequenceLength(value, i);
+        if (length == 0) {
+            valid += "\xEF\xBF\xBD"; // U+FFFD
+            i++;
+            continue;
         }
+        valid.append(value.data() + i, length);
+        i += length;
     }
-    return escaped.str();
+    return normalizeNfc(valid);
 }
@@ -3,7 +3,18 @@
 #define URL_ENCODE_H
 
 #include <string>
+#include <string_view>
 
-std::string urlEncode(const std::string& value);
+// Percent-encodes everything but RFC 3986 unreserved characters, byte-wise,
+// so multi-byte UTF-8 names come out as %XX sequences
+std::string urlEncode(std::string_view value);
+void urlEncodeAppend(std::string& out, std::string_view value);
+size_t urlEncodedLength(std::string_view value);
+
+bool isValidUtf8(std::string_view value);
+
+// Replaces invalid UTF-8 with U+FFFD and applies Unicode NFC, so a name typed
+// with combining marks and its precomposed form map to the same string
+std::string normalizeUtf8(std::string_view value);
 
 #endif // URL_ENCODE_H